@@ -0,0 +1,39 @@
+/*
+ * Writes a coefficient atlas: the coding coefficients of all the repair
+ * keys, for a maximum coding window size and a density, in a file that
+ * encoders and decoders can map in memory (see swif_coefs_atlas_open() and
+ * swif_ENCODER_SET_PARAM_COEFS_ATLAS / swif_DECODER_SET_PARAM_COEFS_ATLAS).
+ *
+ * Usage: coefs_atlas_gen <file> <max_coding_window_size> <dt>
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+
+#include "../../src/swif_api.h"
+
+int main(int argc, char *argv[])
+{
+    unsigned long max_coding_window_size;
+    unsigned long dt;
+
+    if (argc != 4) {
+        fprintf(stderr, "usage: %s <file> <max_coding_window_size> <dt>\n", argv[0]);
+        return -1;
+    }
+    max_coding_window_size = strtoul(argv[2], NULL, 10);
+    dt = strtoul(argv[3], NULL, 10);
+    if (max_coding_window_size == 0 || max_coding_window_size > UINT16_MAX || dt > 15) {
+        fprintf(stderr, "%s: max_coding_window_size must be in [1, %u] and dt in [0, 15]\n",
+                argv[0], UINT16_MAX);
+        return -1;
+    }
+    if (swif_coefs_atlas_write(argv[1], (uint32_t)max_coding_window_size, (uint8_t)dt)
+        != SWIF_STATUS_OK) {
+        return -1;
+    }
+    printf("%s: %lu coefficients for each of the 65536 repair keys, dt=%lu\n",
+           argv[1], max_coding_window_size, dt);
+    return 0;
+}
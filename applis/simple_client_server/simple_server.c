@@ -315,6 +315,9 @@ int main(int argc, char *argv[])
 
             repair_fpi->esi = htonl(first);
             memcpy(pkt_with_fpi + sizeof(repair_fpi_t), enc_symbols_tab[idx], SYMBOL_SIZE);
+            /* the repair symbol buffer is no longer needed, the encoder reuses it */
+            swif_encoder_release_repair_buffer(ses, enc_symbols_tab[idx]);
+            enc_symbols_tab[idx] = NULL;
             if(should_be_lost(loss_rate))
             {
                 printf(" => repair symbol %u is lost\n", esi);
@@ -25,6 +25,7 @@ swif_encoder_t* swif_encoder_create (
     /* initialize the encoder */
     switch (codepoint) {
         case SWIF_CODEPOINT_RLC_GF_256_FULL_DENSITY_CODEC:
+        case SWIF_CODEPOINT_RLC_GF_256_VANDERMONDE_CODEC:
             return (swif_rlc_encoder_create(codepoint, verbosity, symbol_size, max_coding_window_size));
         default:
             fprintf(stderr, "Error, swif_encoder_create: codepoint not recognized\n");
@@ -41,6 +42,7 @@ swif_status_t   swif_encoder_release (swif_encoder_t*        enc)
     /* initialize the encoder */
     switch (enc->codepoint) {
         case SWIF_CODEPOINT_RLC_GF_256_FULL_DENSITY_CODEC:
+        case SWIF_CODEPOINT_RLC_GF_256_VANDERMONDE_CODEC:
             return (swif_rlc_encoder_release(enc));
         default:
             fprintf(stderr, "Error, swif_encoder_release: codepoint not recognized\n");
@@ -102,6 +104,33 @@ swif_status_t   swif_build_repair_symbol (
 }
 
 
+swif_status_t   swif_encoder_release_repair_buffer (
+                                swif_encoder_t* enc,
+                                void*           buf)
+{
+    return (*enc->release_repair_buffer)(enc, buf);
+}
+
+swif_status_t   swif_build_repair_symbols (
+                                swif_encoder_t* enc,
+                                uint32_t*       keys,
+                                uint8_t         dt,
+                                uint32_t        nb_repair,
+                                void**          new_bufs)
+{
+    return (*enc->build_repair_symbols)(enc, keys, dt, nb_repair, new_bufs);
+}
+
+swif_status_t   swif_encoder_precommit_repair_key (
+                                swif_encoder_t* enc,
+                                uint32_t        key,
+                                uint8_t         dt,
+                                esi_t           last_esi)
+{
+    return (*enc->precommit_repair_key)(enc, key, dt, last_esi);
+}
+
+
 /*******************************************************************************
  * Decoder functions
  */
@@ -120,6 +149,7 @@ swif_decoder_t* swif_decoder_create (
     /* initialize the decoder */
     switch (codepoint) {
         case SWIF_CODEPOINT_RLC_GF_256_FULL_DENSITY_CODEC:
+        case SWIF_CODEPOINT_RLC_GF_256_VANDERMONDE_CODEC:
             return (swif_rlc_decoder_create(codepoint, verbosity, symbol_size, max_coding_window_size, max_linear_system_size));
         default:
             fprintf(stderr, "Error, swif_decoder_create: codepoint not recognized\n");
@@ -135,6 +165,7 @@ swif_status_t   swif_decoder_release (swif_decoder_t*        dec)
 {
     switch (dec->codepoint) {
         case SWIF_CODEPOINT_RLC_GF_256_FULL_DENSITY_CODEC:
+        case SWIF_CODEPOINT_RLC_GF_256_VANDERMONDE_CODEC:
             return (swif_rlc_decoder_release(dec));
         default:
             fprintf(stderr, "Error, swif_decoder_release: codepoint not recognized\n");
@@ -225,6 +256,70 @@ swif_status_t   swif_decoder_decode_with_new_repair_symbol (
 }
 
 
+/**
+ * Same as swif_decoder_decode_with_new_source_symbol(), for a source
+ * symbol of its own length.
+ */
+swif_status_t   swif_decoder_decode_with_new_variable_length_source_symbol (
+                                swif_decoder_t* dec,
+                                void* const     new_symbol_buf,
+                                uint32_t        new_symbol_length,
+                                esi_t           new_symbol_esi)
+{
+    return (*dec->decode_with_new_variable_length_source_symbol)(dec, new_symbol_buf,
+                                                                 new_symbol_length, new_symbol_esi);
+}
+
+
+/**
+ * Same as swif_decoder_decode_with_new_repair_symbol(), for a repair
+ * symbol of less than symbol_size bytes.
+ */
+swif_status_t   swif_decoder_decode_with_new_variable_length_repair_symbol (
+                                swif_decoder_t* dec,
+                                void* const     new_symbol_buf,
+                                uint32_t        new_symbol_size,
+                                esi_t           new_src_symbol_esi)
+{
+    return (*dec->decode_with_new_variable_length_repair_symbol)(dec, new_symbol_buf,
+                                                                 new_symbol_size, new_src_symbol_esi);
+}
+
+
+/**
+ * Go on with the decoding work queued because of the elimination budget.
+ */
+swif_status_t   swif_decoder_make_progress (
+                                swif_decoder_t* dec,
+                                uint32_t        budget)
+{
+    return (*dec->make_progress)(dec, budget);
+}
+
+
+/**
+ * Save the state of the decoder in a compact binary buffer.
+ */
+swif_status_t   swif_decoder_snapshot (
+                                swif_decoder_t* dec,
+                                void*           snapshot_buf,
+                                uint32_t*       snapshot_size)
+{
+    return (*dec->snapshot)(dec, snapshot_buf, snapshot_size);
+}
+
+
+/**
+ * Restore a state saved by swif_decoder_snapshot().
+ */
+swif_status_t   swif_decoder_restore (
+                                swif_decoder_t* dec,
+                                const void*     snapshot_buf,
+                                uint32_t        snapshot_size)
+{
+    return (*dec->restore)(dec, snapshot_buf, snapshot_size);
+}
+
 /*******************************************************************************
  * Coding Window Functions at an Encoder and Decoder
  */
@@ -270,6 +365,19 @@ swif_status_t   swif_decoder_add_source_symbol_to_coding_window (
     return (*dec->add_source_symbol_to_coding_window)(dec, new_src_symbol_esi);
 }
 
+/**
+ * Add this source symbol, of its own length, to the coding window.
+ */
+swif_status_t   swif_encoder_add_variable_length_source_symbol_to_coding_window (
+                                swif_encoder_t* enc,
+                                void*           new_src_symbol_buf,
+                                uint32_t        new_src_symbol_length,
+                                esi_t           new_src_symbol_esi)
+{
+    return (*enc->add_variable_length_source_symbol_to_coding_window)(
+        enc, new_src_symbol_buf, new_src_symbol_length, new_src_symbol_esi);
+}
+
 
 /**
  * Remove this source symbol from the coding window.
@@ -72,11 +72,27 @@ typedef enum {
 
         /* codepoint for RLC sliding window code, GF(2^8) and full
          * density (simplified version of FECFRAME FEC Enc. ID XXX). */
-        SWIF_CODEPOINT_RLC_GF_256_FULL_DENSITY_CODEC
+        SWIF_CODEPOINT_RLC_GF_256_FULL_DENSITY_CODEC,
+
+        /* codepoint for RLC sliding window code, GF(2^8), whose coding
+         * coefficients are alpha^(x * esi), with x = 1 + repair_key % 254,
+         * rather than those of the PRNG (dt is ignored). A repair symbol
+         * can then be kept up to date as the coding window slides, at a
+         * cost that does not depend on the coding window size (see
+         * swif_ENCODER_SET_PARAM_STANDING_REPAIR_KEYS). Since alpha is of
+         * order 255, ESIs e and e + 255 have the same coefficients: the
+         * coding window is at most SWIF_VANDERMONDE_MAX_CODING_WINDOW_SIZE
+         * source symbols. Keys k and k + 254 give the same repair symbol
+         * (no key gives the all ones one of x = 0). Not interoperable
+         * with the RLC FEC Scheme. */
+        SWIF_CODEPOINT_RLC_GF_256_VANDERMONDE_CODEC
 
         /* list here other identifiers for any codec of interest... */
 } swif_codepoint_t;
 
+/* the largest max_coding_window_size of SWIF_CODEPOINT_RLC_GF_256_VANDERMONDE_CODEC */
+#define SWIF_VANDERMONDE_MAX_CODING_WINDOW_SIZE 255
+
 
 /**
  * Encoding Symbol Identifier (ESI) generic type.
@@ -137,6 +153,14 @@ typedef struct swif_encoder {
 		struct swif_encoder*, uint32_t, uint8_t, uint32_t);
 	swif_status_t   (*get_coding_coefs_tab) (
 		struct swif_encoder*, void**, uint32_t*);
+	swif_status_t   (*precommit_repair_key) (
+		struct swif_encoder*, uint32_t, uint8_t, esi_t);
+	swif_status_t   (*build_repair_symbols) (
+		struct swif_encoder*, uint32_t*, uint8_t, uint32_t, void**);
+	swif_status_t   (*release_repair_buffer) (
+		struct swif_encoder*, void*);
+	swif_status_t   (*add_variable_length_source_symbol_to_coding_window) (
+		struct swif_encoder*, void*, uint32_t, esi_t);
 } swif_encoder_t;
 
 
@@ -239,10 +263,148 @@ swif_status_t   swif_encoder_get_parameters  (
  * List here the FEC codec specific control parameters.
  */
 enum {
+        /*
+         * Value is a swif_encoder_stats_t, set to the statistics of the
+         * encoder since its creation.
+         */
         swif_ENCODER_GET_PARAM_ENCODER_STATISTICS = 1,
-        swif_ENCODER_SET_PARAM_RLC_DENSITY_THRESHOLD
+        swif_ENCODER_SET_PARAM_RLC_DENSITY_THRESHOLD,
+        /*
+         * Value is a uint32_t, the number of threads building a repair
+         * symbol (1 by default, the calling one): each thread computes
+         * the linear combination on its own stripe of bytes. The threads
+         * are started once and reused. This only helps with large
+         * symbols, the repair symbols are the same. Requires the codec
+         * to be built with WITH_THREADS (SWIF_STATUS_ERROR otherwise).
+         */
+        swif_ENCODER_SET_PARAM_NB_THREADS,
+        /*
+         * Value is a uint32_t, set to the number of repair symbol buffers
+         * allocated by the encoder, held by the application or ready to
+         * be reused (see swif_encoder_release_repair_buffer()).
+         */
+        swif_ENCODER_GET_PARAM_REPAIR_BUFFER_POOL_SIZE,
+        /*
+         * Value is a uint32_t, set to the highest number of repair symbol
+         * buffers held by the application at the same time.
+         */
+        swif_ENCODER_GET_PARAM_REPAIR_BUFFER_HIGH_WATER_MARK,
+        /*
+         * Value is a uint32_t, non zero to enable (default is 0).
+         * When enabled, the source symbols added to the coding window
+         * are copied into a ring owned by the encoder (one contiguous
+         * block of max_coding_window_size slots, each aligned on
+         * SYMBOL_ALIGN bytes), so that the application may reuse its
+         * buffer as soon as swif_encoder_add_source_symbol_to_coding_window()
+         * returns. It must be set while the coding window is empty.
+         */
+        swif_ENCODER_SET_PARAM_COPY_SOURCE_SYMBOLS,
+        /*
+         * Value is a swif_coefs_cache_t*, the coding coefficients cache
+         * used to generate the coefficients from repair keys (NULL by
+         * default, for none). It must outlive the encoder, or be unset.
+         */
+        swif_ENCODER_SET_PARAM_COEFS_CACHE,
+        /*
+         * Value is a swif_coefs_atlas_t*, the coefficient atlas read
+         * instead of generating the coefficients of repair keys (NULL by
+         * default, for none). It must outlive the encoder, or be unset.
+         */
+        swif_ENCODER_SET_PARAM_COEFS_ATLAS,
+        /*
+         * Value is an array of uint32_t repair keys (length is their
+         * number times sizeof(uint32_t), 0 for none), replacing the
+         * previous ones. The repair symbol of each of these keys is kept
+         * up to date as source symbols enter and leave the coding window,
+         * so that building it is a copy. Only with
+         * SWIF_CODEPOINT_RLC_GF_256_VANDERMONDE_CODEC.
+         */
+        swif_ENCODER_SET_PARAM_STANDING_REPAIR_KEYS,
+        /*
+         * Value is a uint32_t, the number of repair symbols built ahead
+         * of time (0 by default, for none). Each time the coding window
+         * changes, a helper thread starts building the repair symbols of
+         * the keys expected next (those following the last key used,
+         * with its density), and swif_build_repair_symbol() hands over
+         * the one asked for, waiting for it if it is still being built.
+         * Those of a coding window that changes again are lost, and a
+         * change waits for the helper thread to stop (at most a few KB of
+         * a repair symbol). Requires the codec to be built with
+         * WITH_THREADS (SWIF_STATUS_ERROR otherwise).
+         */
+        swif_ENCODER_SET_PARAM_SPECULATIVE_REPAIRS,
+        /*
+         * Value is a swif_encoder_speculation_stats_t, set to the
+         * statistics of the repair symbols built ahead of time.
+         */
+        swif_ENCODER_GET_PARAM_SPECULATION_STATISTICS,
+        /*
+         * Value is a uint32_t, non zero to enable (default is 0). When
+         * enabled, source symbols have their own length (up to
+         * symbol_size - SWIF_LENGTH_FIELD_SIZE bytes), see
+         * swif_encoder_add_variable_length_source_symbol_to_coding_window(),
+         * and repair symbols are only computed on the bytes needed by
+         * the longest source symbol of their coding window (see
+         * swif_ENCODER_GET_PARAM_REPAIR_SYMBOL_SIZE). It must be set
+         * while the coding window is empty.
+         */
+        swif_ENCODER_SET_PARAM_VARIABLE_LENGTH_SOURCE_SYMBOLS,
+        /*
+         * Value is a uint32_t, set to the size of the last repair symbol
+         * built: its following bytes are zeros within the code (they are
+         * not set in the buffer), so that only this size needs to be
+         * sent. It is symbol_size unless the source symbols have variable
+         * lengths.
+         */
+        swif_ENCODER_GET_PARAM_REPAIR_SYMBOL_SIZE
 };
 
+/**
+ * Statistics of swif_ENCODER_SET_PARAM_SPECULATIVE_REPAIRS. The prediction
+ * hit rate is nb_hits / (nb_hits + nb_misses), and the wasted work is
+ * nb_wasted repair symbols (nb_aborted of them only partly built).
+ */
+typedef struct swif_encoder_speculation_stats {
+        uint64_t        nb_speculations; /* repair symbols built ahead of time */
+        uint64_t        nb_hits;        /* repair symbols asked for, found among them */
+        uint64_t        nb_misses;      /* repair symbols asked for, built then */
+        uint64_t        nb_wasted;      /* lost (coding window changed first) */
+        uint64_t        nb_aborted;     /* of them, stopped before the end */
+} swif_encoder_speculation_stats_t;
+
+/**
+ * Statistics of an encoder (see swif_ENCODER_GET_PARAM_ENCODER_STATISTICS).
+ * The bytes and cycles include the work of the speculation helper thread
+ * (see swif_ENCODER_SET_PARAM_SPECULATIVE_REPAIRS), once its repair symbols
+ * are handed over or dropped; those dropped before the end only count
+ * their cycles. The cycles are those of the CPU time stamp counter (always
+ * 0 where there is none).
+ */
+typedef struct swif_encoder_stats {
+        uint64_t        nb_source_symbols;   /* added to the coding window */
+        uint64_t        nb_repair_symbols;   /* built */
+        uint64_t        nb_bytes_xored;      /* of source symbols, added with a coefficient of 1 */
+        uint64_t        nb_bytes_multiplied; /* added with another (non null) coefficient */
+        uint64_t        coefs_cycles;        /* generating coding coefficients */
+        uint64_t        build_cycles;        /* in swif_build_repair_symbol(s), and building ahead of time */
+        uint32_t        nb_repair_buffers;   /* see swif_ENCODER_GET_PARAM_REPAIR_BUFFER_POOL_SIZE */
+        uint32_t        max_nb_repair_buffers_in_use; /* see ..._REPAIR_BUFFER_HIGH_WATER_MARK */
+} swif_encoder_stats_t;
+
+/**
+ * Variable length source symbols (see
+ * swif_ENCODER_SET_PARAM_VARIABLE_LENGTH_SOURCE_SYMBOLS and
+ * swif_DECODER_SET_PARAM_VARIABLE_LENGTH_SOURCE_SYMBOLS): within the code,
+ * a source symbol of `length' bytes is this length (SWIF_LENGTH_FIELD_SIZE
+ * bytes, in network byte order), then its bytes, then zeros up to
+ * symbol_size. Its length is thus protected as well, and the decoded
+ * source symbols are given to the application in this form.
+ */
+#define SWIF_LENGTH_FIELD_SIZE  2
+
+#define SWIF_GET_SOURCE_SYMBOL_LENGTH(symbol) \
+        (((uint32_t)((const uint8_t*)(symbol))[0] << 8) | ((const uint8_t*)(symbol))[1])
+
 
 /**
  * Create a single repair symbol (i.e. perform an encoding).
@@ -252,7 +414,9 @@ enum {
  *			either point to a buffer allocated by the
  *			application, or be set to NULL meaning that
  *			this function will allocate memory and initialize
- *			this pointer accordingly.
+ *			this pointer accordingly (a buffer of the repair
+ *			buffer pool, to be given back with
+ *			swif_encoder_release_repair_buffer()).
  * @return
  */
 swif_status_t   swif_build_repair_symbol (
@@ -260,6 +424,79 @@ swif_status_t   swif_build_repair_symbol (
                                 void**          new_buf);
 
 
+/**
+ * Give back a repair symbol buffer allocated by the encoder (i.e., when
+ * new_buf was NULL in swif_build_repair_symbol() or
+ * swif_build_repair_symbols()) once the application no longer needs it.
+ * It is reused for the next repair symbols, instead of being freed.
+ * The buffers are aligned on SYMBOL_ALIGN bytes. They may still be
+ * released with free(), but they then stay counted as in use by the pool
+ * (see swif_ENCODER_GET_PARAM_REPAIR_BUFFER_POOL_SIZE). Those held by the
+ * encoder are freed with it.
+ *
+ * @param enc   context (i.e., pointer to encoder structure).
+ * @param buf   (IN) the repair symbol buffer, or NULL.
+ * @return      Completion status (SWIF_STATUS_OK or SWIF_STATUS_ERROR).
+ */
+swif_status_t   swif_encoder_release_repair_buffer (
+                                swif_encoder_t* enc,
+                                void*           buf);
+
+/**
+ * Create several repair symbols over the current coding window at once.
+ * This is the same as calling swif_encoder_generate_coding_coefs() then
+ * swif_build_repair_symbol() for each key, but the source symbols of the
+ * coding window are read only once for all of them. Afterwards the coding
+ * coefficients are those of the last key.
+ *
+ * @param enc   context (i.e., pointer to encoder structure).
+ * @param keys  (IN) table of the nb_repair repair keys.
+ * @param dt    (IN) density of the coding coefficients.
+ * @param nb_repair
+ *              (IN) number of repair symbols to build.
+ * @param new_bufs
+ *              (IN/OUT) table of nb_repair buffers, as new_buf for
+ *              swif_build_repair_symbol(): each NULL entry is set to a
+ *              buffer of the repair buffer pool of the encoder, to be
+ *              given back with swif_encoder_release_repair_buffer().
+ * @return      Completion status (SWIF_STATUS_OK or SWIF_STATUS_ERROR).
+ */
+swif_status_t   swif_build_repair_symbols (
+                                swif_encoder_t* enc,
+                                uint32_t*       keys,
+                                uint8_t         dt,
+                                uint32_t        nb_repair,
+                                void**          new_bufs);
+
+/**
+ * Announce a repair symbol that will be built later, once the source
+ * symbol last_esi is the last one of the coding window, with the coding
+ * coefficients generated from key and dt (as done by
+ * swif_encoder_generate_coding_coefs()). The repair symbol is then
+ * computed step by step, as its source symbols are added to the coding
+ * window, and swif_build_repair_symbol() only has to hand it over when
+ * the coefficients generated with that key are used (with a NULL new_buf,
+ * the buffer is returned as it is, without any copy).
+ * The repair symbol is built as usual if the coding window does not
+ * end up being the expected one, and it is dropped if it is not built
+ * before the next source symbols are added.
+ *
+ * @param enc   context (i.e., pointer to encoder structure).
+ * @param key   (IN) repair key of the future repair symbol.
+ * @param dt    (IN) density of its coding coefficients.
+ * @param last_esi
+ *              (IN) last source symbol of its coding window: the
+ *              repair symbol is built right after it is added.
+ * @return      SWIF_STATUS_OK, or SWIF_STATUS_ERROR if the coding window
+ *              already goes past last_esi (or no memory).
+ */
+swif_status_t   swif_encoder_precommit_repair_key (
+                                swif_encoder_t* enc,
+                                uint32_t        key,
+                                uint8_t         dt,
+                                esi_t           last_esi);
+
+
 /*******************************************************************************
  * Decoder functions
  */
@@ -303,6 +540,13 @@ typedef struct swif_decoder {
 		struct swif_decoder*, void*, uint32_t);
 	swif_status_t   (*generate_coding_coefs) (
 		struct swif_decoder*, uint32_t, uint8_t, uint32_t);
+	swif_status_t   (*make_progress) (struct swif_decoder*, uint32_t);
+	swif_status_t   (*snapshot) (struct swif_decoder*, void*, uint32_t*);
+	swif_status_t   (*restore) (struct swif_decoder*, const void*, uint32_t);
+	swif_status_t   (*decode_with_new_variable_length_source_symbol) (
+		struct swif_decoder*, void* const, uint32_t, esi_t);
+	swif_status_t   (*decode_with_new_variable_length_repair_symbol) (
+		struct swif_decoder*, void* const, uint32_t, esi_t);
 } swif_decoder_t;
 
 
@@ -318,6 +562,12 @@ typedef struct swif_decoder {
  *                      change during the codec instance lifetime.
  * @param max_coding_window_size
  * @param max_linear_system_size
+ *                      maximum number of consecutive source symbols kept
+ *                      in the linear system. When a new symbol makes it
+ *                      grow above, the oldest source symbols are removed
+ *                      (and source_symbol_removed_from_linear_system_callback
+ *                      called for each of them). Must be at least
+ *                      max_coding_window_size, or 0 for no limit.
  * @return              pointer to a swif_decoder_t structure if okay, or
  *                      NULL in case of error.
  **/
@@ -364,6 +614,12 @@ swif_status_t   swif_decoder_release (swif_decoder_t*        dec);
  *              the codec, it is the responsibility of the application to
  *              free this buffer when needed, once decoding is over (but
  *              not before since the codec does not keep any internal copy).
+ *              The codec keeps reading this buffer (and never modifies it
+ *              once decoded) until the symbol is removed from the linear
+ *              system, so it must stay valid until then.
+ *              If NULL, the decoded source symbols are kept in buffers of
+ *              the codec, that the application must neither free nor keep
+ *              after the symbol is removed from the linear system.
  * @param decoded_source_symbol_callback
  *              (IN) Pointer to the function, within the application, that
  *              needs to be called each time a source symbol is decodable and
@@ -443,7 +699,77 @@ swif_status_t   swif_decoder_get_parameters  (
  */
 enum {
         swif_DECODER_GET_PARAM_DECODER_STATISTICS = 1,
-        swif_DECODER_SET_PARAM_RLC_DENSITY_THRESHOLD
+        swif_DECODER_SET_PARAM_RLC_DENSITY_THRESHOLD,
+        /*
+         * Value is a uint32_t, non zero to enable (default is 0).
+         * When enabled, the buffers of the source symbols submitted
+         * through swif_decoder_decode_with_new_source_symbol() are
+         * referenced by the decoder instead of being copied. They are
+         * never modified, and must stay valid until the
+         * source_symbol_removed_from_linear_system_callback is called
+         * for this ESI, or until the decoder is released. A source
+         * symbol ignored by the decoder (e.g. already removed) is not
+         * referenced.
+         */
+        swif_DECODER_SET_PARAM_ZERO_COPY_SOURCE_SYMBOLS,
+        /*
+         * Value is a uint32_t, the maximum number of symbol operations
+         * (row updates of the back-substitution) performed by each
+         * swif_decoder_decode_with_new_*_symbol() call, 0 meaning no
+         * limit (default). The remaining work is queued, see
+         * swif_decoder_make_progress().
+         */
+        swif_DECODER_SET_PARAM_ELIMINATION_BUDGET,
+        /*
+         * Value is a uint32_t, set to the number of new pivots whose
+         * back-substitution is still pending (0 when the decoder is
+         * up to date).
+         */
+        swif_DECODER_GET_PARAM_PENDING_WORK,
+        /*
+         * Value is a uint32_t, non zero to use a linear system of fixed
+         * capacity, preallocated for max_linear_system_size source
+         * symbols (that must not be 0): no memory is allocated during
+         * decoding (except the buffers of decoded source symbols for the
+         * application, see decodable_source_symbol_callback). It must be
+         * set before the first symbol is submitted. It is the default
+         * when the codec is built with WITH_FIXED_CAPACITY_DECODER.
+         */
+        swif_DECODER_SET_PARAM_FIXED_CAPACITY,
+        /*
+         * Value is a uint32_t, the number of threads used for decoding
+         * (1 by default, the calling one). The elimination is computed
+         * once on the coding coefficients, and the resulting operations
+         * on the symbols are done by all the threads, each on its own
+         * stripe of bytes: this only helps with large symbols, and the
+         * results are the same. Requires the codec to be built with
+         * WITH_THREADS (SWIF_STATUS_ERROR otherwise).
+         */
+        swif_DECODER_SET_PARAM_NB_THREADS,
+        /*
+         * Value is a swif_coefs_cache_t*, the coding coefficients cache
+         * used to generate the coefficients from repair keys (NULL by
+         * default, for none). It must outlive the decoder, or be unset.
+         */
+        swif_DECODER_SET_PARAM_COEFS_CACHE,
+        /*
+         * Value is a swif_coefs_atlas_t*, the coefficient atlas read
+         * instead of generating the coefficients of repair keys (NULL by
+         * default, for none). It must outlive the decoder, or be unset.
+         */
+        swif_DECODER_SET_PARAM_COEFS_ATLAS,
+        /*
+         * Value is a uint32_t, non zero to enable (default is 0), as
+         * swif_ENCODER_SET_PARAM_VARIABLE_LENGTH_SOURCE_SYMBOLS at the
+         * encoder: source symbols are submitted with
+         * swif_decoder_decode_with_new_variable_length_source_symbol()
+         * (they are always copied), and repair symbols of less than
+         * symbol_size bytes with
+         * swif_decoder_decode_with_new_variable_length_repair_symbol().
+         * Each row of the linear system only takes the bytes its symbols
+         * need. It must be set before the first symbol is submitted.
+         */
+        swif_DECODER_SET_PARAM_VARIABLE_LENGTH_SOURCE_SYMBOLS
 };
 
 
@@ -502,6 +828,98 @@ swif_status_t   swif_decoder_decode_with_new_repair_symbol (
                                 esi_t           new_src_symbol_esi);
 
 
+/**
+ * Same as swif_decoder_decode_with_new_source_symbol() for a source
+ * symbol of its own length, with variable length source symbols (see
+ * swif_DECODER_SET_PARAM_VARIABLE_LENGTH_SOURCE_SYMBOLS).
+ *
+ * @param new_symbol_length
+ *              (IN) length of the source symbol, at most
+ *              symbol_size - SWIF_LENGTH_FIELD_SIZE.
+ * @return
+ */
+swif_status_t   swif_decoder_decode_with_new_variable_length_source_symbol (
+                                swif_decoder_t* dec,
+                                void* const     new_symbol_buf,
+                                uint32_t        new_symbol_length,
+                                esi_t           new_symbol_esi);
+
+
+/**
+ * Same as swif_decoder_decode_with_new_repair_symbol() for a repair
+ * symbol of new_symbol_size bytes (at most symbol_size), the following
+ * ones being zeros, see swif_ENCODER_GET_PARAM_REPAIR_SYMBOL_SIZE.
+ *
+ * @return
+ */
+swif_status_t   swif_decoder_decode_with_new_variable_length_repair_symbol (
+                                swif_decoder_t* dec,
+                                void* const     new_symbol_buf,
+                                uint32_t        new_symbol_size,
+                                esi_t           new_src_symbol_esi);
+
+
+/**
+ * Go on with the decoding work queued because of the elimination budget
+ * (see swif_DECODER_SET_PARAM_ELIMINATION_BUDGET), e.g. from the idle loop
+ * of the application. For each decoded source symbol (if any), the
+ * application is informed through the dedicated callback functions.
+ *
+ * @param dec   context (i.e., pointer to decoder structure).
+ * @param budget
+ *              (IN) maximum number of symbol operations to perform, or 0
+ *              to do all the pending work.
+ * @return      SWIF_STATUS_OK, even if some work is still pending (see
+ *              swif_DECODER_GET_PARAM_PENDING_WORK), or SWIF_STATUS_ERROR.
+ */
+swif_status_t   swif_decoder_make_progress (
+                                swif_decoder_t* dec,
+                                uint32_t        budget);
+
+
+/**
+ * Save the state of the decoder, i.e. its linear system (partly decoded
+ * rows, with their coefficients and data) and which source symbols were
+ * removed, in a compact and portable binary buffer. Another decoder can
+ * then take over with swif_decoder_restore(), e.g. in a standby process.
+ *
+ * @param dec   context (i.e., pointer to decoder structure).
+ * @param snapshot_buf
+ *              (IN/OUT) buffer where the snapshot is written, or NULL to
+ *              only get the size needed.
+ * @param snapshot_size
+ *              (IN/OUT) size of snapshot_buf, set to the size of the
+ *              snapshot written (or needed).
+ * @return      SWIF_STATUS_OK, or SWIF_STATUS_ERROR if snapshot_buf is
+ *              too small.
+ */
+swif_status_t   swif_decoder_snapshot (
+                                swif_decoder_t* dec,
+                                void*           snapshot_buf,
+                                uint32_t*       snapshot_size);
+
+/**
+ * Restore a state saved by swif_decoder_snapshot(), without redoing any
+ * elimination. The decoder must have just been created with the same
+ * parameters (codepoint, symbol size, coding window and linear system
+ * sizes), and no symbol submitted yet. Its callbacks and parameters are
+ * kept. The decoded source symbols already notified are not notified
+ * again, their value being now kept in buffers of the codec.
+ *
+ * @param dec   context (i.e., pointer to decoder structure).
+ * @param snapshot_buf
+ *              (IN) the snapshot, that the application can free afterwards.
+ * @param snapshot_size
+ *              (IN) size of the snapshot.
+ * @return      SWIF_STATUS_OK, or SWIF_STATUS_ERROR if the snapshot is
+ *              invalid or does not match this decoder.
+ */
+swif_status_t   swif_decoder_restore (
+                                swif_decoder_t* dec,
+                                const void*     snapshot_buf,
+                                uint32_t        snapshot_size);
+
+
 /*******************************************************************************
  * Coding Window Functions at an Encoder and Decoder
  */
@@ -511,7 +929,11 @@ swif_status_t   swif_decoder_decode_with_new_repair_symbol (
  * This function resets the current coding window. We assume here that
  * this window is maintained by the FEC codec instance.
  * Encoder:     reset the encoding window for the encoding of future
- *              repair symbols.
+ *              repair symbols. All its source symbols are removed
+ *              (oldest first, the
+ *              source_symbol_removed_from_coding_window_callback being
+ *              called for each of them), precommitted repair symbols are
+ *              dropped, and the next source symbol may have any ESI.
  * Decoder:     reset the coding window under preparation associated to
  *              a repair symbol just received.
  *
@@ -544,6 +966,23 @@ swif_status_t   swif_decoder_add_source_symbol_to_coding_window (
                                 esi_t           new_src_symbol_esi);
 
 
+/**
+ * Encoder: same as swif_encoder_add_source_symbol_to_coding_window() for
+ * a source symbol of its own length, with variable length source symbols
+ * (see swif_ENCODER_SET_PARAM_VARIABLE_LENGTH_SOURCE_SYMBOLS). Only its
+ * new_src_symbol_length bytes are read.
+ *
+ * @param new_src_symbol_length length of the source symbol, at most
+ *              symbol_size - SWIF_LENGTH_FIELD_SIZE.
+ * @return
+ */
+swif_status_t   swif_encoder_add_variable_length_source_symbol_to_coding_window (
+                                swif_encoder_t* enc,
+                                void*           new_src_symbol_buf,
+                                uint32_t        new_src_symbol_length,
+                                esi_t           new_src_symbol_esi);
+
+
 /**
  * Remove this source symbol from the coding window.
  *
@@ -554,8 +993,26 @@ swif_status_t   swif_decoder_add_source_symbol_to_coding_window (
  *              managed by the codec and no action is needed from the
  *              application. If needed a callback is available to inform
  *              the application that a source symbol has been removed).
- * Decoder:     remove a source symbol from the coding window under
- *              preparation.
+ *              The encoding window has no gap: only its oldest source
+ *              symbol can be removed (SWIF_STATUS_ERROR otherwise), so
+ *              acknowledged source symbols are removed oldest first,
+ *              leaving the unacknowledged ones. The
+ *              source_symbol_removed_from_coding_window_callback (if
+ *              any) is called, and the following repair symbols only
+ *              cover the remaining source symbols.
+ * Decoder:     remove a source symbol from the linear system, e.g.
+ *              because its deadline has passed and it is no longer
+ *              useful to the application. Its column is projected out
+ *              of the system, the rows only covering removed source
+ *              symbols are freed, and the linear system slides forward
+ *              when it is the oldest source symbol. The
+ *              source_symbol_removed_from_linear_system_callback (if
+ *              any) is called. Repair symbols received later whose
+ *              coding window includes it are ignored. A source symbol
+ *              not received yet (nor covered by any repair symbol) may
+ *              be removed as well: it is then ignored when it comes, as
+ *              are the repair symbols covering it, and no callback is
+ *              called for it.
  *
  * @param old_src_symbol_esi    ESI of the source symbol to remove from
  *              the coding window.
@@ -702,6 +1159,289 @@ swif_status_t   swif_encoder_get_coding_coefs_tab (
                                 void**          coding_coefs_tab,
                                 uint32_t*       nb_coefs_in_tab);
 
+
+/**
+ * A cache of the coding coefficients generated from repair keys, that
+ * may be shared by several encoders and decoders (see
+ * swif_ENCODER_SET_PARAM_COEFS_CACHE and swif_DECODER_SET_PARAM_COEFS_CACHE),
+ * e.g. by a relay receiving and sending repair symbols with the same keys.
+ * The least recently used entries are evicted first. When the codec is
+ * built with WITH_THREADS, it may be used from several threads.
+ */
+typedef struct swif_coefs_cache swif_coefs_cache_t;
+
+typedef struct swif_coefs_cache_stats {
+        uint64_t        nb_lookups;     /* coefficient tables asked for */
+        uint64_t        nb_hits;        /* of them, found in the cache */
+        uint64_t        nb_evictions;   /* entries evicted to make room */
+        uint32_t        nb_entries;     /* entries currently cached */
+        uint32_t        nb_bytes;       /* and their size */
+} swif_coefs_cache_stats_t;
+
+/**
+ * Create a coding coefficients cache.
+ *
+ * @param max_nb_entries
+ *              (IN) maximum number of tables kept (not 0).
+ * @param max_nb_bytes
+ *              (IN) maximum memory used by the entries, or 0 for no limit.
+ * @return      the cache, or NULL in case of error.
+ */
+swif_coefs_cache_t* swif_coefs_cache_create (
+                                uint32_t        max_nb_entries,
+                                uint32_t        max_nb_bytes);
+
+/**
+ * Release a coding coefficients cache: it must no longer be used by any
+ * encoder or decoder.
+ */
+void            swif_coefs_cache_release (
+                                swif_coefs_cache_t* cache);
+
+/**
+ * Retrieve the statistics of a coding coefficients cache (e.g. its hit
+ * rate is nb_hits / nb_lookups).
+ *
+ * @return      Completion status (SWIF_STATUS_OK or SWIF_STATUS_ERROR).
+ */
+swif_status_t   swif_coefs_cache_get_statistics (
+                                swif_coefs_cache_t*       cache,
+                                swif_coefs_cache_stats_t* stats);
+
+
+/**
+ * A coefficient atlas holds, in a file, the coding coefficients of all
+ * the repair keys for a maximum coding window size and a density dt.
+ * Once opened (i.e. mapped in memory, and shared by all the processes
+ * using it) and set on encoders or decoders (see
+ * swif_ENCODER_SET_PARAM_COEFS_ATLAS and swif_DECODER_SET_PARAM_COEFS_ATLAS),
+ * the coefficients of a repair key are read from it rather than
+ * generated. Coefficients it cannot serve (other dt, larger coding
+ * window) are generated as usual.
+ */
+typedef struct swif_coefs_atlas swif_coefs_atlas_t;
+
+/**
+ * Write the coefficient atlas of max_coding_window_size coefficients per
+ * repair key, for the density dt, to a file (see also the
+ * applis/coefs_atlas tool). It takes 65536 * max_coding_window_size bytes.
+ *
+ * @return      Completion status (SWIF_STATUS_OK or SWIF_STATUS_ERROR).
+ */
+swif_status_t   swif_coefs_atlas_write (
+                                const char*     path,
+                                uint32_t        max_coding_window_size,
+                                uint8_t         dt);
+
+/**
+ * Map a coefficient atlas file in memory (read only).
+ *
+ * @return      the atlas, or NULL if the file cannot be mapped or is not
+ *              an atlas of this version.
+ */
+swif_coefs_atlas_t* swif_coefs_atlas_open (
+                                const char*     path);
+
+/**
+ * Unmap a coefficient atlas: it must no longer be used by any encoder or
+ * decoder.
+ */
+void            swif_coefs_atlas_close (
+                                swif_coefs_atlas_t* atlas);
+
+
+/*******************************************************************************
+ * Multi-flow Encoder Engine
+ */
+
+/**
+ * An engine owns the encoders of many flows, and builds their repair
+ * symbols on a pool of worker threads. The requests of the application
+ * (source symbols, acknowledged source symbols, repair symbols) are
+ * queued, each flow being handled by always the same worker: the requests
+ * of a flow are done in their order of submission, those of different
+ * flows in parallel. Apart from swif_engine_add_flow(), the encoders of
+ * an engine must not be used directly.
+ *
+ * The engine functions may be called from any thread, but the requests of
+ * a flow must be submitted by one thread at a time. The callbacks are
+ * called from the worker threads (those of a flow by always the same one).
+ */
+typedef struct swif_engine swif_engine_t;
+
+typedef enum {
+        SWIF_ENGINE_SOURCE_SYMBOL = 1,
+        SWIF_ENGINE_REMOVE_SOURCE_SYMBOL,
+        SWIF_ENGINE_REPAIR_SYMBOL
+} swif_engine_request_t;
+
+/**
+ * The completion of a request: given for every repair symbol request,
+ * and for the other requests only when they fail.
+ */
+typedef struct {
+        swif_engine_request_t request;
+        uint32_t        flow_id;
+        swif_status_t   status;
+        /* repair symbol requests: the key and density, and the repair
+         * symbol (NULL if it failed) with its coding window */
+        uint32_t        key;
+        uint8_t         dt;
+        void*           repair_buf;
+        esi_t           first_esi;
+        uint32_t        nss;
+        /* source symbol requests: the ESI */
+        esi_t           esi;
+        /* as given with the request */
+        void*           request_context;
+} swif_engine_completion_t;
+
+/**
+ * Create an engine for up to max_nb_flows flows at a time.
+ *
+ * @param nb_threads    number of worker threads. With 0, the requests are
+ *                      done at once in the thread submitting them (the
+ *                      only possibility if the library is not built
+ *                      WITH_THREADS).
+ * @param repair_symbol_built_callback  (IN) called with each completion,
+ *                      or NULL: the completions are then queued until
+ *                      swif_engine_poll_completions().
+ * @param source_symbol_removed_callback (IN) called when a source symbol
+ *                      leaves the coding window of a flow (its buffer is
+ *                      then no longer used), or NULL.
+ * @param context       (IN) given to the callbacks.
+ * @return              the engine, or NULL in case of error.
+ */
+swif_engine_t*  swif_engine_create (
+                                uint32_t        nb_threads,
+                                uint32_t        max_nb_flows,
+                                void (*repair_symbol_built_callback) (
+                                        void*   context,
+                                        const swif_engine_completion_t* completion),
+                                void (*source_symbol_removed_callback) (
+                                        void*   context,
+                                        uint32_t flow_id,
+                                        esi_t   old_symbol_esi),
+                                void*           context);
+
+/**
+ * Do the requests still queued, stop the workers, and release the engine
+ * with the encoders of its flows. Completions not polled are lost.
+ *
+ * @return      Completion status (SWIF_STATUS_OK or SWIF_STATUS_ERROR).
+ */
+swif_status_t   swif_engine_release (swif_engine_t* engine);
+
+/**
+ * Add a flow, with a new encoder (same parameters as
+ * swif_encoder_create()). The encoder may be set up (e.g. with
+ * swif_encoder_set_parameters()) before the first request of the flow is
+ * submitted, and must then no longer be used by the application. Its
+ * callback functions are those of the engine.
+ *
+ * @param flow_id       (OUT) identifier of the flow, in [0, max_nb_flows).
+ * @return              the encoder of the flow, or NULL in case of error
+ *                      (e.g. max_nb_flows flows already).
+ */
+swif_encoder_t* swif_engine_add_flow (
+                                swif_engine_t*  engine,
+                                swif_codepoint_t codepoint,
+                                uint32_t        verbosity,
+                                uint32_t        symbol_size,
+                                uint32_t        max_coding_window_size,
+                                uint32_t*       flow_id);
+
+/**
+ * Remove a flow once its requests already submitted are done, and
+ * release its encoder. Its flow_id must no longer be used (it may be given
+ * again by swif_engine_add_flow() afterwards).
+ *
+ * @return      Completion status (SWIF_STATUS_OK or SWIF_STATUS_ERROR).
+ */
+swif_status_t   swif_engine_remove_flow (
+                                swif_engine_t*  engine,
+                                uint32_t        flow_id);
+
+/**
+ * Submit a source symbol of a flow (see
+ * swif_encoder_add_source_symbol_to_coding_window()). Its buffer must be
+ * kept until the source_symbol_removed_callback for it, unless the
+ * encoder copies source symbols (swif_ENCODER_SET_PARAM_COPY_SOURCE_SYMBOLS),
+ * in which case it must be kept until the request is done (e.g. until
+ * swif_engine_wait()).
+ *
+ * @return      SWIF_STATUS_OK if the request is queued.
+ */
+swif_status_t   swif_engine_submit_source_symbol (
+                                swif_engine_t*  engine,
+                                uint32_t        flow_id,
+                                void*           new_src_symbol_buf,
+                                esi_t           new_src_symbol_esi,
+                                void*           request_context);
+
+/**
+ * Submit the removal of the oldest source symbol of a flow, e.g. once
+ * acknowledged (see swif_encoder_remove_source_symbol_from_coding_window()).
+ *
+ * @return      SWIF_STATUS_OK if the request is queued.
+ */
+swif_status_t   swif_engine_submit_remove_source_symbol (
+                                swif_engine_t*  engine,
+                                uint32_t        flow_id,
+                                esi_t           old_src_symbol_esi,
+                                void*           request_context);
+
+/**
+ * Submit a repair symbol of a flow, for its coding window once the
+ * requests submitted before are done: it is built as with
+ * swif_encoder_generate_coding_coefs() then swif_build_repair_symbol().
+ * If new_buf is NULL, the repair symbol is allocated by the engine, and
+ * must be given back with swif_engine_release_repair_buffer().
+ *
+ * @return      SWIF_STATUS_OK if the request is queued.
+ */
+swif_status_t   swif_engine_submit_repair_symbol (
+                                swif_engine_t*  engine,
+                                uint32_t        flow_id,
+                                uint32_t        key,
+                                uint8_t         dt,
+                                void*           new_buf,
+                                void*           request_context);
+
+/**
+ * Give back a repair symbol allocated by the engine for a flow (see
+ * swif_engine_submit_repair_symbol()), once the application no longer
+ * needs it: the worker of the flow returns it to the repair buffer pool of
+ * its encoder (see swif_encoder_release_repair_buffer()). This must be
+ * submitted before the removal of the flow; afterwards, the buffer must be
+ * released with free().
+ *
+ * @param buf   (IN) the repair symbol buffer, or NULL.
+ * @return      SWIF_STATUS_OK if the request is queued.
+ */
+swif_status_t   swif_engine_release_repair_buffer (
+                                swif_engine_t*  engine,
+                                uint32_t        flow_id,
+                                void*           buf);
+
+/**
+ * Wait until all the requests submitted so far are done.
+ *
+ * @return      Completion status (SWIF_STATUS_OK or SWIF_STATUS_ERROR).
+ */
+swif_status_t   swif_engine_wait (swif_engine_t* engine);
+
+/**
+ * Retrieve up to max_nb completions queued (when the engine has no
+ * repair_symbol_built_callback), oldest first.
+ *
+ * @return      the number of completions stored in completion_tab.
+ */
+uint32_t        swif_engine_poll_completions (
+                                swif_engine_t*  engine,
+                                swif_engine_completion_t* completion_tab,
+                                uint32_t        max_nb);
+
 /*---------------------------------------------------------------------------*/
 
 #ifdef __cplusplus
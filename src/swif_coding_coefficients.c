@@ -91,3 +91,121 @@ int swif_rlc_generate_coding_coefficients (uint16_t  repair_key,
     return 0; /* success */
 }
 
+
+int swif_rlc_generate_coding_coefficients_batch (const uint16_t  repair_key_tab[],
+                                                 uint8_t*        cc_tab_tab[],
+                                                 const uint16_t  cc_nb_tab[],
+                                                 uint32_t        nb_key,
+                                                 uint8_t         dt,
+                                                 uint8_t         m)
+{
+    uint32_t            first;
+    uint32_t            k;
+    uint32_t            l;
+    tinymt32_lanes_t    s;      /* PRNG internal states */
+
+    if (dt > 15) {
+        return -1; /* error, bad dt parameter */
+    }
+    if (m != 1 && m != 8) {
+        return -2; /* error, bad parameter m */
+    }
+    if (m == 1 && dt == 15) {
+        /* all coefficients are 1 */
+        for (k = 0 ; k < nb_key ; k++) {
+            memset(cc_tab_tab[k], 1, cc_nb_tab[k]);
+        }
+        return 0;
+    }
+
+    for (first = 0 ; first < nb_key ; first += TINYMT32_NB_LANES) {
+        uint32_t    nb_lane = (nb_key - first < TINYMT32_NB_LANES)
+                              ? nb_key - first : TINYMT32_NB_LANES;
+        uint32_t    seed_tab[TINYMT32_NB_LANES] = { 0 };
+        uint32_t    r_tab[TINYMT32_NB_LANES];
+        /* next coefficient of each lane, and whether the draw of its
+         * value is pending (the rand16 draw said it is not zero) */
+        uint32_t    i_tab[TINYMT32_NB_LANES] = { 0 };
+        bool        nonzero_tab[TINYMT32_NB_LANES] = { false };
+        uint32_t    nb_running = 0;
+
+        for (l = 0 ; l < nb_lane ; l++) {
+            seed_tab[l] = repair_key_tab[first + l];
+            if (cc_nb_tab[first + l] > 0) {
+                nb_running++;
+            }
+        }
+        tinymt32_lanes_init(&s, seed_tab);
+        /* each lane consumes its numbers as the serial loops of
+         * swif_rlc_generate_coding_coefficients() do */
+        while (nb_running > 0) {
+            tinymt32_lanes_generate_uint32(&s, r_tab);
+            for (l = 0 ; l < nb_lane ; l++) {
+                uint8_t     *cc_tab = cc_tab_tab[first + l];
+                uint32_t    cc_nb = cc_nb_tab[first + l];
+
+                if (i_tab[l] >= cc_nb) {
+                    continue;
+                }
+                if (m == 1) {
+                    cc_tab[i_tab[l]++] = ((r_tab[l] & 0xF) <= dt) ? 1 : 0;
+                } else if (dt == 15 || nonzero_tab[l]) {
+                    /* coefficient 0 is avoided */
+                    if ((r_tab[l] & 0xFF) != 0) {
+                        cc_tab[i_tab[l]++] = (uint8_t) (r_tab[l] & 0xFF);
+                        nonzero_tab[l] = false;
+                    }
+                } else if ((r_tab[l] & 0xF) <= dt) {
+                    nonzero_tab[l] = true;
+                } else {
+                    cc_tab[i_tab[l]++] = 0;
+                }
+                if (i_tab[l] == cc_nb) {
+                    nb_running--;
+                }
+            }
+        }
+    }
+    return 0; /* success */
+}
+
+
+/* a primitive element of GF(2^^8) (of order 255 with the tables used) */
+#define VANDERMONDE_ALPHA 2
+
+/* alpha^e, by square and multiply */
+static uint8_t vandermonde_alpha_pow (uint32_t e)
+{
+    uint8_t result = 1;
+    uint8_t square = VANDERMONDE_ALPHA;
+
+    for (e %= 255; e != 0; e >>= 1) {
+        if (e & 1) {
+            result = gf256_mul(result, square);
+        }
+        square = gf256_mul(square, square);
+    }
+    return result;
+}
+
+int swif_rlc_generate_vandermonde_coefficients (uint16_t  repair_key,
+                                                uint32_t  first_esi,
+                                                uint8_t   cc_tab[],
+                                                uint16_t  cc_nb)
+{
+    /* not 0 modulo 255: that row would be all ones */
+    uint32_t key = 1 + repair_key % 254;
+    /* from one ESI to the next, the coefficient is multiplied by alpha^key */
+    uint8_t step = vandermonde_alpha_pow(key);
+    uint8_t coef = vandermonde_alpha_pow(key * (first_esi % 255));
+    uint32_t i;
+
+    if (cc_tab == NULL && cc_nb > 0) {
+        return -1; /* error, no table */
+    }
+    for (i = 0; i < cc_nb; i++) {
+        cc_tab[i] = coef;
+        coef = gf256_mul(coef, step);
+    }
+    return 0; /* success */
+}
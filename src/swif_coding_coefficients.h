@@ -39,3 +39,50 @@ int swif_rlc_generate_coding_coefficients (uint16_t  repair_key,
                                            uint8_t   dt,
                                            uint8_t   m);
 
+
+/*
+ * Same as swif_rlc_generate_coding_coefficients() for nb_key repair
+ * keys at once, with the same result for each of them. The PRNGs of
+ * TINYMT32_NB_LANES keys are run side by side (see tinymt32_lanes_t),
+ * which is faster when many coefficient tables are needed together.
+ *
+ * (in) repair_key_tab[] the nb_key repair keys.
+ * (in/out) cc_tab_tab[] nb_key pointers to the tables of coding
+ *                    coefficients, cc_tab_tab[k] being filled for
+ *                    repair_key_tab[k].
+ * (in) cc_nb_tab[]   number of entries in each table.
+ * (in) nb_key        number of repair keys.
+ * (in) dt, m         as for swif_rlc_generate_coding_coefficients().
+ * (out)              returns 0 in case of success, an error code
+ *                    different than 0 otherwise.
+ */
+int swif_rlc_generate_coding_coefficients_batch (const uint16_t  repair_key_tab[],
+                                                 uint8_t*        cc_tab_tab[],
+                                                 const uint16_t  cc_nb_tab[],
+                                                 uint32_t        nb_key,
+                                                 uint8_t         dt,
+                                                 uint8_t         m);
+
+
+/*
+ * Coding coefficients of SWIF_CODEPOINT_RLC_GF_256_VANDERMONDE_CODEC:
+ * the coefficient of source symbol esi for repair_key is
+ * alpha^(x * esi) in GF(2^^8), with x = 1 + repair_key % 254 and alpha
+ * a primitive element (exponents modulo 255). A coefficient only depends
+ * on the key and on the ESI (not on the coding window), which lets a
+ * repair symbol be updated when the coding window slides. The columns of
+ * up to 255 consecutive ESIs are distinct (hence the coding window limit),
+ * and the keys of the repair symbols of a coding window should be
+ * different modulo 254.
+ * (in) repair_key    key associated to this repair symbol.
+ * (in) first_esi     ESI of the first source symbol of the coding window.
+ * (in/out) cc_tab[]  table of cc_nb coding coefficients, cc_tab[i] for
+ *                    first_esi + i. They are all non zero.
+ * (in) cc_nb         number of entries in the table.
+ * (out)              returns 0 in case of success, an error code
+ *                    different than 0 otherwise.
+ */
+int swif_rlc_generate_vandermonde_coefficients (uint16_t  repair_key,
+                                                uint32_t  first_esi,
+                                                uint8_t   cc_tab[],
+                                                uint16_t  cc_nb);
@@ -0,0 +1,172 @@
+/**
+ * SWiF Codec: an open-source sliding window FEC codec in C
+ * https://github.com/irtf-nwcrg/swif-codec
+ */
+
+/*---------------------------------------------------------------------------*/
+
+#define _POSIX_C_SOURCE 200809L /* mmap */
+#include <fcntl.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include "swif_coefs_atlas.h"
+#include "swif_coding_coefficients.h"
+
+/*---------------------------------------------------------------------------*/
+
+struct swif_coefs_atlas {
+    const uint8_t *map;
+    size_t         map_size;
+    const uint8_t *cc_tab;  /* coefficients of key 0, then 1, ... */
+    uint32_t       cc_nb;   /* per key */
+    uint8_t        dt;
+    uint8_t        m;
+};
+
+/* keys generated together when writing an atlas */
+#define ATLAS_NB_KEYS_PER_BATCH 1024
+
+/*---------------------------------------------------------------------------*/
+
+swif_status_t swif_coefs_atlas_write(const char *path, uint32_t max_coding_window_size,
+                                     uint8_t dt)
+{
+    uint8_t header[SWIF_COEFS_ATLAS_HEADER_SIZE];
+    uint32_t field;
+    uint16_t key_tab[ATLAS_NB_KEYS_PER_BATCH];
+    uint16_t cc_nb_tab[ATLAS_NB_KEYS_PER_BATCH];
+    uint8_t *cc_ptr_tab[ATLAS_NB_KEYS_PER_BATCH];
+    uint8_t *cc_tab;
+    uint32_t first, k;
+    FILE *file;
+    bool ok = true;
+
+    if (max_coding_window_size == 0 || max_coding_window_size > UINT16_MAX || dt > 15) {
+        fprintf(stderr, "swif_coefs_atlas_write: bad max_coding_window_size (%u) or dt (%u)\n",
+                max_coding_window_size, dt);
+        return SWIF_STATUS_ERROR;
+    }
+    if ((cc_tab = malloc((size_t)ATLAS_NB_KEYS_PER_BATCH * max_coding_window_size)) == NULL) {
+        fprintf(stderr, "swif_coefs_atlas_write: no memory\n");
+        return SWIF_STATUS_ERROR;
+    }
+    if ((file = fopen(path, "wb")) == NULL) {
+        fprintf(stderr, "swif_coefs_atlas_write: cannot create %s\n", path);
+        free(cc_tab);
+        return SWIF_STATUS_ERROR;
+    }
+
+    memset(header, 0, sizeof(header));
+    memcpy(header, SWIF_COEFS_ATLAS_MAGIC, 8);
+    field = SWIF_COEFS_ATLAS_BYTE_ORDER;
+    memcpy(header + 8, &field, 4);
+    field = SWIF_COEFS_ATLAS_VERSION;
+    memcpy(header + 12, &field, 4);
+    field = SWIF_COEFS_ATLAS_HEADER_SIZE;
+    memcpy(header + 16, &field, 4);
+    memcpy(header + 20, &max_coding_window_size, 4);
+    field = SWIF_COEFS_ATLAS_NB_KEYS;
+    memcpy(header + 24, &field, 4);
+    header[28] = dt;
+    header[29] = 8;
+    ok = fwrite(header, sizeof(header), 1, file) == 1;
+
+    for (first = 0; ok && first < SWIF_COEFS_ATLAS_NB_KEYS; first += ATLAS_NB_KEYS_PER_BATCH) {
+        for (k = 0; k < ATLAS_NB_KEYS_PER_BATCH; k++) {
+            key_tab[k] = (uint16_t)(first + k);
+            cc_nb_tab[k] = (uint16_t)max_coding_window_size;
+            cc_ptr_tab[k] = cc_tab + (size_t)k * max_coding_window_size;
+        }
+        swif_rlc_generate_coding_coefficients_batch(key_tab, cc_ptr_tab, cc_nb_tab,
+                                                    ATLAS_NB_KEYS_PER_BATCH, dt, 8);
+        ok = fwrite(cc_tab, max_coding_window_size, ATLAS_NB_KEYS_PER_BATCH, file)
+             == ATLAS_NB_KEYS_PER_BATCH;
+    }
+    free(cc_tab);
+    if (fclose(file) != 0 || !ok) {
+        fprintf(stderr, "swif_coefs_atlas_write: cannot write %s\n", path);
+        return SWIF_STATUS_ERROR;
+    }
+    return SWIF_STATUS_OK;
+}
+
+swif_coefs_atlas_t *swif_coefs_atlas_open(const char *path)
+{
+    swif_coefs_atlas_t *atlas;
+    struct stat st;
+    const uint8_t *map;
+    uint32_t byte_order, version, header_size, cc_nb, nb_keys;
+    int fd;
+
+    if ((fd = open(path, O_RDONLY)) < 0) {
+        fprintf(stderr, "swif_coefs_atlas_open: cannot open %s\n", path);
+        return NULL;
+    }
+    if (fstat(fd, &st) != 0 || (size_t)st.st_size < SWIF_COEFS_ATLAS_HEADER_SIZE) {
+        fprintf(stderr, "swif_coefs_atlas_open: %s is not an atlas\n", path);
+        close(fd);
+        return NULL;
+    }
+    map = mmap(NULL, (size_t)st.st_size, PROT_READ, MAP_SHARED, fd, 0);
+    close(fd);
+    if (map == MAP_FAILED) {
+        fprintf(stderr, "swif_coefs_atlas_open: cannot map %s\n", path);
+        return NULL;
+    }
+
+    memcpy(&byte_order, map + 8, 4);
+    memcpy(&version, map + 12, 4);
+    memcpy(&header_size, map + 16, 4);
+    memcpy(&cc_nb, map + 20, 4);
+    memcpy(&nb_keys, map + 24, 4);
+    if (memcmp(map, SWIF_COEFS_ATLAS_MAGIC, 8) != 0
+        || byte_order != SWIF_COEFS_ATLAS_BYTE_ORDER
+        || version != SWIF_COEFS_ATLAS_VERSION
+        || header_size < 30 || nb_keys != SWIF_COEFS_ATLAS_NB_KEYS || cc_nb == 0
+        || (size_t)st.st_size != header_size + (size_t)nb_keys * cc_nb) {
+        fprintf(stderr, "swif_coefs_atlas_open: %s is not an atlas of this version "
+                "(or byte order)\n", path);
+        munmap((void *)map, (size_t)st.st_size);
+        return NULL;
+    }
+    if ((atlas = calloc(1, sizeof(swif_coefs_atlas_t))) == NULL) {
+        munmap((void *)map, (size_t)st.st_size);
+        return NULL;
+    }
+    atlas->map = map;
+    atlas->map_size = (size_t)st.st_size;
+    atlas->cc_tab = map + header_size;
+    atlas->cc_nb = cc_nb;
+    atlas->dt = map[28];
+    atlas->m = map[29];
+    return atlas;
+}
+
+void swif_coefs_atlas_close(swif_coefs_atlas_t *atlas)
+{
+    if (atlas == NULL) {
+        return;
+    }
+    munmap((void *)atlas->map, atlas->map_size);
+    free(atlas);
+}
+
+const uint8_t *swif_coefs_atlas_lookup(swif_coefs_atlas_t *atlas,
+                                       uint16_t repair_key,
+                                       uint32_t cc_nb,
+                                       uint8_t  dt,
+                                       uint8_t  m)
+{
+    if (atlas == NULL || dt != atlas->dt || m != atlas->m || cc_nb > atlas->cc_nb) {
+        return NULL;
+    }
+    /* the first cc_nb coefficients are those of a window of cc_nb */
+    return atlas->cc_tab + (size_t)repair_key * atlas->cc_nb;
+}
+
+/*---------------------------------------------------------------------------*/
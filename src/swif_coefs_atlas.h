@@ -0,0 +1,70 @@
+/**
+ * @defgroup    SWiF-Codec
+ * @ingroup     swif-codec-linear
+ * @brief       an open-source sliding window FEC codec in C (linear operations)
+ * @{
+ *
+ * @file
+ * @brief       A coefficient atlas is a file holding the coding coefficients
+ *              of all the 65536 repair keys, for a maximum coding window
+ *              size and a density. Once mapped in memory, generating the
+ *              coefficients of a key is a lookup. The application side
+ *              (writing, opening) is in swif_api.h.
+ *
+ * File format (version 1), in the byte order of the host writing it:
+ *   0  char[8]   magic "SWIFATLS"
+ *   8  uint32_t  SWIF_COEFS_ATLAS_BYTE_ORDER (to detect another order)
+ *  12  uint32_t  version
+ *  16  uint32_t  header size (the offset of the coefficients)
+ *  20  uint32_t  number of coefficients per key (max coding window size)
+ *  24  uint32_t  number of keys (65536)
+ *  28  uint8_t   dt
+ *  29  uint8_t   m
+ *  then zeros up to the header size, then the coefficients of each key
+ *  (in key order).
+ */
+
+/**
+ * SWiF Codec:
+ * https://github.com/irtf-nwcrg/swif-codec
+ */
+
+#ifndef __SWIF_COEFS_ATLAS_H__
+#define __SWIF_COEFS_ATLAS_H__
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <stdint.h>
+#include "swif_api.h"
+
+/*---------------------------------------------------------------------------*/
+
+#define SWIF_COEFS_ATLAS_MAGIC        "SWIFATLS"
+#define SWIF_COEFS_ATLAS_BYTE_ORDER   UINT32_C(0x01020304)
+#define SWIF_COEFS_ATLAS_VERSION      1
+#define SWIF_COEFS_ATLAS_HEADER_SIZE  64
+#define SWIF_COEFS_ATLAS_NB_KEYS      65536
+
+/**
+ * @brief Return the cc_nb coding coefficients of repair_key (in the atlas,
+ *        not to be modified), or NULL if the atlas cannot serve them
+ *        (other dt or m, or more coefficients than in the atlas, or NULL
+ *        atlas).
+ */
+const uint8_t *swif_coefs_atlas_lookup(swif_coefs_atlas_t *atlas,
+                                       uint16_t repair_key,
+                                       uint32_t cc_nb,
+                                       uint8_t  dt,
+                                       uint8_t  m);
+
+/*---------------------------------------------------------------------------*/
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __SWIF_COEFS_ATLAS_H__ */
+/*---------------------------------------------------------------------------*/
+/** @} */
@@ -0,0 +1,246 @@
+/**
+ * SWiF Codec: an open-source sliding window FEC codec in C
+ * https://github.com/irtf-nwcrg/swif-codec
+ */
+
+/*---------------------------------------------------------------------------*/
+
+#ifdef WITH_THREADS
+#define _POSIX_C_SOURCE 200809L
+#include <pthread.h>
+#endif
+
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "swif_coefs_cache.h"
+#include "swif_coding_coefficients.h"
+
+/*---------------------------------------------------------------------------*/
+
+typedef struct s_swif_coefs_cache_entry_t {
+    uint16_t repair_key;
+    uint8_t  dt;
+    uint8_t  m;
+    uint32_t cc_nb;
+    /* least recently used list: prev is more recent */
+    struct s_swif_coefs_cache_entry_t *lru_prev;
+    struct s_swif_coefs_cache_entry_t *lru_next;
+    struct s_swif_coefs_cache_entry_t *hash_next;
+    uint8_t  cc_tab[];
+} swif_coefs_cache_entry_t;
+
+struct swif_coefs_cache {
+    uint32_t                   max_nb_entries;
+    uint32_t                   max_nb_bytes; /* 0 for no limit */
+    swif_coefs_cache_entry_t **bucket_tab;
+    uint32_t                   bucket_mask;
+    swif_coefs_cache_entry_t  *lru_first;   /* most recently used */
+    swif_coefs_cache_entry_t  *lru_last;
+    swif_coefs_cache_stats_t   stats;
+#ifdef WITH_THREADS
+    pthread_mutex_t            mutex;
+#endif
+};
+
+#ifdef WITH_THREADS
+#define COEFS_CACHE_LOCK(cache)   pthread_mutex_lock(&(cache)->mutex)
+#define COEFS_CACHE_UNLOCK(cache) pthread_mutex_unlock(&(cache)->mutex)
+#else
+#define COEFS_CACHE_LOCK(cache)   ((void)0)
+#define COEFS_CACHE_UNLOCK(cache) ((void)0)
+#endif
+
+/*---------------------------------------------------------------------------*/
+
+static inline uint32_t entry_size(uint32_t cc_nb)
+{
+    return (uint32_t)sizeof(swif_coefs_cache_entry_t) + cc_nb;
+}
+
+static inline swif_coefs_cache_entry_t **
+cache_bucket(swif_coefs_cache_t *cache, uint16_t repair_key, uint8_t dt, uint8_t m)
+{
+    uint32_t hash = ((uint32_t)repair_key * 2654435761u) ^ ((uint32_t)dt << 8) ^ m;
+
+    return &cache->bucket_tab[(hash ^ (hash >> 16)) & cache->bucket_mask];
+}
+
+static void cache_lru_unlink(swif_coefs_cache_t *cache, swif_coefs_cache_entry_t *entry)
+{
+    if (entry->lru_prev != NULL) {
+        entry->lru_prev->lru_next = entry->lru_next;
+    } else {
+        cache->lru_first = entry->lru_next;
+    }
+    if (entry->lru_next != NULL) {
+        entry->lru_next->lru_prev = entry->lru_prev;
+    } else {
+        cache->lru_last = entry->lru_prev;
+    }
+}
+
+static void cache_lru_push_first(swif_coefs_cache_t *cache, swif_coefs_cache_entry_t *entry)
+{
+    entry->lru_prev = NULL;
+    entry->lru_next = cache->lru_first;
+    if (cache->lru_first != NULL) {
+        cache->lru_first->lru_prev = entry;
+    } else {
+        cache->lru_last = entry;
+    }
+    cache->lru_first = entry;
+}
+
+static void cache_remove(swif_coefs_cache_t *cache, swif_coefs_cache_entry_t *entry)
+{
+    swif_coefs_cache_entry_t **link =
+        cache_bucket(cache, entry->repair_key, entry->dt, entry->m);
+
+    while (*link != entry) {
+        link = &(*link)->hash_next;
+    }
+    *link = entry->hash_next;
+    cache_lru_unlink(cache, entry);
+    cache->stats.nb_entries--;
+    cache->stats.nb_bytes -= entry_size(entry->cc_nb);
+    free(entry);
+}
+
+static bool cache_is_full(swif_coefs_cache_t *cache, uint32_t new_size)
+{
+    return cache->stats.nb_entries + 1 > cache->max_nb_entries
+        || (cache->max_nb_bytes > 0
+            && cache->stats.nb_bytes + new_size > cache->max_nb_bytes);
+}
+
+/*---------------------------------------------------------------------------*/
+
+swif_coefs_cache_t *swif_coefs_cache_create(uint32_t max_nb_entries, uint32_t max_nb_bytes)
+{
+    swif_coefs_cache_t *cache;
+    uint32_t nb_bucket = 1;
+
+    if (max_nb_entries == 0) {
+        fprintf(stderr, "swif_coefs_cache_create: max_nb_entries must not be 0\n");
+        return NULL;
+    }
+    /* about one entry per bucket */
+    while (nb_bucket < max_nb_entries && nb_bucket < (1u << 24)) {
+        nb_bucket <<= 1;
+    }
+    if ((cache = (swif_coefs_cache_t *)calloc(1, sizeof(swif_coefs_cache_t))) == NULL) {
+        return NULL;
+    }
+    cache->bucket_tab = (swif_coefs_cache_entry_t **)
+        calloc(nb_bucket, sizeof(swif_coefs_cache_entry_t *));
+    if (cache->bucket_tab == NULL) {
+        free(cache);
+        return NULL;
+    }
+    cache->bucket_mask = nb_bucket - 1;
+    cache->max_nb_entries = max_nb_entries;
+    cache->max_nb_bytes = max_nb_bytes;
+#ifdef WITH_THREADS
+    pthread_mutex_init(&cache->mutex, NULL);
+#endif
+    return cache;
+}
+
+void swif_coefs_cache_release(swif_coefs_cache_t *cache)
+{
+    if (cache == NULL) {
+        return;
+    }
+    while (cache->lru_first != NULL) {
+        cache_remove(cache, cache->lru_first);
+    }
+#ifdef WITH_THREADS
+    pthread_mutex_destroy(&cache->mutex);
+#endif
+    free(cache->bucket_tab);
+    free(cache);
+}
+
+swif_status_t swif_coefs_cache_get_statistics(swif_coefs_cache_t *cache,
+                                              swif_coefs_cache_stats_t *stats)
+{
+    if (cache == NULL || stats == NULL) {
+        return SWIF_STATUS_ERROR;
+    }
+    COEFS_CACHE_LOCK(cache);
+    *stats = cache->stats;
+    COEFS_CACHE_UNLOCK(cache);
+    return SWIF_STATUS_OK;
+}
+
+int swif_coefs_cache_generate_coding_coefficients(swif_coefs_cache_t *cache,
+                                                  uint16_t  repair_key,
+                                                  uint8_t   cc_tab[],
+                                                  uint16_t  cc_nb,
+                                                  uint8_t   dt,
+                                                  uint8_t   m)
+{
+    swif_coefs_cache_entry_t **bucket;
+    swif_coefs_cache_entry_t *entry;
+    swif_coefs_cache_entry_t *new_entry;
+    int result;
+
+    if (cache == NULL) {
+        return swif_rlc_generate_coding_coefficients(repair_key, cc_tab, cc_nb, dt, m);
+    }
+
+    COEFS_CACHE_LOCK(cache);
+    cache->stats.nb_lookups++;
+    bucket = cache_bucket(cache, repair_key, dt, m);
+    for (entry = *bucket; entry != NULL; entry = entry->hash_next) {
+        if (entry->repair_key == repair_key && entry->dt == dt && entry->m == m) {
+            break;
+        }
+    }
+    if (entry != NULL && entry->cc_nb >= cc_nb) {
+        cache->stats.nb_hits++;
+        memcpy(cc_tab, entry->cc_tab, cc_nb);
+        cache_lru_unlink(cache, entry);
+        cache_lru_push_first(cache, entry);
+        COEFS_CACHE_UNLOCK(cache);
+        return 0;
+    }
+
+    /* not there, or too short: generated again, and the entry replaced */
+    if (entry != NULL) {
+        cache_remove(cache, entry);
+    }
+    if ((cache->max_nb_bytes > 0 && entry_size(cc_nb) > cache->max_nb_bytes)
+        || (new_entry = (swif_coefs_cache_entry_t *)malloc(entry_size(cc_nb))) == NULL) {
+        COEFS_CACHE_UNLOCK(cache);
+        return swif_rlc_generate_coding_coefficients(repair_key, cc_tab, cc_nb, dt, m);
+    }
+    if ((result = swif_rlc_generate_coding_coefficients(repair_key, new_entry->cc_tab,
+                                                        cc_nb, dt, m)) != 0) {
+        free(new_entry);
+        COEFS_CACHE_UNLOCK(cache);
+        return result;
+    }
+    memcpy(cc_tab, new_entry->cc_tab, cc_nb);
+
+    while (cache->lru_last != NULL && cache_is_full(cache, entry_size(cc_nb))) {
+        cache->stats.nb_evictions++;
+        cache_remove(cache, cache->lru_last);
+    }
+    new_entry->repair_key = repair_key;
+    new_entry->dt = dt;
+    new_entry->m = m;
+    new_entry->cc_nb = cc_nb;
+    bucket = cache_bucket(cache, repair_key, dt, m);
+    new_entry->hash_next = *bucket;
+    *bucket = new_entry;
+    cache_lru_push_first(cache, new_entry);
+    cache->stats.nb_entries++;
+    cache->stats.nb_bytes += entry_size(cc_nb);
+    COEFS_CACHE_UNLOCK(cache);
+    return 0;
+}
+
+/*---------------------------------------------------------------------------*/
@@ -0,0 +1,53 @@
+/**
+ * @defgroup    SWiF-Codec
+ * @ingroup     swif-codec-linear
+ * @brief       an open-source sliding window FEC codec in C (linear operations)
+ * @{
+ *
+ * @file
+ * @brief       A cache of coding coefficient tables, keyed by repair key,
+ *              density and field, that may be shared by several encoders
+ *              and decoders. The application side (creation, statistics)
+ *              is in swif_api.h.
+ */
+
+/**
+ * SWiF Codec:
+ * https://github.com/irtf-nwcrg/swif-codec
+ */
+
+#ifndef __SWIF_COEFS_CACHE_H__
+#define __SWIF_COEFS_CACHE_H__
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <stdint.h>
+#include "swif_api.h"
+
+/*---------------------------------------------------------------------------*/
+
+/**
+ * @brief Same as swif_rlc_generate_coding_coefficients(), but the tables
+ *        are looked up in (and added to) the cache first. The coefficients
+ *        of a key do not depend on cc_nb (they are drawn in sequence), so
+ *        an entry also serves any shorter table of the same key.
+ *        With a NULL cache, the coefficients are simply generated.
+ */
+int swif_coefs_cache_generate_coding_coefficients(swif_coefs_cache_t *cache,
+                                                  uint16_t  repair_key,
+                                                  uint8_t   cc_tab[],
+                                                  uint16_t  cc_nb,
+                                                  uint8_t   dt,
+                                                  uint8_t   m);
+
+/*---------------------------------------------------------------------------*/
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __SWIF_COEFS_CACHE_H__ */
+/*---------------------------------------------------------------------------*/
+/** @} */
@@ -0,0 +1,596 @@
+/**
+ * SWiF Codec: an open-source sliding window FEC codec in C
+ * https://github.com/irtf-nwcrg/swif-codec
+ */
+
+/*---------------------------------------------------------------------------*/
+
+#ifdef WITH_THREADS
+#define _POSIX_C_SOURCE 200809L
+#include <pthread.h>
+#endif
+
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "swif_engine.h"
+
+/*---------------------------------------------------------------------------*/
+
+/* removing a flow is queued as its last request */
+#define ENGINE_REMOVE_FLOW 0
+/* giving back a repair buffer of the flow, without completion */
+#define ENGINE_RELEASE_REPAIR_BUFFER 0xFF
+
+typedef struct {
+    uint8_t  request;  /* swif_engine_request_t, or ENGINE_REMOVE_FLOW */
+    uint8_t  dt;
+    uint32_t flow_id;
+    uint32_t key;
+    esi_t    esi;
+    void    *buf;
+    void    *request_context;
+} engine_job_t;
+
+/* a ring of jobs or completions, growing when full */
+typedef struct {
+    void    *tab;
+    uint32_t elem_size;
+    uint32_t capacity;
+    uint32_t first;
+    uint32_t nb;
+} engine_queue_t;
+
+typedef struct {
+    swif_engine_t  *engine;
+    uint32_t        flow_id;
+    swif_encoder_t *enc;
+} engine_flow_t;
+
+typedef struct {
+    swif_engine_t  *engine;
+    engine_queue_t  job_queue;
+    uint32_t        nb_pending; /* queued or running */
+    bool            stop;
+#ifdef WITH_THREADS
+    pthread_t       thread;
+    bool            started;
+    pthread_mutex_t mutex;
+    pthread_cond_t  work_cond; /* a new job, or stop */
+    pthread_cond_t  idle_cond; /* nb_pending is 0 */
+#endif
+} engine_worker_t;
+
+struct swif_engine {
+    uint32_t         nb_threads;
+    uint32_t         max_nb_flows;
+    engine_flow_t  **flow_tab; /* NULL for a free flow_id */
+    engine_worker_t *worker_tab;
+    engine_queue_t   completion_queue;
+    void (*repair_symbol_built_callback)(void *context,
+                                         const swif_engine_completion_t *completion);
+    void (*source_symbol_removed_callback)(void *context, uint32_t flow_id, esi_t esi);
+    void            *context;
+#ifdef WITH_THREADS
+    pthread_mutex_t  mutex; /* flow_tab and completion_queue */
+#endif
+};
+
+#ifdef WITH_THREADS
+#define ENGINE_LOCK(m)   pthread_mutex_lock(m)
+#define ENGINE_UNLOCK(m) pthread_mutex_unlock(m)
+#else
+#define ENGINE_LOCK(m)   ((void)0)
+#define ENGINE_UNLOCK(m) ((void)0)
+#endif
+
+/*---------------------------------------------------------------------------*/
+
+static bool engine_queue_init(engine_queue_t *queue, uint32_t elem_size)
+{
+    queue->elem_size = elem_size;
+    queue->capacity = SWIF_ENGINE_INITIAL_QUEUE_SIZE;
+    queue->first = queue->nb = 0;
+    queue->tab = malloc((size_t)queue->capacity * elem_size);
+    return queue->tab != NULL;
+}
+
+static bool engine_queue_push(engine_queue_t *queue, const void *elem)
+{
+    uint8_t *tab = (uint8_t *)queue->tab;
+
+    if(queue->nb == queue->capacity)
+    {
+        uint8_t *new_tab = malloc((size_t)2 * queue->capacity * queue->elem_size);
+        uint32_t nb_end = queue->capacity - queue->first; /* before wrapping */
+
+        if(new_tab == NULL)
+        {
+            return false;
+        }
+        memcpy(new_tab, tab + (size_t)queue->first * queue->elem_size,
+               (size_t)nb_end * queue->elem_size);
+        memcpy(new_tab + (size_t)nb_end * queue->elem_size, tab,
+               (size_t)queue->first * queue->elem_size);
+        free(tab);
+        queue->tab = tab = new_tab;
+        queue->first = 0;
+        queue->capacity *= 2;
+    }
+    memcpy(tab + (size_t)((queue->first + queue->nb) % queue->capacity) * queue->elem_size, elem,
+           queue->elem_size);
+    queue->nb++;
+    return true;
+}
+
+static void engine_queue_pop(engine_queue_t *queue, void *elem)
+{
+    memcpy(elem, (uint8_t *)queue->tab + (size_t)queue->first * queue->elem_size,
+           queue->elem_size);
+    queue->first = (queue->first + 1) % queue->capacity;
+    queue->nb--;
+}
+
+/*---------------------------------------------------------------------------*/
+
+static void engine_source_symbol_removed(void *context, esi_t old_symbol_esi)
+{
+    engine_flow_t *flow = (engine_flow_t *)context;
+    swif_engine_t *engine = flow->engine;
+
+    if(engine->source_symbol_removed_callback != NULL)
+    {
+        engine->source_symbol_removed_callback(engine->context, flow->flow_id, old_symbol_esi);
+    }
+}
+
+static void engine_complete(swif_engine_t *engine, const swif_engine_completion_t *completion)
+{
+    if(engine->repair_symbol_built_callback != NULL)
+    {
+        engine->repair_symbol_built_callback(engine->context, completion);
+        return;
+    }
+    ENGINE_LOCK(&engine->mutex);
+    if(!engine_queue_push(&engine->completion_queue, completion))
+    {
+        fprintf(stderr, "swif_engine: completion of flow %u lost, no memory\n",
+                completion->flow_id);
+    }
+    ENGINE_UNLOCK(&engine->mutex);
+}
+
+/* Do a job, in the worker of its flow */
+static void engine_run_job(swif_engine_t *engine, const engine_job_t *job)
+{
+    engine_flow_t *flow;
+    swif_engine_completion_t completion;
+    esi_t last_esi;
+
+    /* written by swif_engine_add_flow() in the application thread; once
+       read, the flow is only released by this worker (ENGINE_REMOVE_FLOW) */
+    ENGINE_LOCK(&engine->mutex);
+    flow = engine->flow_tab[job->flow_id];
+    ENGINE_UNLOCK(&engine->mutex);
+
+    if(job->request == ENGINE_REMOVE_FLOW)
+    {
+        if(flow == NULL)
+        {
+            return; /* removed twice */
+        }
+        swif_encoder_release(flow->enc);
+        ENGINE_LOCK(&engine->mutex);
+        engine->flow_tab[job->flow_id] = NULL;
+        ENGINE_UNLOCK(&engine->mutex);
+        free(flow);
+        return;
+    }
+    if(job->request == ENGINE_RELEASE_REPAIR_BUFFER)
+    {
+        if(flow == NULL)
+        {
+            free(job->buf); /* its pool went with the flow */
+            return;
+        }
+        swif_encoder_release_repair_buffer(flow->enc, job->buf);
+        return;
+    }
+
+    memset(&completion, 0, sizeof(completion));
+    completion.request = (swif_engine_request_t)job->request;
+    completion.flow_id = job->flow_id;
+    completion.request_context = job->request_context;
+    if(flow == NULL)
+    {
+        /* submitted after the removal of the flow */
+        fprintf(stderr, "swif_engine: no flow %u\n", job->flow_id);
+        completion.status = SWIF_STATUS_ERROR;
+        completion.key = job->key;
+        completion.dt = job->dt;
+        completion.esi = job->esi;
+        completion.repair_buf = job->buf;
+        engine_complete(engine, &completion);
+        return;
+    }
+    switch(job->request)
+    {
+    case SWIF_ENGINE_SOURCE_SYMBOL:
+        completion.esi = job->esi;
+        completion.status = swif_encoder_add_source_symbol_to_coding_window(flow->enc, job->buf,
+                                                                            job->esi);
+        break;
+
+    case SWIF_ENGINE_REMOVE_SOURCE_SYMBOL:
+        completion.esi = job->esi;
+        completion.status =
+            swif_encoder_remove_source_symbol_from_coding_window(flow->enc, job->esi);
+        break;
+
+    case SWIF_ENGINE_REPAIR_SYMBOL:
+        completion.key = job->key;
+        completion.dt = job->dt;
+        completion.repair_buf = job->buf;
+        completion.status = swif_encoder_generate_coding_coefs(flow->enc, job->key, job->dt, 0);
+        if(completion.status == SWIF_STATUS_OK)
+        {
+            completion.status = swif_build_repair_symbol(flow->enc, &completion.repair_buf);
+        }
+        if(completion.status != SWIF_STATUS_OK && job->buf == NULL)
+        {
+            swif_encoder_release_repair_buffer(flow->enc, completion.repair_buf);
+            completion.repair_buf = NULL;
+        }
+        swif_encoder_get_coding_window_information(flow->enc, &completion.first_esi, &last_esi,
+                                                   &completion.nss);
+        engine_complete(engine, &completion);
+        return;
+    }
+    if(completion.status != SWIF_STATUS_OK)
+    {
+        engine_complete(engine, &completion);
+    }
+}
+
+#ifdef WITH_THREADS
+
+static void *engine_worker_main(void *arg)
+{
+    engine_worker_t *worker = (engine_worker_t *)arg;
+    engine_job_t job;
+
+    pthread_mutex_lock(&worker->mutex);
+    for(;;)
+    {
+        while(!worker->stop && worker->job_queue.nb == 0)
+        {
+            pthread_cond_wait(&worker->work_cond, &worker->mutex);
+        }
+        if(worker->job_queue.nb == 0)
+        {
+            break; /* stopped, and nothing left */
+        }
+        engine_queue_pop(&worker->job_queue, &job);
+        pthread_mutex_unlock(&worker->mutex);
+
+        engine_run_job(worker->engine, &job);
+
+        pthread_mutex_lock(&worker->mutex);
+        if(--worker->nb_pending == 0)
+        {
+            pthread_cond_broadcast(&worker->idle_cond);
+        }
+    }
+    pthread_mutex_unlock(&worker->mutex);
+    return NULL;
+}
+
+#endif /* WITH_THREADS */
+
+/* Queue a job to the worker of its flow (or do it at once, without workers) */
+static swif_status_t engine_submit(swif_engine_t *engine, const engine_job_t *job,
+                                   const char *func_name)
+{
+    engine_worker_t *worker;
+
+    /* a flow removed in the meantime is noticed by its worker */
+    if(engine == NULL || job->flow_id >= engine->max_nb_flows)
+    {
+        fprintf(stderr, "%s: no flow %u\n", func_name, job->flow_id);
+        return SWIF_STATUS_ERROR;
+    }
+    if(engine->nb_threads == 0)
+    {
+        engine_run_job(engine, job);
+        return SWIF_STATUS_OK;
+    }
+#ifdef WITH_THREADS
+    worker = &engine->worker_tab[job->flow_id % engine->nb_threads];
+    pthread_mutex_lock(&worker->mutex);
+    if(!engine_queue_push(&worker->job_queue, job))
+    {
+        pthread_mutex_unlock(&worker->mutex);
+        fprintf(stderr, "%s: no memory\n", func_name);
+        return SWIF_STATUS_ERROR;
+    }
+    worker->nb_pending++;
+    pthread_cond_signal(&worker->work_cond);
+    pthread_mutex_unlock(&worker->mutex);
+#else
+    (void)worker;
+#endif
+    return SWIF_STATUS_OK;
+}
+
+/*---------------------------------------------------------------------------*/
+
+swif_engine_t *swif_engine_create(uint32_t nb_threads,
+                                  uint32_t max_nb_flows,
+                                  void (*repair_symbol_built_callback)(
+                                      void *context, const swif_engine_completion_t *completion),
+                                  void (*source_symbol_removed_callback)(
+                                      void *context, uint32_t flow_id, esi_t old_symbol_esi),
+                                  void *context)
+{
+    swif_engine_t *engine;
+    uint32_t i;
+
+#ifndef WITH_THREADS
+    if(nb_threads > 0)
+    {
+        fprintf(stderr, "swif_engine_create: not built WITH_THREADS, nb_threads must be 0\n");
+        return NULL;
+    }
+#endif
+    if(max_nb_flows == 0)
+    {
+        fprintf(stderr, "swif_engine_create: max_nb_flows must not be 0\n");
+        return NULL;
+    }
+    if((engine = (swif_engine_t *)calloc(1, sizeof(swif_engine_t))) == NULL)
+    {
+        fprintf(stderr, "swif_engine_create: no memory\n");
+        return NULL;
+    }
+#ifdef WITH_THREADS
+    pthread_mutex_init(&engine->mutex, NULL);
+#endif
+    engine->max_nb_flows = max_nb_flows;
+    engine->repair_symbol_built_callback = repair_symbol_built_callback;
+    engine->source_symbol_removed_callback = source_symbol_removed_callback;
+    engine->context = context;
+    engine->flow_tab = (engine_flow_t **)calloc(max_nb_flows, sizeof(engine_flow_t *));
+    if(engine->flow_tab == NULL
+       || !engine_queue_init(&engine->completion_queue, sizeof(swif_engine_completion_t))
+       || (nb_threads > 0
+           && (engine->worker_tab = (engine_worker_t *)calloc(nb_threads, sizeof(engine_worker_t)))
+                  == NULL))
+    {
+        fprintf(stderr, "swif_engine_create: no memory\n");
+        swif_engine_release(engine);
+        return NULL;
+    }
+#ifdef WITH_THREADS
+    for(i = 0; i < nb_threads; i++)
+    {
+        engine_worker_t *worker = &engine->worker_tab[i];
+
+        worker->engine = engine;
+        pthread_mutex_init(&worker->mutex, NULL);
+        pthread_cond_init(&worker->work_cond, NULL);
+        pthread_cond_init(&worker->idle_cond, NULL);
+        engine->nb_threads++; /* released with the engine from now on */
+        if(!engine_queue_init(&worker->job_queue, sizeof(engine_job_t))
+           || pthread_create(&worker->thread, NULL, engine_worker_main, worker) != 0)
+        {
+            fprintf(stderr, "swif_engine_create: cannot start worker %u\n", i);
+            swif_engine_release(engine);
+            return NULL;
+        }
+        worker->started = true;
+    }
+#else
+    (void)i;
+#endif
+    return engine;
+}
+
+swif_status_t swif_engine_release(swif_engine_t *engine)
+{
+    uint32_t i;
+
+    if(engine == NULL)
+    {
+        return SWIF_STATUS_ERROR;
+    }
+#ifdef WITH_THREADS
+    /* the workers do what is queued before stopping */
+    for(i = 0; i < engine->nb_threads; i++)
+    {
+        engine_worker_t *worker = &engine->worker_tab[i];
+
+        if(worker->started)
+        {
+            pthread_mutex_lock(&worker->mutex);
+            worker->stop = true;
+            pthread_cond_signal(&worker->work_cond);
+            pthread_mutex_unlock(&worker->mutex);
+            pthread_join(worker->thread, NULL);
+        }
+        pthread_cond_destroy(&worker->idle_cond);
+        pthread_cond_destroy(&worker->work_cond);
+        pthread_mutex_destroy(&worker->mutex);
+        free(worker->job_queue.tab);
+    }
+    pthread_mutex_destroy(&engine->mutex);
+#endif
+    for(i = 0; engine->flow_tab != NULL && i < engine->max_nb_flows; i++)
+    {
+        if(engine->flow_tab[i] != NULL)
+        {
+            swif_encoder_release(engine->flow_tab[i]->enc);
+            free(engine->flow_tab[i]);
+        }
+    }
+    free(engine->flow_tab);
+    free(engine->worker_tab);
+    free(engine->completion_queue.tab);
+    free(engine);
+    return SWIF_STATUS_OK;
+}
+
+swif_encoder_t *swif_engine_add_flow(swif_engine_t *engine,
+                                     swif_codepoint_t codepoint,
+                                     uint32_t verbosity,
+                                     uint32_t symbol_size,
+                                     uint32_t max_coding_window_size,
+                                     uint32_t *flow_id)
+{
+    engine_flow_t *flow;
+    uint32_t i;
+
+    if((flow = (engine_flow_t *)calloc(1, sizeof(engine_flow_t))) == NULL)
+    {
+        fprintf(stderr, "swif_engine_add_flow: no memory\n");
+        return NULL;
+    }
+    flow->engine = engine;
+    flow->enc = swif_encoder_create(codepoint, verbosity, symbol_size, max_coding_window_size);
+    if(flow->enc == NULL)
+    {
+        free(flow);
+        return NULL;
+    }
+    swif_encoder_set_callback_functions(flow->enc, engine_source_symbol_removed, flow);
+
+    ENGINE_LOCK(&engine->mutex);
+    for(i = 0; i < engine->max_nb_flows && engine->flow_tab[i] != NULL; i++)
+        ;
+    if(i < engine->max_nb_flows)
+    {
+        flow->flow_id = i;
+        engine->flow_tab[i] = flow;
+    }
+    ENGINE_UNLOCK(&engine->mutex);
+    if(i == engine->max_nb_flows)
+    {
+        fprintf(stderr, "swif_engine_add_flow: already %u flows\n", engine->max_nb_flows);
+        swif_encoder_release(flow->enc);
+        free(flow);
+        return NULL;
+    }
+    *flow_id = i;
+    return flow->enc;
+}
+
+swif_status_t swif_engine_remove_flow(swif_engine_t *engine, uint32_t flow_id)
+{
+    engine_job_t job = { ENGINE_REMOVE_FLOW, 0, flow_id, 0, 0, NULL, NULL };
+    bool found;
+
+    if(engine == NULL || flow_id >= engine->max_nb_flows)
+    {
+        fprintf(stderr, "swif_engine_remove_flow: no flow %u\n", flow_id);
+        return SWIF_STATUS_ERROR;
+    }
+    ENGINE_LOCK(&engine->mutex);
+    found = engine->flow_tab[flow_id] != NULL;
+    ENGINE_UNLOCK(&engine->mutex);
+    if(!found)
+    {
+        fprintf(stderr, "swif_engine_remove_flow: no flow %u\n", flow_id);
+        return SWIF_STATUS_ERROR;
+    }
+    return engine_submit(engine, &job, "swif_engine_remove_flow");
+}
+
+swif_status_t swif_engine_submit_source_symbol(swif_engine_t *engine,
+                                               uint32_t flow_id,
+                                               void *new_src_symbol_buf,
+                                               esi_t new_src_symbol_esi,
+                                               void *request_context)
+{
+    engine_job_t job = { SWIF_ENGINE_SOURCE_SYMBOL, 0, flow_id, 0, new_src_symbol_esi,
+                         new_src_symbol_buf, request_context };
+
+    return engine_submit(engine, &job, "swif_engine_submit_source_symbol");
+}
+
+swif_status_t swif_engine_submit_remove_source_symbol(swif_engine_t *engine,
+                                                      uint32_t flow_id,
+                                                      esi_t old_src_symbol_esi,
+                                                      void *request_context)
+{
+    engine_job_t job = { SWIF_ENGINE_REMOVE_SOURCE_SYMBOL, 0, flow_id, 0, old_src_symbol_esi,
+                         NULL, request_context };
+
+    return engine_submit(engine, &job, "swif_engine_submit_remove_source_symbol");
+}
+
+swif_status_t swif_engine_submit_repair_symbol(swif_engine_t *engine,
+                                               uint32_t flow_id,
+                                               uint32_t key,
+                                               uint8_t dt,
+                                               void *new_buf,
+                                               void *request_context)
+{
+    engine_job_t job = { SWIF_ENGINE_REPAIR_SYMBOL, dt, flow_id, key, 0, new_buf,
+                         request_context };
+
+    return engine_submit(engine, &job, "swif_engine_submit_repair_symbol");
+}
+
+swif_status_t swif_engine_release_repair_buffer(swif_engine_t *engine, uint32_t flow_id, void *buf)
+{
+    engine_job_t job = { ENGINE_RELEASE_REPAIR_BUFFER, 0, flow_id, 0, 0, buf, NULL };
+
+    if(buf == NULL)
+    {
+        return SWIF_STATUS_OK;
+    }
+    return engine_submit(engine, &job, "swif_engine_release_repair_buffer");
+}
+
+swif_status_t swif_engine_wait(swif_engine_t *engine)
+{
+    if(engine == NULL)
+    {
+        return SWIF_STATUS_ERROR;
+    }
+#ifdef WITH_THREADS
+    for(uint32_t i = 0; i < engine->nb_threads; i++)
+    {
+        engine_worker_t *worker = &engine->worker_tab[i];
+
+        pthread_mutex_lock(&worker->mutex);
+        while(worker->nb_pending > 0)
+        {
+            pthread_cond_wait(&worker->idle_cond, &worker->mutex);
+        }
+        pthread_mutex_unlock(&worker->mutex);
+    }
+#endif
+    return SWIF_STATUS_OK;
+}
+
+uint32_t swif_engine_poll_completions(swif_engine_t *engine,
+                                      swif_engine_completion_t *completion_tab,
+                                      uint32_t max_nb)
+{
+    uint32_t nb = 0;
+
+    if(engine == NULL)
+    {
+        return 0;
+    }
+    ENGINE_LOCK(&engine->mutex);
+    while(nb < max_nb && engine->completion_queue.nb > 0)
+    {
+        engine_queue_pop(&engine->completion_queue, &completion_tab[nb++]);
+    }
+    ENGINE_UNLOCK(&engine->mutex);
+    return nb;
+}
+
+/*---------------------------------------------------------------------------*/
@@ -0,0 +1,45 @@
+/**
+ * @defgroup    SWiF-Codec
+ * @ingroup     swif-codec-linear
+ * @brief       an open-source sliding window FEC codec in C (linear operations)
+ * @{
+ *
+ * @file
+ * @brief       A multi-flow encoder engine: the encoders of many flows,
+ *              whose requests are queued to worker threads, a flow being
+ *              always handled by the same worker. The application side is
+ *              in swif_api.h.
+ */
+
+/**
+ * SWiF Codec:
+ * https://github.com/irtf-nwcrg/swif-codec
+ */
+
+#ifndef __SWIF_ENGINE_H__
+#define __SWIF_ENGINE_H__
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <stdint.h>
+#include "swif_api.h"
+
+/*---------------------------------------------------------------------------*/
+
+/**
+ * Initial number of requests of the queue of a worker, and of queued
+ * completions (both grow as needed)
+ */
+#define SWIF_ENGINE_INITIAL_QUEUE_SIZE 64
+
+/*---------------------------------------------------------------------------*/
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __SWIF_ENGINE_H__ */
+/*---------------------------------------------------------------------------*/
+/** @} */
@@ -24,7 +24,8 @@ extern "C" {
 #endif
 
 /* There were initially two designed implementations of the full_symbol
- * - one reimplemented in swif_full_symbol_impl.c (DEFAULT ONE)
+ * - one reimplemented in swif_full_symbol_impl.c (DEFAULT ONE), that can
+ *   also use a preallocated pool of full symbols (fixed size, no malloc)
  * - one as wrapper on top of liblc (NO LONGER USED, fixed size, no malloc)
  */
   
@@ -50,12 +51,41 @@ typedef struct s_swif_full_symbol_set_t swif_full_symbol_set_t;
  */
 typedef uint32_t symbol_id_t;
     
+/**
+ * An operation on the data of full_symbols (or symbols): dst = src1 + coef * src2,
+ * on their first `size' bytes only (e.g. a shorter source symbol, the
+ * bytes after it being zeros).
+ * The data of a row operation is computed apart from its coefficients, so
+ * that a list of them can be done together, tile by tile.
+ */
+typedef struct {
+    uint8_t *dst;
+    uint8_t *src1;
+    uint8_t *src2;
+    uint8_t  coef;
+    uint32_t size;
+} full_symbol_data_op_t;
+
+/**
+ * Bytes of the symbols processed at once by full_symbol_apply_data_ops():
+ * a tile of each source and destination should fit in the L1 cache
+ */
+#define FULL_SYMBOL_TILE_SIZE 2048
+
 /**
  * @brief Create a full_symbol from a source symbol
  */
 swif_full_symbol_t *full_symbol_create_from_source
 (uint32_t symbol_id, uint8_t *symbol_data, uint32_t symbol_size);
 
+/**
+ * @brief Create a full_symbol from a source symbol, without copying it:
+ *        symbol_data must stay valid (and unchanged) as long as the
+ *        full_symbol or one of its clones exists. It is never modified.
+ */
+swif_full_symbol_t *full_symbol_create_from_source_ref
+(uint32_t symbol_id, uint8_t *symbol_data, uint32_t symbol_size);
+
 /**
  * @brief Create a full_symbol from a set of coeffiicents and a symbol
  *        typically this is provided from a received repair packet
@@ -169,6 +199,30 @@ void full_symbol_set_free(swif_full_symbol_set_t *set);
 uint32_t full_symbol_set_add
 (swif_full_symbol_set_t *set, swif_full_symbol_t *full_symbol);
 
+/**
+ * @brief Same as full_symbol_set_add(), but the set takes the ownership
+ *        of full_symbol instead of copying it: it must not be used (nor
+ *        freed) by the caller afterwards.
+ */
+uint32_t full_symbol_set_add_take
+(swif_full_symbol_set_t *set, swif_full_symbol_t *full_symbol);
+
+/**
+ * @brief Add a full_symbol to the set, with Gaussian elimination (the
+ *        full_symbol is not modified, nor captured).
+ */
+void full_symbol_add_with_elimination
+(swif_full_symbol_set_t *set, swif_full_symbol_t *full_symbol);
+
+/**
+ * @brief Same as full_symbol_add_with_elimination(), but the set takes
+ *        the ownership of full_symbol, that is reused when possible
+ *        instead of being copied: it must not be used (nor freed) by the
+ *        caller afterwards.
+ */
+void full_symbol_add_with_elimination_take
+(swif_full_symbol_set_t *set, swif_full_symbol_t *full_symbol);
+
 static inline bool full_symbol_includes_id(swif_full_symbol_t* symbol,
                                            symbol_id_t id);
 
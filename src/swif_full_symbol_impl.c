@@ -20,6 +20,10 @@
 
 const uint32_t FULL_SYMBOL_SET_INITIAL_SIZE = 16;
 
+/* full_symbols of a fixed capacity set that can be live outside of its
+   table, during the elimination of a new symbol */
+const uint32_t FULL_SYMBOL_POOL_EXTRA = 8;
+
 swif_full_symbol_set_t *full_symbol_set_alloc()
 {
     /* allocate the struct */
@@ -43,7 +47,25 @@ swif_full_symbol_set_t *full_symbol_set_alloc()
     }
     result->full_symbol_tab = full_symbol_tab;
     result->first_symbol_id = SYMBOL_ID_NONE;
+    result->max_symbol_id_span = 0;
+    result->last_symbol_id = SYMBOL_ID_NONE;
+    result->removed_before_id = SYMBOL_ID_NONE;
+    result->expired_id_tab = NULL;
+    result->nb_expired_id = 0;
+    result->expired_id_capacity = 0;
+    result->elimination_budget = 0;
+    result->pending_pivot_tab = NULL;
+    result->nb_pending_pivot = 0;
+    result->pending_pivot_capacity = 0;
+    result->update_row_tab = NULL;
+    result->update_result_tab = NULL;
+    result->data_op_tab = NULL;
+    result->update_capacity = 0;
+    result->workers = NULL;
+    result->pool = NULL;
+    result->notify_decodable_func = NULL;
     result->notify_decoded_func = NULL;
+    result->notify_removed_func = NULL;
     result->notify_context = NULL;
     return result;
 }
@@ -62,9 +84,62 @@ void full_symbol_set_free(swif_full_symbol_set_t *set)
     }
     free(set->full_symbol_tab);
     set->full_symbol_tab = NULL;
+    free(set->expired_id_tab);
+    free(set->pending_pivot_tab);
+    free(set->update_row_tab);
+    free(set->update_result_tab);
+    free(set->data_op_tab);
+    if(set->pool != NULL)
+    {
+        full_symbol_pool_free(set->pool);
+    }
     free(set);
 }
 
+swif_full_symbol_set_t *full_symbol_set_alloc_fixed(uint32_t max_symbol_id_span,
+                                                    uint32_t symbol_size)
+{
+    assert(max_symbol_id_span > 0);
+    swif_full_symbol_set_t *set = full_symbol_set_alloc();
+    if(set == NULL)
+    {
+        return NULL;
+    }
+    set->max_symbol_id_span = max_symbol_id_span;
+
+    /* everything is sized for max_symbol_id_span symbol ids */
+    swif_full_symbol_t **full_symbol_tab =
+        realloc(set->full_symbol_tab, max_symbol_id_span * sizeof(swif_full_symbol_t *));
+    if(full_symbol_tab == NULL)
+    {
+        full_symbol_set_free(set);
+        return NULL;
+    }
+    memset(full_symbol_tab, 0, max_symbol_id_span * sizeof(swif_full_symbol_t *));
+    set->full_symbol_tab = full_symbol_tab;
+    set->size = max_symbol_id_span;
+    set->expired_id_tab = (symbol_id_t *)malloc(max_symbol_id_span * sizeof(symbol_id_t));
+    set->pending_pivot_tab = (symbol_id_t *)malloc(max_symbol_id_span * sizeof(symbol_id_t));
+    set->update_row_tab = (uint32_t *)malloc(max_symbol_id_span * sizeof(uint32_t));
+    set->update_result_tab =
+        (swif_full_symbol_t **)malloc(max_symbol_id_span * sizeof(swif_full_symbol_t *));
+    set->data_op_tab =
+        (full_symbol_data_op_t *)malloc(max_symbol_id_span * sizeof(full_symbol_data_op_t));
+    set->pool = full_symbol_pool_alloc(max_symbol_id_span + FULL_SYMBOL_POOL_EXTRA,
+                                       max_symbol_id_span, symbol_size);
+    if(set->expired_id_tab == NULL || set->pending_pivot_tab == NULL ||
+       set->update_row_tab == NULL || set->update_result_tab == NULL ||
+       set->data_op_tab == NULL || set->pool == NULL)
+    {
+        full_symbol_set_free(set);
+        return NULL;
+    }
+    set->expired_id_capacity = max_symbol_id_span;
+    set->pending_pivot_capacity = max_symbol_id_span;
+    set->update_capacity = max_symbol_id_span;
+    return set;
+}
+
 /**
  * @brief Dump a full symbol set (python/json-like representation)
  */
@@ -121,6 +196,18 @@ uint32_t full_symbol_set_add(swif_full_symbol_set_t *set, swif_full_symbol_t *fu
         WARNING_PRINT("cannot allocate memory for full_symbol cloning");
         return ENTRY_INDEX_NONE;
     }
+    return full_symbol_set_add_take(set, full_symbol_cloned);
+}
+
+uint32_t full_symbol_set_add_take(swif_full_symbol_set_t *set,
+                                  swif_full_symbol_t *full_symbol_cloned)
+{
+    assert(set != NULL);
+    if(full_symbol_is_zero(full_symbol_cloned))
+    {
+        full_symbol_free(full_symbol_cloned);
+        return ENTRY_INDEX_NONE;
+    }
     if(set->first_symbol_id == SYMBOL_ID_NONE)
     {
         set->first_symbol_id = full_symbol_cloned->first_nonzero_id;
@@ -208,94 +295,1157 @@ uint32_t full_symbol_set_add(swif_full_symbol_set_t *set, swif_full_symbol_t *fu
         free(set->full_symbol_tab);
         return ENTRY_INDEX_NONE;
     }
-
-    set->full_symbol_tab[idx_pos] = full_symbol_cloned;
-    set->nmbr_packets++;
-    return idx_pos;
-}
-
-/*---------------------------------------------------------------------------*/
-swif_full_symbol_t *full_symbol_set_get_pivot(swif_full_symbol_set_t *set, symbol_id_t symbol_id)
-{
-    IF_DEBUG(full_symbol_set_dump(set, stdout));
-    if(symbol_id >= set->first_symbol_id && symbol_id < (set->size + set->first_symbol_id) &&
-       set->full_symbol_tab[symbol_id - set->first_symbol_id])
+
+    set->full_symbol_tab[idx_pos] = full_symbol_cloned;
+    set->nmbr_packets++;
+    return idx_pos;
+}
+
+/*---------------------------------------------------------------------------*/
+swif_full_symbol_t *full_symbol_set_get_pivot(swif_full_symbol_set_t *set, symbol_id_t symbol_id)
+{
+    IF_DEBUG(full_symbol_set_dump(set, stdout));
+    if(symbol_id >= set->first_symbol_id && symbol_id < (set->size + set->first_symbol_id) &&
+       set->full_symbol_tab[symbol_id - set->first_symbol_id])
+    {
+        DEBUG_PRINT("Coef of pivot is equal to : %u \n",
+                    full_symbol_get_coef(set->full_symbol_tab[symbol_id - set->first_symbol_id],
+                                         symbol_id));
+        return set->full_symbol_tab[symbol_id - set->first_symbol_id];
+    }
+    DEBUG_PRINT("Pivot of symbol id %u is not found \n", symbol_id);
+    return NULL;
+}
+
+/*---------------------------------------------------------------------------*/
+
+static swif_full_symbol_t *full_symbol_alloc_base(swif_full_symbol_pool_t *pool,
+                                                  symbol_id_t first_symbol_id,
+                                                  symbol_id_t last_symbol_id,
+                                                  uint32_t symbol_size,
+                                                  uint8_t *borrowed_data);
+static uint8_t *full_symbol_alloc_own_data(swif_full_symbol_t *symbol);
+static void full_symbol_free_own_data(swif_full_symbol_t *symbol);
+static inline uint32_t full_symbol_count_allocated_coef(swif_full_symbol_t *full_symbol);
+static bool full_symbol_set_reserve_updates(swif_full_symbol_set_t *set, uint32_t nb_row);
+
+/*---------------------------------------------------------------------------*/
+/* One full_symbol operation per pivot, used when the data operations
+   cannot be scheduled (e.g. no memory for them) */
+static swif_full_symbol_t *full_symbol_set_remove_each_pivot_by_row(
+    swif_full_symbol_set_t *full_symbol_set, swif_full_symbol_t *new_symbol1)
+{
+    /* only copies of symbol are stored, so first clone it */
+    swif_full_symbol_t *new_symbol = full_symbol_clone(new_symbol1);
+    if(new_symbol == NULL)
+    {
+        WARNING_PRINT("cannot allocate memory for full_symbol cloning");
+        return NULL;
+    }
+    /* is_zero variable is used to check if all the symbol coefs are zero */
+    bool is_zero = true;
+    full_symbol_adjust_min_max_coef(new_symbol);
+    if(new_symbol->first_nonzero_id == SYMBOL_ID_NONE)
+    {
+        full_symbol_free(new_symbol);
+        return NULL;
+    }
+    for(uint32_t i = new_symbol->first_nonzero_id; i <= new_symbol->last_nonzero_id; i++)
+    {
+        uint8_t coef = full_symbol_get_coef(new_symbol, i);
+        if(coef != 0)
+        {
+            swif_full_symbol_t *symbol_pivot = full_symbol_set_get_pivot(full_symbol_set, i);
+            if(symbol_pivot != NULL)
+            {
+                swif_full_symbol_t *symbol1 = symbol_pivot;
+                /* the symbol is not modified: we first clone it */
+                swif_full_symbol_t *symbol1_cloned = full_symbol_clone(symbol1);
+                if(symbol1_cloned == NULL)
+                {
+                    WARNING_PRINT("cannot allocate memory for full_symbol cloning");
+                    full_symbol_free(new_symbol);
+                    return NULL;
+                }
+                /* symbol1_cloned is multiplied by the associated coef */
+                full_symbol_scale(symbol1_cloned, coef);
+                swif_full_symbol_t *symbol2 = full_symbol_add(new_symbol, symbol1_cloned);
+                if(symbol2 == NULL)
+                {
+                    WARNING_PRINT("cannot allocate memory for full_symbol addition");
+                    full_symbol_free(symbol1_cloned);
+                    full_symbol_free(new_symbol);
+                    return NULL;
+                }
+                /* After the addition, symbol2 may be null, in this case w eliminate it */
+                if(!full_symbol_is_zero(symbol2))
+                {
+                    full_symbol_free(new_symbol);
+                    new_symbol = symbol2;
+                }
+                else
+                {
+                    full_symbol_free(symbol2);
+                }
+                full_symbol_free(symbol1_cloned);
+            }
+            else
+            {
+                is_zero = false;
+            }
+        }
+    }
+    if(is_zero)
+    {
+        full_symbol_free(new_symbol);
+        return NULL;
+    }
+    return new_symbol;
+}
+
+/*---------------------------------------------------------------------------*/
+/* Elimination of the pivots of the set in new_symbol1 (not modified): the
+   result is a new full_symbol, or new_symbol1 itself when it can be
+   reused as it is (only if is_reusable) */
+static swif_full_symbol_t *full_symbol_set_reduce(swif_full_symbol_set_t *full_symbol_set,
+                                                  swif_full_symbol_t *new_symbol1,
+                                                  bool is_reusable)
+{
+    swif_full_symbol_set_t *set = full_symbol_set;
+    if(full_symbol_is_zero(new_symbol1) || set->first_symbol_id == SYMBOL_ID_NONE ||
+       new_symbol1->first_nonzero_id < set->first_symbol_id)
+    {
+        return full_symbol_set_remove_each_pivot_by_row(set, new_symbol1);
+    }
+    /* the pivots that can be used are in the rows from the first symbol id
+       of new_symbol1: they bound the coefficients of the result */
+    symbol_id_t first_id = new_symbol1->first_nonzero_id;
+    symbol_id_t last_id = new_symbol1->last_nonzero_id;
+    for(uint32_t i = first_id - set->first_symbol_id; i < set->size; i++)
+    {
+        swif_full_symbol_t *row = set->full_symbol_tab[i];
+        if(row != NULL)
+        {
+            last_id = MAX(last_id, row->last_nonzero_id);
+        }
+    }
+    if(!full_symbol_set_reserve_updates(set, last_id - first_id + 1))
+    {
+        return full_symbol_set_remove_each_pivot_by_row(set, new_symbol1);
+    }
+    /* the data is only referenced until it is known to be modified */
+    swif_full_symbol_t *new_symbol = full_symbol_alloc_base(
+        new_symbol1->pool, first_id, last_id, new_symbol1->data_size, new_symbol1->data);
+    if(new_symbol == NULL)
+    {
+        WARNING_PRINT("cannot allocate memory for full_symbol cloning");
+        return NULL;
+    }
+    memcpy(new_symbol->coef, new_symbol1->coef + (first_id - new_symbol1->first_id),
+           full_symbol_count_coef(new_symbol1));
+
+    /* the coefficient plane is eliminated first, and gives the schedule of
+       the operations on the data (all done in new_symbol->data, each on the
+       size of its pivot: variable-length rows have different sizes) */
+    uint32_t nb_data_op = 0;
+    uint32_t data_size = new_symbol1->data_size;
+    bool is_same_size = true;
+    for(symbol_id_t i = first_id; i <= last_id; i++)
+    {
+        uint8_t coef = new_symbol->coef[i - first_id];
+        swif_full_symbol_t *pivot;
+        if(coef == 0 || (pivot = full_symbol_set_get_pivot(set, i)) == NULL)
+        {
+            continue;
+        }
+        symbol_add_scaled(new_symbol->coef + (pivot->first_nonzero_id - first_id), coef,
+                          pivot->coef + (pivot->first_nonzero_id - pivot->first_id),
+                          full_symbol_count_coef(pivot));
+        full_symbol_data_op_t *op = &set->data_op_tab[nb_data_op];
+        op->dst = NULL; /* the buffer of new_symbol, see below */
+        op->src1 = (nb_data_op == 0) ? new_symbol1->data : NULL;
+        op->src2 = pivot->data;
+        op->coef = coef;
+        op->size = pivot->data_size;
+        is_same_size = is_same_size && pivot->data_size == new_symbol1->data_size;
+        data_size = MAX(data_size, pivot->data_size);
+        nb_data_op++;
+    }
+    full_symbol_adjust_min_max_coef(new_symbol);
+    if(full_symbol_is_zero(new_symbol))
+    {
+        full_symbol_free(new_symbol);
+        return NULL;
+    }
+    if(nb_data_op == 0 && is_reusable)
+    {
+        full_symbol_free(new_symbol);
+        return new_symbol1; /* nothing to eliminate */
+    }
+    if(nb_data_op == 0 && new_symbol1->data_is_borrowed)
+    {
+        return new_symbol; /* unchanged data: still shared */
+    }
+    new_symbol->data_size = data_size;
+    uint8_t *data = full_symbol_alloc_own_data(new_symbol);
+    if(data == NULL)
+    {
+        WARNING_PRINT("cannot allocate memory for full_symbol cloning");
+        full_symbol_free(new_symbol);
+        return NULL;
+    }
+    new_symbol->data = data;
+    new_symbol->data_is_borrowed = false;
+    if(nb_data_op == 0)
+    {
+        memcpy(data, new_symbol1->data, new_symbol1->data_size);
+        return new_symbol;
+    }
+    if(!is_same_size)
+    {
+        /* new_symbol1 padded with zeros, then all the operations in place */
+        memcpy(data, new_symbol1->data, new_symbol1->data_size);
+        memset(data + new_symbol1->data_size, 0, data_size - new_symbol1->data_size);
+        set->data_op_tab[0].src1 = data;
+    }
+    for(uint32_t k = 0; k < nb_data_op; k++)
+    {
+        set->data_op_tab[k].dst = data;
+        if(k > 0)
+        {
+            set->data_op_tab[k].src1 = data;
+        }
+    }
+    full_symbol_run_data_ops(set->workers, set->data_op_tab, nb_data_op, data_size);
+    return new_symbol;
+}
+
+swif_full_symbol_t *full_symbol_set_remove_each_pivot(swif_full_symbol_set_t *full_symbol_set,
+                                                      swif_full_symbol_t *new_symbol1)
+{
+    return full_symbol_set_reduce(full_symbol_set, new_symbol1, false);
+}
+
+/* Same as full_symbol_set_remove_each_pivot(), new_symbol1 being taken */
+static swif_full_symbol_t *full_symbol_set_remove_each_pivot_take(
+    swif_full_symbol_set_t *full_symbol_set, swif_full_symbol_t *new_symbol1)
+{
+    swif_full_symbol_t *result = full_symbol_set_reduce(full_symbol_set, new_symbol1, true);
+    if(result != new_symbol1)
+    {
+        full_symbol_free(new_symbol1);
+    }
+    return result;
+}
+
+/*---------------------------------------------------------------------------*/
+
+
+/* Buffer where the data of decodable `symbol_id' must be stored, or NULL
+   when it can stay in a buffer of our own. The buffer is never freed. */
+static uint8_t *full_symbol_set_get_decoded_buffer(swif_full_symbol_set_t *set,
+                                                   symbol_id_t symbol_id)
+{
+    if(set->notify_decodable_func == NULL)
+    {
+        return NULL;
+    }
+    return set->notify_decodable_func(set, symbol_id, set->notify_context);
+}
+
+/**
+ * Scale a decodable full_symbol (having only `symbol_id') by coef, writing
+ * its data directly in the decoded buffer of `symbol_id' when there is one.
+ */
+static void full_symbol_set_scale_decoded(swif_full_symbol_set_t *set,
+                                          swif_full_symbol_t *symbol, uint8_t coef)
+{
+    uint8_t *buffer = full_symbol_set_get_decoded_buffer(set, symbol->first_nonzero_id);
+    if(buffer == NULL)
+    {
+        full_symbol_scale(symbol, coef);
+        return;
+    }
+    symbol_mul(symbol->data, coef, symbol->data_size, buffer);
+    symbol_mul(symbol->coef, coef, full_symbol_count_allocated_coef(symbol), symbol->coef);
+    full_symbol_free_own_data(symbol);
+    symbol->data = buffer;
+    symbol->data_is_borrowed = true;
+}
+
+/**
+ * Compute row + coef * pivot as a new full_symbol. The coefficients are
+ * computed first, so that when row becomes decoded, its data is directly
+ * written in the decoded buffer. The data itself is only computed when
+ * data_op->dst is left NULL: otherwise it is the operation to be done with
+ * full_symbol_apply_data_ops(), on the bytes common to row and pivot (the
+ * bytes of the longer one beyond them are done here). Returns NULL if
+ * memory allocation fails.
+ */
+static swif_full_symbol_t *full_symbol_set_eliminate_coef(swif_full_symbol_set_t *set,
+                                                          swif_full_symbol_t *row,
+                                                          swif_full_symbol_t *pivot, uint8_t coef,
+                                                          full_symbol_data_op_t *data_op)
+{
+    data_op->dst = NULL;
+    if(full_symbol_is_zero(row) || full_symbol_is_zero(pivot))
+    {
+        swif_full_symbol_t *symbol_cloned = full_symbol_clone(pivot);
+        if(symbol_cloned == NULL)
+        {
+            return NULL;
+        }
+        full_symbol_scale(symbol_cloned, coef);
+        swif_full_symbol_t *result = full_symbol_add(row, symbol_cloned);
+        full_symbol_free(symbol_cloned);
+        return result;
+    }
+    symbol_id_t first_id = MIN(row->first_nonzero_id, pivot->first_nonzero_id);
+    symbol_id_t last_id = MAX(row->last_nonzero_id, pivot->last_nonzero_id);
+    /* the data is only referenced until the actual buffer is known */
+    uint32_t data_size = MAX(row->data_size, pivot->data_size);
+    uint32_t common_size = MIN(row->data_size, pivot->data_size);
+    swif_full_symbol_t *result =
+        full_symbol_alloc_base(row->pool, first_id, last_id, data_size, row->data);
+    if(result == NULL)
+    {
+        return NULL;
+    }
+    memcpy(result->coef + (row->first_nonzero_id - first_id),
+           row->coef + (row->first_nonzero_id - row->first_id), full_symbol_count_coef(row));
+    symbol_add_scaled(result->coef + (pivot->first_nonzero_id - first_id), coef,
+                      pivot->coef + (pivot->first_nonzero_id - pivot->first_id),
+                      full_symbol_count_coef(pivot));
+    full_symbol_adjust_min_max_coef(result);
+
+    uint8_t *data = NULL;
+    if(!full_symbol_has_one_id(row) && full_symbol_has_one_id(result))
+    {
+        data = full_symbol_set_get_decoded_buffer(set, result->first_nonzero_id);
+    }
+    if(data == NULL)
+    {
+        data = full_symbol_alloc_own_data(result);
+        if(data == NULL)
+        {
+            full_symbol_free(result);
+            return NULL;
+        }
+        result->data_is_borrowed = false;
+    }
+    result->data = data;
+    if(row->data_size > common_size)
+    {
+        memcpy(data + common_size, row->data + common_size, row->data_size - common_size);
+    }
+    else if(pivot->data_size > common_size)
+    {
+        symbol_mul(pivot->data + common_size, coef, pivot->data_size - common_size,
+                   data + common_size);
+    }
+    data_op->dst = data;
+    data_op->src1 = row->data;
+    data_op->src2 = pivot->data;
+    data_op->coef = coef;
+    data_op->size = common_size;
+    return result;
+}
+
+static swif_full_symbol_t *full_symbol_set_eliminate(swif_full_symbol_set_t *set,
+                                                     swif_full_symbol_t *row,
+                                                     swif_full_symbol_t *pivot, uint8_t coef)
+{
+    full_symbol_data_op_t data_op;
+    swif_full_symbol_t *result = full_symbol_set_eliminate_coef(set, row, pivot, coef, &data_op);
+    if(result != NULL && data_op.dst != NULL)
+    {
+        full_symbol_apply_data_ops(&data_op, 1, 0, row->data_size);
+    }
+    return result;
+}
+
+/* callback should not add new symbols to full_symbol_set */
+void full_symbol_set_notify_decoded(swif_full_symbol_set_t *set, symbol_id_t decoded_id)
+{
+    swif_full_symbol_t *row = full_symbol_set_get_pivot(set, decoded_id);
+    if(row != NULL && !row->data_is_borrowed)
+    {
+        /* not computed in place: move it to the decoded buffer */
+        full_symbol_set_scale_decoded(set, row, 1);
+    }
+    if(set->notify_decoded_func != NULL)
+    {
+        set->notify_decoded_func(set, decoded_id, set->notify_context);
+    }
+}
+
+/*---------------------------------------------------------------------------*/
+
+/* Queue the back-substitution of a new pivot (pending_pivot_tab is sorted) */
+static bool full_symbol_set_add_pending(swif_full_symbol_set_t *set, symbol_id_t pivot_id)
+{
+    symbol_id_t *pending_pivot_tab = set->pending_pivot_tab;
+    if(set->nb_pending_pivot == set->pending_pivot_capacity)
+    {
+        uint32_t capacity = MAX(2 * set->pending_pivot_capacity, FULL_SYMBOL_SET_INITIAL_SIZE);
+        pending_pivot_tab = realloc(pending_pivot_tab, sizeof(symbol_id_t) * capacity);
+        if(pending_pivot_tab == NULL)
+        {
+            WARNING_PRINT("failed to reallocate pending_pivot_tab");
+            return false;
+        }
+        set->pending_pivot_capacity = capacity;
+    }
+    uint32_t pos = set->nb_pending_pivot;
+    while(pos > 0 && pending_pivot_tab[pos - 1] > pivot_id)
+    {
+        pending_pivot_tab[pos] = pending_pivot_tab[pos - 1];
+        pos--;
+    }
+    pending_pivot_tab[pos] = pivot_id;
+    set->pending_pivot_tab = pending_pivot_tab;
+    set->nb_pending_pivot++;
+    return true;
+}
+
+/* Forget the pending back-substitution of a pivot (e.g. its row is freed) */
+static void full_symbol_set_drop_pending(swif_full_symbol_set_t *set, symbol_id_t pivot_id)
+{
+    for(uint32_t i = 0; i < set->nb_pending_pivot; i++)
+    {
+        if(set->pending_pivot_tab[i] == pivot_id)
+        {
+            memmove(set->pending_pivot_tab + i, set->pending_pivot_tab + i + 1,
+                    sizeof(symbol_id_t) * (set->nb_pending_pivot - i - 1));
+            set->nb_pending_pivot--;
+            return;
+        }
+    }
+}
+
+void full_symbol_apply_data_ops(full_symbol_data_op_t *op_tab, uint32_t nb_op, uint32_t start,
+                                uint32_t end)
+{
+    for(uint32_t tile = start; tile < end; tile += FULL_SYMBOL_TILE_SIZE)
+    {
+        for(uint32_t i = 0; i < nb_op; i++)
+        {
+            full_symbol_data_op_t *op = &op_tab[i];
+            if(tile >= op->size)
+            {
+                continue;
+            }
+            uint32_t tile_size = MIN(FULL_SYMBOL_TILE_SIZE, MIN(end, op->size) - tile);
+            /* no multiplication for the coefficient 1 (e.g. sparse codes) */
+            if(op->coef == 1)
+            {
+                symbol_add(op->src1 + tile, op->src2 + tile, tile_size, op->dst + tile);
+            }
+            else
+            {
+                symbol_add_scaled_into(op->src1 + tile, op->coef, op->src2 + tile, tile_size,
+                                       op->dst + tile);
+            }
+        }
+    }
+}
+
+/* below this, a stripe is not worth waking up a worker */
+#define FULL_SYMBOL_MIN_STRIPE_SIZE 1024
+
+typedef struct {
+    full_symbol_data_op_t *op_tab;
+    uint32_t               nb_op;
+    uint32_t               data_size;
+} full_symbol_data_op_job_t;
+
+static void full_symbol_data_op_job_run(void *context, uint32_t worker_index, uint32_t nb_workers)
+{
+    full_symbol_data_op_job_t *job = (full_symbol_data_op_job_t *)context;
+    uint32_t start, end;
+    swif_workers_get_stripe(job->data_size, worker_index, nb_workers, &start, &end);
+    full_symbol_apply_data_ops(job->op_tab, job->nb_op, start, end);
+}
+
+void full_symbol_run_data_ops(swif_workers_t *workers, full_symbol_data_op_t *op_tab,
+                              uint32_t nb_op, uint32_t data_size)
+{
+    uint32_t nb_workers = swif_workers_get_nb_workers(workers);
+    if(nb_op == 0 || nb_workers < 2 || data_size < nb_workers * FULL_SYMBOL_MIN_STRIPE_SIZE)
+    {
+        full_symbol_apply_data_ops(op_tab, nb_op, 0, data_size);
+        return;
+    }
+    /* every worker does all the operations, in the same order, on its own
+       bytes: the result is the same as the serial one */
+    full_symbol_data_op_job_t job = { op_tab, nb_op, data_size };
+    swif_workers_run(workers, full_symbol_data_op_job_run, &job);
+}
+
+/* Make room for the update of nb_row rows by one back-substitution */
+static bool full_symbol_set_reserve_updates(swif_full_symbol_set_t *set, uint32_t nb_row)
+{
+    if(nb_row <= set->update_capacity)
+    {
+        return true;
+    }
+    if(set->pool != NULL)
+    {
+        return false; /* preallocated for max_symbol_id_span rows */
+    }
+    uint32_t capacity = MAX(nb_row, FULL_SYMBOL_SET_INITIAL_SIZE);
+    uint32_t *update_row_tab = realloc(set->update_row_tab, capacity * sizeof(uint32_t));
+    if(update_row_tab != NULL)
+    {
+        set->update_row_tab = update_row_tab;
+    }
+    swif_full_symbol_t **update_result_tab =
+        realloc(set->update_result_tab, capacity * sizeof(swif_full_symbol_t *));
+    if(update_result_tab != NULL)
+    {
+        set->update_result_tab = update_result_tab;
+    }
+    full_symbol_data_op_t *data_op_tab =
+        realloc(set->data_op_tab, capacity * sizeof(full_symbol_data_op_t));
+    if(data_op_tab != NULL)
+    {
+        set->data_op_tab = data_op_tab;
+    }
+    if(update_row_tab == NULL || update_result_tab == NULL || data_op_tab == NULL)
+    {
+        WARNING_PRINT("failed to reallocate the update tables");
+        return false;
+    }
+    set->update_capacity = capacity;
+    return true;
+}
+
+/* Compute the data of the rows updated (by tiles), and replace them */
+static void full_symbol_set_apply_updates(swif_full_symbol_set_t *set, uint32_t nb_update,
+                                          uint32_t nb_data_op, uint32_t data_size)
+{
+    full_symbol_run_data_ops(set->workers, set->data_op_tab, nb_data_op, data_size);
+    for(uint32_t k = 0; k < nb_update; k++)
+    {
+        uint32_t i = set->update_row_tab[k];
+        swif_full_symbol_t *row = set->full_symbol_tab[i];
+        swif_full_symbol_t *symbol2 = set->update_result_tab[k];
+        bool is_decoded = !full_symbol_has_one_id(row) && full_symbol_has_one_id(symbol2);
+        full_symbol_free(row);
+        set->full_symbol_tab[i] = symbol2;
+        if(is_decoded)
+        {
+            symbol_id_t si = full_symbol_get_min_symbol_id(symbol2);
+            assert(full_symbol_get_coef(symbol2, si) == 1);
+            full_symbol_set_notify_decoded(set, si);
+        }
+    }
+}
+
+uint32_t full_symbol_set_make_progress(swif_full_symbol_set_t *set, uint32_t budget)
+{
+    uint32_t nb_ops = 0;
+
+    /* the largest pivot first: its row is already free of the pending pivots
+       above it, so eliminating it does not bring them back in other rows */
+    while(set->nb_pending_pivot > 0)
+    {
+        symbol_id_t pivot_id = set->pending_pivot_tab[set->nb_pending_pivot - 1];
+        swif_full_symbol_t *pivot = full_symbol_set_get_pivot(set, pivot_id);
+        assert(pivot != NULL);
+        if(!full_symbol_set_reserve_updates(set, pivot_id - set->first_symbol_id))
+        {
+            WARNING_PRINT("cannot allocate memory for full_symbol elimination");
+            return set->nb_pending_pivot;
+        }
+        /* the coefficients of all the rows are computed first, then their
+           data tile by tile, with each tile of the pivot loaded only once */
+        uint32_t nb_update = 0;
+        uint32_t nb_data_op = 0;
+        bool is_done = true;
+        for(uint32_t i = 0; i < pivot_id - set->first_symbol_id; i++)
+        {
+            swif_full_symbol_t *row = set->full_symbol_tab[i];
+            uint8_t coef;
+            if(row == NULL || (coef = full_symbol_get_coef(row, pivot_id)) == 0)
+            {
+                continue;
+            }
+            if(budget != 0 && nb_ops == budget)
+            {
+                is_done = false;
+                break;
+            }
+            if(nb_update == set->update_capacity ||
+               (set->pool != NULL && set->pool->nb_free < 2))
+            {
+                /* the rows replaced give their full_symbols back */
+                full_symbol_set_apply_updates(set, nb_update, nb_data_op, pivot->data_size);
+                nb_update = 0;
+                nb_data_op = 0;
+            }
+            swif_full_symbol_t *symbol2 =
+                full_symbol_set_eliminate_coef(set, row, pivot, coef, &set->data_op_tab[nb_data_op]);
+            if(symbol2 == NULL)
+            {
+                WARNING_PRINT("cannot allocate memory for full_symbol elimination");
+                is_done = false;
+                break;
+            }
+            if(set->data_op_tab[nb_data_op].dst != NULL)
+            {
+                nb_data_op++;
+            }
+            set->update_row_tab[nb_update] = i;
+            set->update_result_tab[nb_update] = symbol2;
+            nb_update++;
+            nb_ops++;
+        }
+        full_symbol_set_apply_updates(set, nb_update, nb_data_op, pivot->data_size);
+        if(!is_done)
+        {
+            return set->nb_pending_pivot;
+        }
+        set->nb_pending_pivot--;
+    }
+    return 0;
+}
+
+/* callback should not add new symbols to full_symbol_set */
+void full_symbol_set_notify_removed(swif_full_symbol_set_t *set, symbol_id_t removed_id)
+{
+    if(set->notify_removed_func != NULL)
+    {
+        set->notify_removed_func(set, removed_id, set->notify_context);
+    }
+}
+
+/*---------------------------------------------------------------------------*/
+
+void full_symbol_set_remove_before(swif_full_symbol_set_t *set, symbol_id_t new_first_id)
+{
+    if(set->removed_before_id != SYMBOL_ID_NONE && new_first_id <= set->removed_before_id)
+    {
+        return;
+    }
+    set->removed_before_id = new_first_id;
+
+    symbol_id_t old_first_id = set->first_symbol_id;
+    if(old_first_id == SYMBOL_ID_NONE || new_first_id <= old_first_id)
+    {
+        return;
+    }
+
+    /* free the rows whose pivot is removed, and shift the table so that
+       the entries are reused for the newer symbol ids */
+    uint32_t shift = new_first_id - old_first_id;
+    uint32_t nb_removed = MIN(shift, set->size);
+    for(uint32_t i = 0; i < nb_removed; i++)
+    {
+        if(set->full_symbol_tab[i] != NULL)
+        {
+            full_symbol_free(set->full_symbol_tab[i]);
+            set->full_symbol_tab[i] = NULL;
+            set->nmbr_packets--;
+        }
+    }
+    if(nb_removed < set->size)
+    {
+        memmove(set->full_symbol_tab, set->full_symbol_tab + nb_removed,
+                sizeof(swif_full_symbol_t *) * (set->size - nb_removed));
+        memset(set->full_symbol_tab + (set->size - nb_removed), 0,
+               sizeof(swif_full_symbol_t *) * nb_removed);
+    }
+    set->first_symbol_id = new_first_id;
+
+    /* their back-substitution is not needed anymore */
+    uint32_t nb_dropped = 0;
+    while(nb_dropped < set->nb_pending_pivot && set->pending_pivot_tab[nb_dropped] < new_first_id)
+    {
+        nb_dropped++;
+    }
+    if(nb_dropped > 0)
+    {
+        memmove(set->pending_pivot_tab, set->pending_pivot_tab + nb_dropped,
+                sizeof(symbol_id_t) * (set->nb_pending_pivot - nb_dropped));
+        set->nb_pending_pivot -= nb_dropped;
+    }
+
+    /* symbol ids above last_symbol_id never entered the set */
+    symbol_id_t end_id = new_first_id;
+    if(set->last_symbol_id != SYMBOL_ID_NONE && set->last_symbol_id < end_id)
+    {
+        end_id = set->last_symbol_id + 1;
+    }
+    uint32_t nb_expired = 0;
+    for(symbol_id_t id = old_first_id; id < end_id; id++)
+    {
+        /* out of order removals were already notified (or never entered
+           the set, when removed before being seen) */
+        if(nb_expired < set->nb_expired_id && set->expired_id_tab[nb_expired] == id)
+        {
+            nb_expired++;
+            continue;
+        }
+        full_symbol_set_notify_removed(set, id);
+    }
+    while(nb_expired < set->nb_expired_id && set->expired_id_tab[nb_expired] < new_first_id)
+    {
+        nb_expired++;
+    }
+    if(nb_expired > 0)
+    {
+        set->nb_expired_id -= nb_expired;
+        memmove(set->expired_id_tab, set->expired_id_tab + nb_expired,
+                sizeof(symbol_id_t) * set->nb_expired_id);
+    }
+}
+
+static bool full_symbol_set_is_expired(swif_full_symbol_set_t *set, symbol_id_t symbol_id)
+{
+    for(uint32_t i = 0; i < set->nb_expired_id && set->expired_id_tab[i] <= symbol_id; i++)
+    {
+        if(set->expired_id_tab[i] == symbol_id)
+        {
+            return true;
+        }
+    }
+    return false;
+}
+
+/**
+ * Remember that `symbol_id' has expired, in order to ignore the symbols
+ * including it from now on.
+ */
+static void full_symbol_set_add_expired_id(swif_full_symbol_set_t *set, symbol_id_t symbol_id)
+{
+    symbol_id_t *expired_id_tab = set->expired_id_tab;
+    if(set->nb_expired_id == set->expired_id_capacity)
+    {
+        uint32_t capacity = MAX(2 * set->expired_id_capacity, FULL_SYMBOL_SET_INITIAL_SIZE);
+        expired_id_tab = realloc(expired_id_tab, sizeof(symbol_id_t) * capacity);
+        if(expired_id_tab == NULL)
+        {
+            WARNING_PRINT("failed to reallocate expired_id_tab");
+            return;
+        }
+        set->expired_id_capacity = capacity;
+    }
+    uint32_t pos = set->nb_expired_id;
+    while(pos > 0 && expired_id_tab[pos - 1] > symbol_id)
+    {
+        expired_id_tab[pos] = expired_id_tab[pos - 1];
+        pos--;
+    }
+    expired_id_tab[pos] = symbol_id;
+    set->expired_id_tab = expired_id_tab;
+    set->nb_expired_id++;
+}
+
+/**
+ * Eliminate the column of `symbol_id' from all the rows but one, free that
+ * last row, and remember that `symbol_id' has expired.
+ */
+static void full_symbol_set_project_out(swif_full_symbol_set_t *set, symbol_id_t symbol_id)
+{
+    /* the row used to eliminate the column: the pivot of symbol_id if any,
+       otherwise the row including symbol_id with the largest pivot, so that
+       the other rows (with smaller pivots) keep their own pivot */
+    uint32_t pivot_idx = ENTRY_INDEX_NONE;
+    for(uint32_t i = 0; i <= MIN(symbol_id - set->first_symbol_id, set->size - 1); i++)
+    {
+        if(set->full_symbol_tab[i] != NULL &&
+           full_symbol_get_coef(set->full_symbol_tab[i], symbol_id) != 0)
+        {
+            pivot_idx = i;
+        }
+    }
+    if(pivot_idx != ENTRY_INDEX_NONE)
+    {
+        swif_full_symbol_t *pivot = set->full_symbol_tab[pivot_idx];
+        uint8_t pivot_coef_inv = gf256_inv(full_symbol_get_coef(pivot, symbol_id));
+        for(uint32_t i = 0; i < pivot_idx; i++)
+        {
+            swif_full_symbol_t *row = set->full_symbol_tab[i];
+            uint8_t coef;
+            if(row == NULL || (coef = full_symbol_get_coef(row, symbol_id)) == 0)
+            {
+                continue;
+            }
+            swif_full_symbol_t *symbol2 =
+                full_symbol_set_eliminate(set, row, pivot, gf256_mul(coef, pivot_coef_inv));
+            if(symbol2 == NULL)
+            {
+                WARNING_PRINT("cannot allocate memory for full_symbol elimination");
+                continue;
+            }
+            bool is_decoded = !full_symbol_has_one_id(row) && full_symbol_has_one_id(symbol2);
+            full_symbol_free(row);
+            set->full_symbol_tab[i] = symbol2;
+            if(is_decoded)
+            {
+                full_symbol_set_notify_decoded(set, full_symbol_get_min_symbol_id(symbol2));
+            }
+        }
+        full_symbol_free(pivot);
+        set->full_symbol_tab[pivot_idx] = NULL;
+        set->nmbr_packets--;
+        full_symbol_set_drop_pending(set, set->first_symbol_id + pivot_idx);
+    }
+
+    full_symbol_set_add_expired_id(set, symbol_id);
+    full_symbol_set_notify_removed(set, symbol_id);
+}
+
+void full_symbol_set_remove_id(swif_full_symbol_set_t *set, symbol_id_t symbol_id)
+{
+    if(set->first_symbol_id == SYMBOL_ID_NONE || symbol_id <= set->first_symbol_id)
+    {
+        /* nothing older is left: this is just sliding the set */
+        full_symbol_set_remove_before(set, symbol_id + 1);
+    }
+    else if(!full_symbol_set_is_expired(set, symbol_id))
+    {
+        if(symbol_id <= set->last_symbol_id)
+        {
+            full_symbol_set_project_out(set, symbol_id);
+        }
+        else
+        {
+            /* not seen yet: the symbols including it are ignored when they come */
+            full_symbol_set_add_expired_id(set, symbol_id);
+        }
+    }
+    /* slide over the oldest symbol ids when they were removed out of order */
+    while(set->nb_expired_id > 0 && set->expired_id_tab[0] == set->first_symbol_id)
+    {
+        full_symbol_set_remove_before(set, set->first_symbol_id + 1);
+    }
+}
+
+
+/*---------------------------------------------------------------------------*/
+
+/* fixed part: magic, version, span, first/last/removed_before ids, and the
+   number of expired ids, pending pivots and rows */
+#define SNAPSHOT_HEADER_SIZE (9 * 4)
+/* fixed part of a row: first nonzero id, number of coefficients, data size */
+#define SNAPSHOT_ROW_HEADER_SIZE (3 * 4)
+
+uint32_t full_symbol_set_get_snapshot_size(swif_full_symbol_set_t *set)
+{
+    uint32_t size = SNAPSHOT_HEADER_SIZE + 4 * (set->nb_expired_id + set->nb_pending_pivot);
+    for(uint32_t i = 0; i < set->size; i++)
+    {
+        swif_full_symbol_t *row = set->full_symbol_tab[i];
+        if(row != NULL)
+        {
+            size += SNAPSHOT_ROW_HEADER_SIZE + full_symbol_count_coef(row) + row->data_size;
+        }
+    }
+    return size;
+}
+
+uint32_t full_symbol_set_snapshot(swif_full_symbol_set_t *set, uint8_t *buf, uint32_t size)
+{
+    if(size < full_symbol_set_get_snapshot_size(set))
+    {
+        return 0;
+    }
+    uint8_t *ptr = buf;
+    ptr = snapshot_put_u32(ptr, FULL_SYMBOL_SET_SNAPSHOT_MAGIC);
+    ptr = snapshot_put_u32(ptr, FULL_SYMBOL_SET_SNAPSHOT_VERSION);
+    ptr = snapshot_put_u32(ptr, set->max_symbol_id_span);
+    ptr = snapshot_put_u32(ptr, set->first_symbol_id);
+    ptr = snapshot_put_u32(ptr, set->last_symbol_id);
+    ptr = snapshot_put_u32(ptr, set->removed_before_id);
+    ptr = snapshot_put_u32(ptr, set->nb_expired_id);
+    ptr = snapshot_put_u32(ptr, set->nb_pending_pivot);
+    ptr = snapshot_put_u32(ptr, set->nmbr_packets);
+    for(uint32_t i = 0; i < set->nb_expired_id; i++)
+    {
+        ptr = snapshot_put_u32(ptr, set->expired_id_tab[i]);
+    }
+    for(uint32_t i = 0; i < set->nb_pending_pivot; i++)
+    {
+        ptr = snapshot_put_u32(ptr, set->pending_pivot_tab[i]);
+    }
+    for(uint32_t i = 0; i < set->size; i++)
+    {
+        swif_full_symbol_t *row = set->full_symbol_tab[i];
+        if(row == NULL)
+        {
+            continue;
+        }
+        /* rows are never zero: only the nonzero coefficients are written */
+        uint32_t nb_coef = full_symbol_count_coef(row);
+        ptr = snapshot_put_u32(ptr, row->first_nonzero_id);
+        ptr = snapshot_put_u32(ptr, nb_coef);
+        ptr = snapshot_put_u32(ptr, row->data_size);
+        memcpy(ptr, row->coef + (row->first_nonzero_id - row->first_id), nb_coef);
+        ptr += nb_coef;
+        memcpy(ptr, row->data, row->data_size);
+        ptr += row->data_size;
+    }
+    return ptr - buf;
+}
+
+/* Read n symbol ids, sorted and all within [first_id, last_id] */
+static bool full_symbol_set_restore_ids(const uint8_t **ptr, const uint8_t *end, uint32_t n,
+                                        symbol_id_t first_id, symbol_id_t last_id,
+                                        symbol_id_t *id_tab)
+{
+    if((uint32_t)(end - *ptr) / 4 < n)
+    {
+        return false;
+    }
+    for(uint32_t i = 0; i < n; i++)
+    {
+        id_tab[i] = snapshot_get_u32(*ptr);
+        *ptr += 4;
+        if(id_tab[i] < first_id || id_tab[i] > last_id || (i > 0 && id_tab[i] <= id_tab[i - 1]))
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+/* Empty a set after a failed restore */
+static void full_symbol_set_clear(swif_full_symbol_set_t *set)
+{
+    for(uint32_t i = 0; i < set->size; i++)
+    {
+        if(set->full_symbol_tab[i] != NULL)
+        {
+            full_symbol_free(set->full_symbol_tab[i]);
+            set->full_symbol_tab[i] = NULL;
+        }
+    }
+    set->nmbr_packets = 0;
+    set->first_symbol_id = SYMBOL_ID_NONE;
+    set->last_symbol_id = SYMBOL_ID_NONE;
+    set->removed_before_id = SYMBOL_ID_NONE;
+    set->nb_expired_id = 0;
+    set->nb_pending_pivot = 0;
+}
+
+uint32_t full_symbol_set_restore(swif_full_symbol_set_t *set, const uint8_t *buf, uint32_t size)
+{
+    const uint8_t *ptr = buf;
+    const uint8_t *end = buf + size;
+
+    assert(set->nmbr_packets == 0 && set->last_symbol_id == SYMBOL_ID_NONE);
+    if(size < SNAPSHOT_HEADER_SIZE || snapshot_get_u32(buf) != FULL_SYMBOL_SET_SNAPSHOT_MAGIC ||
+       snapshot_get_u32(buf + 4) != FULL_SYMBOL_SET_SNAPSHOT_VERSION ||
+       snapshot_get_u32(buf + 8) != set->max_symbol_id_span)
+    {
+        return 0;
+    }
+    symbol_id_t first_id = snapshot_get_u32(buf + 12);
+    symbol_id_t last_id = snapshot_get_u32(buf + 16);
+    symbol_id_t removed_before_id = snapshot_get_u32(buf + 20);
+    uint32_t nb_expired = snapshot_get_u32(buf + 24);
+    uint32_t nb_pending = snapshot_get_u32(buf + 28);
+    uint32_t nb_rows = snapshot_get_u32(buf + 32);
+    ptr += SNAPSHOT_HEADER_SIZE;
+    if(nb_rows > 0 && (first_id == SYMBOL_ID_NONE || last_id == SYMBOL_ID_NONE ||
+                       first_id > last_id))
+    {
+        return 0;
+    }
+    if((uint32_t)(end - ptr) / 4 < nb_expired || (uint32_t)(end - ptr) / 4 - nb_expired < nb_pending)
+    {
+        return 0;
+    }
+    /* the table must hold every symbol id up to last_id */
+    uint32_t table_size = (nb_rows > 0) ? last_id - first_id + 1 : 0;
+    if(set->max_symbol_id_span != 0 && table_size > set->max_symbol_id_span)
+    {
+        return 0;
+    }
+    if(table_size > set->size)
+    {
+        if(set->pool != NULL)
+        {
+            return 0;
+        }
+        swif_full_symbol_t **full_symbol_tab =
+            realloc(set->full_symbol_tab, table_size * sizeof(swif_full_symbol_t *));
+        if(full_symbol_tab == NULL)
+        {
+            WARNING_PRINT("failed to reallocate full_symbol_tab");
+            return 0;
+        }
+        memset(full_symbol_tab + set->size, 0,
+               (table_size - set->size) * sizeof(swif_full_symbol_t *));
+        set->full_symbol_tab = full_symbol_tab;
+        set->size = table_size;
+    }
+    if(nb_expired > 0 || nb_pending > 0)
+    {
+        if(nb_rows == 0 && nb_pending > 0)
+        {
+            return 0;
+        }
+        uint32_t nb_ids = MAX(nb_expired, nb_pending);
+        if(set->expired_id_capacity < nb_ids || set->pending_pivot_capacity < nb_ids)
+        {
+            symbol_id_t *expired_id_tab = realloc(set->expired_id_tab, nb_ids * sizeof(symbol_id_t));
+            if(expired_id_tab != NULL)
+            {
+                set->expired_id_tab = expired_id_tab;
+                set->expired_id_capacity = nb_ids;
+            }
+            symbol_id_t *pending_pivot_tab =
+                realloc(set->pending_pivot_tab, nb_ids * sizeof(symbol_id_t));
+            if(pending_pivot_tab != NULL)
+            {
+                set->pending_pivot_tab = pending_pivot_tab;
+                set->pending_pivot_capacity = nb_ids;
+            }
+            if(expired_id_tab == NULL || pending_pivot_tab == NULL)
+            {
+                WARNING_PRINT("failed to reallocate the tables of ids");
+                return 0;
+            }
+        }
+    }
+    /* removed out of order before the set ever slid: within the set */
+    symbol_id_t expired_first_id = (removed_before_id != SYMBOL_ID_NONE) ? removed_before_id
+                                                                         : first_id;
+    /* ids not seen yet may have been removed as well */
+    if(!full_symbol_set_restore_ids(&ptr, end, nb_expired, expired_first_id, SYMBOL_ID_NONE - 1,
+                                    set->expired_id_tab) ||
+       !full_symbol_set_restore_ids(&ptr, end, nb_pending, first_id, last_id,
+                                    set->pending_pivot_tab))
+    {
+        return 0;
+    }
+    set->nb_expired_id = nb_expired;
+    set->nb_pending_pivot = nb_pending;
+    set->first_symbol_id = first_id;
+    set->last_symbol_id = last_id;
+    set->removed_before_id = removed_before_id;
+
+    for(uint32_t r = 0; r < nb_rows; r++)
+    {
+        if(end - ptr < SNAPSHOT_ROW_HEADER_SIZE)
+        {
+            full_symbol_set_clear(set);
+            return 0;
+        }
+        symbol_id_t row_first_id = snapshot_get_u32(ptr);
+        uint32_t nb_coef = snapshot_get_u32(ptr + 4);
+        uint32_t data_size = snapshot_get_u32(ptr + 8);
+        ptr += SNAPSHOT_ROW_HEADER_SIZE;
+        uint32_t idx = row_first_id - first_id;
+        if(row_first_id < first_id || row_first_id > last_id || nb_coef == 0 ||
+           nb_coef > last_id - row_first_id + 1 ||
+           (uint32_t)(end - ptr) < nb_coef || (uint32_t)(end - ptr) - nb_coef < data_size ||
+           ptr[0] == 0 || ptr[nb_coef - 1] == 0 || set->full_symbol_tab[idx] != NULL)
+        {
+            full_symbol_set_clear(set);
+            return 0;
+        }
+        swif_full_symbol_t *row = full_symbol_pool_create(set->pool, (uint8_t *)ptr, row_first_id,
+                                                          nb_coef, (uint8_t *)ptr + nb_coef,
+                                                          data_size);
+        if(row == NULL)
+        {
+            full_symbol_set_clear(set);
+            return 0;
+        }
+        ptr += nb_coef + data_size;
+        set->full_symbol_tab[idx] = row;
+        set->nmbr_packets++;
+    }
+    for(uint32_t i = 0; i < nb_pending; i++)
     {
-        DEBUG_PRINT("Coef of pivot is equal to : %u \n",
-                    full_symbol_get_coef(set->full_symbol_tab[symbol_id - set->first_symbol_id],
-                                         symbol_id));
-        return set->full_symbol_tab[symbol_id - set->first_symbol_id];
+        if(full_symbol_set_get_pivot(set, set->pending_pivot_tab[i]) == NULL)
+        {
+            full_symbol_set_clear(set);
+            return 0;
+        }
     }
-    DEBUG_PRINT("Pivot of symbol id %u is not found \n", symbol_id);
-    return NULL;
+    return ptr - buf;
 }
 
-/*---------------------------------------------------------------------------*/
-swif_full_symbol_t *full_symbol_set_remove_each_pivot(swif_full_symbol_set_t *full_symbol_set,
-                                                      swif_full_symbol_t *new_symbol1)
+/**
+ * Make sure that a symbol covering [first_nonzero_id, last_nonzero_id] fits
+ * within the max_symbol_id_span most recent symbol ids, sliding the set
+ * if needed. Returns false if the symbol is too old (or too wide) to be kept.
+ */
+static bool full_symbol_set_make_room(swif_full_symbol_set_t *set, swif_full_symbol_t *new_symbol)
 {
-    /* only copies of symbol are stored, so first clone it */
-    swif_full_symbol_t *new_symbol = full_symbol_clone(new_symbol1);
-    /* is_zero variable is used to check if all the symbol coefs are zero */
-    bool is_zero = true;
-    full_symbol_adjust_min_max_coef(new_symbol);
-    if(new_symbol->first_nonzero_id == SYMBOL_ID_NONE)
+    symbol_id_t first_id = new_symbol->first_nonzero_id;
+    symbol_id_t last_id = new_symbol->last_nonzero_id;
+
+    if(set->removed_before_id != SYMBOL_ID_NONE && first_id < set->removed_before_id)
     {
-        full_symbol_free(new_symbol);
-        return NULL;
+        return false;
     }
-    for(uint32_t i = new_symbol->first_nonzero_id; i <= new_symbol->last_nonzero_id; i++)
+    for(uint32_t i = 0; i < set->nb_expired_id; i++)
     {
-        uint8_t coef = full_symbol_get_coef(new_symbol, i);
-        if(coef != 0)
+        if(full_symbol_get_coef(new_symbol, set->expired_id_tab[i]) != 0)
         {
-            swif_full_symbol_t *symbol_pivot = full_symbol_set_get_pivot(full_symbol_set, i);
-            if(symbol_pivot != NULL)
-            {
-                swif_full_symbol_t *symbol1 = symbol_pivot;
-                /* the symbol is not modified: we first clone it */
-                swif_full_symbol_t *symbol1_cloned = full_symbol_clone(symbol1);
-                /* symbol1_cloned is multiplied by the associated coef */
-                full_symbol_scale(symbol1_cloned, coef);
-                swif_full_symbol_t *symbol2 = full_symbol_add(new_symbol, symbol1_cloned);
-                /* After the addition, symbol2 may be null, in this case w eliminate it */
-                if(!full_symbol_is_zero(symbol2))
-                {
-                    full_symbol_free(new_symbol);
-                    new_symbol = symbol2;
-                }
-                else
-                {
-                    full_symbol_free(symbol2);
-                }
-                full_symbol_free(symbol1_cloned);
-            }
-            else
-            {
-                is_zero = false;
-            }
+            return false;
         }
     }
-    if(is_zero)
+    if(set->last_symbol_id != SYMBOL_ID_NONE && set->last_symbol_id > last_id)
     {
-        full_symbol_free(new_symbol);
-        return NULL;
+        last_id = set->last_symbol_id;
     }
-    return new_symbol;
+    symbol_id_t new_first_id = SYMBOL_ID_NONE;
+    if(set->max_symbol_id_span != 0 && last_id >= set->max_symbol_id_span)
+    {
+        new_first_id = last_id - set->max_symbol_id_span + 1;
+        if(first_id < new_first_id)
+        {
+            return false;
+        }
+    }
+    set->last_symbol_id = last_id;
+    if(new_first_id != SYMBOL_ID_NONE)
+    {
+        full_symbol_set_remove_before(set, new_first_id);
+    }
+    return true;
 }
 
 /*---------------------------------------------------------------------------*/
 
-/* callback should not add new symbols to full_symbol_set */
-void full_symbol_set_notify_decoded(swif_full_symbol_set_t *set, symbol_id_t decoded_id)
+static uint32_t full_symbol_set_add_as_pivot_take(swif_full_symbol_set_t *full_symbol_set,
+                                                  swif_full_symbol_t *new_symbol)
 {
-    if(set->notify_decoded_func != NULL)
+    full_symbol_adjust_min_max_coef(new_symbol);
+    if(new_symbol->first_nonzero_id == SYMBOL_ID_NONE)
     {
-        set->notify_decoded_func(set, decoded_id, set->notify_context);
+        full_symbol_free(new_symbol);
+        return ENTRY_INDEX_NONE;
     }
-}
+    full_symbol_scale(new_symbol,
+                      gf256_inv(full_symbol_get_coef(new_symbol, new_symbol->first_nonzero_id)));
+    symbol_id_t first_index = new_symbol->first_nonzero_id;
 
-/*---------------------------------------------------------------------------*/
+    IF_DEBUG(full_symbol_dump(new_symbol, stdout));
+    uint32_t idx = full_symbol_set_add_take(full_symbol_set, new_symbol);
+    if(idx == ENTRY_INDEX_NONE)
+    {
+        return ENTRY_INDEX_NONE;
+    }
+    /* the older rows including first_index are updated (back-substitution),
+       possibly only partly when the budget per added symbol is exceeded */
+    if(!full_symbol_set_add_pending(full_symbol_set, first_index))
+    {
+        full_symbol_free(full_symbol_set->full_symbol_tab[idx]);
+        full_symbol_set->full_symbol_tab[idx] = NULL;
+        full_symbol_set->nmbr_packets--;
+        return ENTRY_INDEX_NONE;
+    }
+    full_symbol_set_make_progress(full_symbol_set, full_symbol_set->elimination_budget);
+    return idx;
+}
 
 uint32_t full_symbol_set_add_as_pivot(swif_full_symbol_set_t *full_symbol_set,
                                       swif_full_symbol_t *new_symbol)
@@ -307,68 +1457,102 @@ uint32_t full_symbol_set_add_as_pivot(swif_full_symbol_set_t *full_symbol_set,
     }
     full_symbol_scale(new_symbol,
                       gf256_inv(full_symbol_get_coef(new_symbol, new_symbol->first_nonzero_id)));
-    symbol_id_t first_index = new_symbol->first_nonzero_id;
-
-    for(uint32_t i = 0; i < full_symbol_set->size; i++)
+    swif_full_symbol_t *full_symbol_cloned = full_symbol_clone(new_symbol);
+    if(full_symbol_cloned == NULL)
     {
-        if(full_symbol_set->full_symbol_tab[i])
-        {
-            swif_full_symbol_t *symbol_cloned = full_symbol_clone(new_symbol);
-            uint8_t coef = full_symbol_get_coef(full_symbol_set->full_symbol_tab[i],
-                                                first_index); /* XXX: if coef == 0, nothing to do */
-            full_symbol_scale(symbol_cloned, coef);
-            swif_full_symbol_t *symbol2 =
-                full_symbol_add(full_symbol_set->full_symbol_tab[i], symbol_cloned);
-            bool is_decoded = !full_symbol_has_one_id(full_symbol_set->full_symbol_tab[i]) &&
-                              full_symbol_has_one_id(symbol2);
-            full_symbol_free(full_symbol_set->full_symbol_tab[i]);
-            full_symbol_set->full_symbol_tab[i] = symbol2;
-            full_symbol_free(symbol_cloned);
-            if(is_decoded)
-            {
-                symbol_id_t si = full_symbol_get_min_symbol_id(symbol2);
-                assert(full_symbol_get_coef(symbol2, si) == 1);
-                full_symbol_set_notify_decoded(full_symbol_set, si);
-            }
-        }
+        WARNING_PRINT("cannot allocate memory for full_symbol cloning");
+        return ENTRY_INDEX_NONE;
     }
-    IF_DEBUG(full_symbol_dump(new_symbol, stdout));
-    return full_symbol_set_add(full_symbol_set, new_symbol);
+    return full_symbol_set_add_as_pivot_take(full_symbol_set, full_symbol_cloned);
 }
 
 /*---------------------------------------------------------------------------*/
+/* Add fss_remove_pivot (taken), the result of the elimination of the
+   pivots in a new symbol, that had several symbol ids or not */
+static void full_symbol_set_add_reduced(swif_full_symbol_set_t *full_symbol_set,
+                                        swif_full_symbol_t *fss_remove_pivot,
+                                        bool had_one_id)
+{
+    if(!had_one_id && full_symbol_has_one_id(fss_remove_pivot))
+    {
+        /* decodable: normalize it in its decoded buffer */
+        full_symbol_set_scale_decoded(
+            full_symbol_set, fss_remove_pivot,
+            gf256_inv(full_symbol_get_coef(fss_remove_pivot,
+                                           fss_remove_pivot->first_nonzero_id)));
+    }
+    uint32_t idx = full_symbol_set_add_as_pivot_take(full_symbol_set, fss_remove_pivot);
+    if(idx == ENTRY_INDEX_NONE)
+    {
+        return;
+    }
+    swif_full_symbol_t *stored_symbol = full_symbol_set->full_symbol_tab[idx];
+    bool is_decoded = !had_one_id && full_symbol_has_one_id(stored_symbol);
+    if(is_decoded)
+    {
+        symbol_id_t si = full_symbol_get_min_symbol_id(stored_symbol);
+        assert(full_symbol_get_coef(stored_symbol, si) == 1);
+        full_symbol_set_notify_decoded(full_symbol_set, si);
+    }
+}
+
 void full_symbol_add_with_elimination(swif_full_symbol_set_t *full_symbol_set,
                                       swif_full_symbol_t *new_symbol)
 {
+    /* old rows are evicted before the elimination: they cannot help since
+       the new symbol does not include any of the symbol ids removed */
+    if(full_symbol_is_zero(new_symbol))
+    {
+        return;
+    }
+    if(!full_symbol_set_make_room(full_symbol_set, new_symbol))
+    {
+        DEBUG_PRINT("symbol dropped: too old for the set\n");
+        return;
+    }
     swif_full_symbol_t *fss_remove_pivot =
         full_symbol_set_remove_each_pivot(full_symbol_set, new_symbol);
     if(fss_remove_pivot)
     {
-        uint32_t idx = full_symbol_set_add_as_pivot(full_symbol_set, fss_remove_pivot);
-        full_symbol_free(fss_remove_pivot);
-        if(idx == ENTRY_INDEX_NONE)
-        {
-            return;
-        }
-        swif_full_symbol_t *stored_symbol = full_symbol_set->full_symbol_tab[idx];
-        bool is_decoded =
-            (!full_symbol_has_one_id(new_symbol)) && full_symbol_has_one_id(stored_symbol);
-        if(is_decoded)
-        {
-            symbol_id_t si = full_symbol_get_min_symbol_id(stored_symbol);
-            assert(full_symbol_get_coef(stored_symbol, si) == 1);
-            full_symbol_set_notify_decoded(full_symbol_set, si);
-        }
+        full_symbol_set_add_reduced(full_symbol_set, fss_remove_pivot,
+                                    full_symbol_has_one_id(new_symbol));
+    }
+}
+
+void full_symbol_add_with_elimination_take(swif_full_symbol_set_t *full_symbol_set,
+                                           swif_full_symbol_t *new_symbol)
+{
+    if(full_symbol_is_zero(new_symbol) || !full_symbol_set_make_room(full_symbol_set, new_symbol))
+    {
+        full_symbol_free(new_symbol);
+        return;
+    }
+    bool had_one_id = full_symbol_has_one_id(new_symbol);
+    swif_full_symbol_t *fss_remove_pivot =
+        full_symbol_set_remove_each_pivot_take(full_symbol_set, new_symbol);
+    if(fss_remove_pivot)
+    {
+        full_symbol_set_add_reduced(full_symbol_set, fss_remove_pivot, had_one_id);
     }
 }
 /*---------------------------------------------------------------------------*/
 /**
- * @brief Create a full_symbol from a raw packet (a set of bytes)
- *        and initialize it with content '0'
+ * Allocate a full_symbol with zero coefficients. Its data is either
+ * allocated and initialized to '0' (borrowed_data == NULL), or references
+ * borrowed_data without copying it.
  */
-swif_full_symbol_t *
-full_symbol_alloc(symbol_id_t first_symbol_id, symbol_id_t last_symbol_id, uint32_t symbol_size)
+static swif_full_symbol_t *full_symbol_alloc_base(swif_full_symbol_pool_t *pool,
+                                                  symbol_id_t first_symbol_id,
+                                                  symbol_id_t last_symbol_id,
+                                                  uint32_t symbol_size,
+                                                  uint8_t *borrowed_data)
 {
+    if(pool != NULL)
+    {
+        return full_symbol_pool_get(pool, first_symbol_id, last_symbol_id, symbol_size,
+                                    borrowed_data);
+    }
+
     symbol_id_t symbol_id_size;
     if(first_symbol_id == SYMBOL_ID_NONE)
     {
@@ -399,22 +1583,27 @@ full_symbol_alloc(symbol_id_t first_symbol_id, symbol_id_t last_symbol_id, uint3
     }
     result->coef = coef;
 
-    uint32_t safe_symbol_size = symbol_size;
-    if(safe_symbol_size == 0)
-    {
-        safe_symbol_size = 1; /* because calloc(0,...) can return NULL */
-    }
-    uint8_t *data = (uint8_t *)calloc(safe_symbol_size, sizeof(uint8_t));
+    uint8_t *data = borrowed_data;
     if(data == NULL)
     {
-        /* free the structure in case of problem */
-        free(result->coef);
-        free(result);
-        return NULL;
+        uint32_t safe_symbol_size = symbol_size;
+        if(safe_symbol_size == 0)
+        {
+            safe_symbol_size = 1; /* because calloc(0,...) can return NULL */
+        }
+        data = (uint8_t *)calloc(safe_symbol_size, sizeof(uint8_t));
+        if(data == NULL)
+        {
+            /* free the structure in case of problem */
+            free(result->coef);
+            free(result);
+            return NULL;
+        }
     }
 
     /* fill content */
     result->data = data;
+    result->data_is_borrowed = (borrowed_data != NULL);
     result->first_id = first_symbol_id;
     result->last_id = last_symbol_id;
     result->data_size = symbol_size;
@@ -423,6 +1612,129 @@ full_symbol_alloc(symbol_id_t first_symbol_id, symbol_id_t last_symbol_id, uint3
     return result;
 }
 
+/**
+ * @brief Create a full_symbol from a raw packet (a set of bytes)
+ *        and initialize it with content '0'
+ */
+swif_full_symbol_t *
+full_symbol_alloc(symbol_id_t first_symbol_id, symbol_id_t last_symbol_id, uint32_t symbol_size)
+{
+    return full_symbol_alloc_base(NULL, first_symbol_id, last_symbol_id, symbol_size, NULL);
+}
+
+/* A buffer of our own for the data of symbol, e.g. to replace borrowed data
+   (the one of its entry of the pool, if any) */
+static uint8_t *full_symbol_alloc_own_data(swif_full_symbol_t *symbol)
+{
+    if(symbol->pool != NULL)
+    {
+        return full_symbol_pool_get_data(symbol->pool, symbol);
+    }
+    return (uint8_t *)malloc(MAX(symbol->data_size, 1));
+}
+
+static void full_symbol_free_own_data(swif_full_symbol_t *symbol)
+{
+    if(!symbol->data_is_borrowed && symbol->pool == NULL)
+    {
+        free(symbol->data);
+    }
+}
+
+/*---------------------------------------------------------------------------*/
+
+swif_full_symbol_pool_t *full_symbol_pool_alloc(uint32_t nb_symbols, uint32_t coef_capacity,
+                                                uint32_t data_capacity)
+{
+    swif_full_symbol_pool_t *pool =
+        (swif_full_symbol_pool_t *)calloc(1, sizeof(swif_full_symbol_pool_t));
+    if(pool == NULL)
+    {
+        return NULL;
+    }
+    pool->nb_symbols = nb_symbols;
+    pool->coef_capacity = MAX(coef_capacity, 1);
+    pool->data_capacity = MAX(data_capacity, 1);
+    pool->symbol_tab = (swif_full_symbol_t *)calloc(nb_symbols, sizeof(swif_full_symbol_t));
+    pool->free_tab = (swif_full_symbol_t **)calloc(nb_symbols, sizeof(swif_full_symbol_t *));
+    pool->coef_area = (uint8_t *)calloc(nb_symbols, pool->coef_capacity);
+    pool->data_area = (uint8_t *)calloc(nb_symbols, pool->data_capacity);
+    if(pool->symbol_tab == NULL || pool->free_tab == NULL || pool->coef_area == NULL ||
+       pool->data_area == NULL)
+    {
+        full_symbol_pool_free(pool);
+        return NULL;
+    }
+    for(uint32_t i = 0; i < nb_symbols; i++)
+    {
+        pool->free_tab[i] = &pool->symbol_tab[nb_symbols - 1 - i];
+    }
+    pool->nb_free = nb_symbols;
+    return pool;
+}
+
+void full_symbol_pool_free(swif_full_symbol_pool_t *pool)
+{
+    free(pool->symbol_tab);
+    free(pool->free_tab);
+    free(pool->coef_area);
+    free(pool->data_area);
+    free(pool);
+}
+
+uint8_t *full_symbol_pool_get_data(swif_full_symbol_pool_t *pool, swif_full_symbol_t *symbol)
+{
+    return pool->data_area + (symbol - pool->symbol_tab) * pool->data_capacity;
+}
+
+swif_full_symbol_t *full_symbol_pool_get(swif_full_symbol_pool_t *pool,
+                                         symbol_id_t first_symbol_id,
+                                         symbol_id_t last_symbol_id, uint32_t symbol_size,
+                                         uint8_t *borrowed_data)
+{
+    uint32_t symbol_id_size = 1; /* actually 0 for a zero symbol */
+    if(first_symbol_id != SYMBOL_ID_NONE)
+    {
+        assert(first_symbol_id <= last_symbol_id);
+        symbol_id_size = last_symbol_id - first_symbol_id + 1;
+    }
+    if(pool->nb_free == 0 || symbol_id_size > pool->coef_capacity ||
+       symbol_size > pool->data_capacity)
+    {
+        WARNING_PRINT("full_symbol pool exhausted or too small");
+        return NULL;
+    }
+    swif_full_symbol_t *result = pool->free_tab[--pool->nb_free];
+    uint32_t idx = result - pool->symbol_tab;
+
+    result->coef = pool->coef_area + idx * pool->coef_capacity;
+    memset(result->coef, 0, symbol_id_size);
+    if(borrowed_data != NULL)
+    {
+        result->data = borrowed_data;
+    }
+    else
+    {
+        result->data = pool->data_area + idx * pool->data_capacity;
+        memset(result->data, 0, symbol_size);
+    }
+    result->data_is_borrowed = (borrowed_data != NULL);
+    result->first_id = first_symbol_id;
+    result->last_id = last_symbol_id;
+    result->data_size = symbol_size;
+    result->pool = pool;
+    full_symbol_adjust_min_max_coef(result);
+    return result;
+}
+
+static void full_symbol_pool_put(swif_full_symbol_pool_t *pool, swif_full_symbol_t *symbol)
+{
+    assert(pool->nb_free < pool->nb_symbols);
+    symbol->coef = NULL;
+    symbol->data = NULL;
+    pool->free_tab[pool->nb_free++] = symbol;
+}
+
 /**
  * @brief get the coefficient corresponding to the specified symbol identifier
  */
@@ -448,23 +1760,67 @@ symbol_id_t full_symbol_get_coef_index(swif_full_symbol_t *full_symbol, uint32_t
 swif_full_symbol_t *
 full_symbol_create_from_source(uint32_t symbol_id, uint8_t *symbol_data, uint32_t symbol_size)
 {
-    swif_full_symbol_t *full_symbol = full_symbol_alloc(symbol_id, symbol_id, symbol_size);
+    return full_symbol_pool_create_from_source(NULL, symbol_id, symbol_data, symbol_size, false);
+}
+
+swif_full_symbol_t *full_symbol_pool_create_from_source(swif_full_symbol_pool_t *pool,
+                                                        uint32_t symbol_id,
+                                                        uint8_t *symbol_data,
+                                                        uint32_t symbol_size,
+                                                        bool is_borrowed)
+{
+    assert(symbol_data != NULL);
+    swif_full_symbol_t *full_symbol = full_symbol_alloc_base(
+        pool, symbol_id, symbol_id, symbol_size, is_borrowed ? symbol_data : NULL);
+    if(full_symbol == NULL)
+    {
+        return NULL;
+    }
     symbol_id_t coef_index = full_symbol_get_coef_index(full_symbol, symbol_id);
     full_symbol->coef[coef_index] = 1;
     full_symbol_adjust_min_max_coef(full_symbol);
-    memcpy(full_symbol->data, symbol_data, symbol_size);
-    full_symbol->data_size = symbol_size;
+    if(!is_borrowed)
+    {
+        memcpy(full_symbol->data, symbol_data, symbol_size);
+    }
     return full_symbol;
 }
 
+/**
+ * @brief Create a full_symbol from a source symbol, referencing
+ *        symbol_data instead of copying it. The data is never modified
+ *        (a copy is made first when needed) and must stay valid until the
+ *        full_symbol and all its clones are freed.
+ */
+swif_full_symbol_t *
+full_symbol_create_from_source_ref(uint32_t symbol_id, uint8_t *symbol_data, uint32_t symbol_size)
+{
+    return full_symbol_pool_create_from_source(NULL, symbol_id, symbol_data, symbol_size, true);
+}
+
 swif_full_symbol_t *full_symbol_create(uint8_t *symbol_coef_table,
                                        uint32_t min_symbol_id,
                                        uint32_t nb_symbol_id,
                                        uint8_t *symbol_data,
                                        uint32_t symbol_size)
 {
-    swif_full_symbol_t *full_symbol =
-        full_symbol_alloc(min_symbol_id, min_symbol_id + nb_symbol_id - 1, symbol_size);
+    return full_symbol_pool_create(NULL, symbol_coef_table, min_symbol_id, nb_symbol_id,
+                                   symbol_data, symbol_size);
+}
+
+swif_full_symbol_t *full_symbol_pool_create(swif_full_symbol_pool_t *pool,
+                                            uint8_t *symbol_coef_table,
+                                            uint32_t min_symbol_id,
+                                            uint32_t nb_symbol_id,
+                                            uint8_t *symbol_data,
+                                            uint32_t symbol_size)
+{
+    swif_full_symbol_t *full_symbol = full_symbol_alloc_base(
+        pool, min_symbol_id, min_symbol_id + nb_symbol_id - 1, symbol_size, NULL);
+    if(full_symbol == NULL)
+    {
+        return NULL;
+    }
     /* copy the coefs */
     memcpy(full_symbol->coef, symbol_coef_table, nb_symbol_id * sizeof(uint8_t));
     full_symbol->first_id = min_symbol_id;
@@ -484,10 +1840,15 @@ void full_symbol_free(swif_full_symbol_t *full_symbol)
     // DEBUG_PRINT("free: %08x\n", (unsigned int)full_symbol);
     assert(full_symbol != NULL);
     assert(full_symbol->coef != NULL);
+    assert(full_symbol->data != NULL);
+    if(full_symbol->pool != NULL)
+    {
+        full_symbol_pool_put(full_symbol->pool, full_symbol);
+        return;
+    }
     free(full_symbol->coef);
     full_symbol->coef = NULL;
-    assert(full_symbol->data != NULL);
-    free(full_symbol->data);
+    full_symbol_free_own_data(full_symbol);
     full_symbol->data = NULL;
     free(full_symbol);
 }
@@ -495,11 +1856,13 @@ void full_symbol_free(swif_full_symbol_t *full_symbol)
 /**
  * @brief Create a new (unlinked) copy of a full_symbol
  *    (can return NULL if memory allocation fails)
+ *    Borrowed data is not copied: the clone references it as well.
  */
 swif_full_symbol_t *full_symbol_clone(swif_full_symbol_t *full_symbol)
 {
-    swif_full_symbol_t *result =
-        full_symbol_alloc(full_symbol->first_id, full_symbol->last_id, full_symbol->data_size);
+    swif_full_symbol_t *result = full_symbol_alloc_base(
+        full_symbol->pool, full_symbol->first_id, full_symbol->last_id, full_symbol->data_size,
+        full_symbol->data_is_borrowed ? full_symbol->data : NULL);
     if(result == NULL)
     {
         return NULL;
@@ -515,7 +1878,10 @@ swif_full_symbol_t *full_symbol_clone(swif_full_symbol_t *full_symbol)
     {
         memcpy(result->coef, full_symbol->coef,
                (full_symbol->last_id - full_symbol->first_id + 1) * sizeof(uint8_t));
-        memcpy(result->data, full_symbol->data, full_symbol->data_size * sizeof(uint8_t));
+        if(!result->data_is_borrowed)
+        {
+            memcpy(result->data, full_symbol->data, full_symbol->data_size * sizeof(uint8_t));
+        }
     }
     return result;
 }
@@ -714,7 +2080,27 @@ void full_symbol_scale(swif_full_symbol_t *symbol1, uint8_t coef)
     }
     assert(symbol1->first_nonzero_id != SYMBOL_ID_NONE &&
            symbol1->last_nonzero_id != SYMBOL_ID_NONE);
-    symbol_mul(symbol1->data, coef, symbol1->data_size, symbol1->data);
+    if(coef == 1)
+    {
+        return;
+    }
+    if(symbol1->data_is_borrowed)
+    {
+        /* copy on write: the result goes to a buffer of our own */
+        uint8_t *data = full_symbol_alloc_own_data(symbol1);
+        if(data == NULL)
+        {
+            WARNING_PRINT("cannot allocate memory for full_symbol data");
+            return;
+        }
+        symbol_mul(symbol1->data, coef, symbol1->data_size, data);
+        symbol1->data = data;
+        symbol1->data_is_borrowed = false;
+    }
+    else
+    {
+        symbol_mul(symbol1->data, coef, symbol1->data_size, symbol1->data);
+    }
     symbol_mul(symbol1->coef, coef, full_symbol_count_allocated_coef(symbol1), symbol1->coef);
     full_symbol_adjust_min_max_coef(symbol1); // because after adjust some coeffs could be 0
 }
@@ -812,7 +2198,7 @@ swif_full_symbol_t *full_symbol_add(swif_full_symbol_t *symbol1, swif_full_symbo
     if(full_symbol_is_zero(symbol1) && full_symbol_is_zero(symbol2))
     {
         /* return 0 */
-        return full_symbol_alloc(SYMBOL_ID_NONE, SYMBOL_ID_NONE, 0);
+        return full_symbol_alloc_base(symbol1->pool, SYMBOL_ID_NONE, SYMBOL_ID_NONE, 0, NULL);
     }
     if(full_symbol_is_zero(symbol1))
     {
@@ -844,7 +2230,12 @@ swif_full_symbol_t *full_symbol_add(swif_full_symbol_t *symbol1, swif_full_symbo
         (symbol1->data_size >= symbol2->data_size) ? symbol1->data_size : symbol2->data_size;
 
     swif_full_symbol_t *symbol_result =
-        full_symbol_alloc(first_coef_index, last_coef_index, data_size);
+        full_symbol_alloc_base(symbol1->pool != NULL ? symbol1->pool : symbol2->pool,
+                               first_coef_index, last_coef_index, data_size, NULL);
+    if(symbol_result == NULL)
+    {
+        return NULL;
+    }
 
     full_symbol_add_base(symbol1, symbol2, symbol_result);
     return symbol_result;
@@ -23,6 +23,8 @@ extern "C" {
 
 /*---------------------------------------------------------------------------*/
 
+typedef struct s_swif_full_symbol_pool_t swif_full_symbol_pool_t;
+
 /* The implementation of full_symbol_t, a linear combination of source packets.
  * - `coef' represents the encoding header (coefficients) of the combination
  * - `coef[0]' corresponds to the source symbol of index `first_id'
@@ -34,6 +36,8 @@ extern "C" {
  * maintained after each operation on a packet.
  * - `data' is the coded symbol itself
  * - `data_size' is the size of the coded symbol.
+ * - `data_is_borrowed' is set when `data' references a buffer of the
+ * application (zero-copy), shared by the clones of the full_symbol_t.
  */
 struct s_swif_full_symbol_t {
     /* first_id, last_id  relate to the memory allocation
@@ -51,11 +55,33 @@ struct s_swif_full_symbol_t {
     
     uint8_t *data; /* the coded symbol itself (the data) - never NULL */
     uint32_t data_size; /* size of the coded symbol */
+    bool data_is_borrowed; /* data belongs to someone else: never modified
+                              nor freed, copied first when needed */
+    swif_full_symbol_pool_t *pool; /* where it comes from, NULL for the heap */
+};
+
+/* A fixed number of preallocated full_symbols, all with the same capacity,
+ * so that no memory allocation happens once it is created. The full_symbols
+ * computed from a full_symbol of a pool (clone, add, ...) are taken from
+ * the same pool. Each entry owns a data buffer of data_capacity bytes.
+ */
+struct s_swif_full_symbol_pool_t {
+    uint32_t nb_symbols;
+    uint32_t coef_capacity; /* max number of coefficients (symbol ids) */
+    uint32_t data_capacity; /* max size of the data */
+    swif_full_symbol_t *symbol_tab;
+    uint8_t *coef_area;
+    uint8_t *data_area;
+    swif_full_symbol_t **free_tab; /* stack of the available entries */
+    uint32_t nb_free;
 };
 
 /*---------------------------------------------------------------------------*/
 
 typedef void (*notify_decoded_func_t)(swif_full_symbol_set_t *set, symbol_id_t symbol_id, void *context);
+typedef void (*notify_removed_func_t)(swif_full_symbol_set_t *set, symbol_id_t symbol_id, void *context);
+/* returns the buffer where the decodable symbol must be stored, or NULL */
+typedef uint8_t *(*notify_decodable_func_t)(swif_full_symbol_set_t *set, symbol_id_t symbol_id, void *context);
   
 struct s_swif_full_symbol_set_t {
     uint32_t size; /* size of the table containing pointers to full_symbol */
@@ -63,7 +89,43 @@ struct s_swif_full_symbol_set_t {
     uint32_t nmbr_packets;
     swif_full_symbol_t **full_symbol_tab;
 
+    /* sliding of the set: at most `max_symbol_id_span' symbol ids, ending
+       at `last_symbol_id', are kept (0 means no limit). Symbol ids below
+       `removed_before_id' have been removed from the set for good. */
+    uint32_t    max_symbol_id_span;
+    symbol_id_t last_symbol_id;    /* SYMBOL_ID_NONE if nothing seen yet */
+    symbol_id_t removed_before_id; /* SYMBOL_ID_NONE if nothing removed yet */
+
+    /* symbol ids above removed_before_id, removed out of order (sorted) */
+    symbol_id_t *expired_id_tab;
+    uint32_t     nb_expired_id;
+    uint32_t     expired_id_capacity;
+
+    /* pivots whose back-substitution in the older rows is not done yet
+       (sorted), and max number of row operations done per added symbol
+       (0 means no limit): the set is only in row echelon form until
+       full_symbol_set_make_progress() has done everything */
+    symbol_id_t *pending_pivot_tab;
+    uint32_t     nb_pending_pivot;
+    uint32_t     pending_pivot_capacity;
+    uint32_t     elimination_budget;
+
+    /* the rows updated by a back-substitution, before their data is
+       computed (by tiles, see full_symbol_apply_data_ops) */
+    uint32_t              *update_row_tab;
+    swif_full_symbol_t   **update_result_tab;
+    full_symbol_data_op_t *data_op_tab;
+    uint32_t               update_capacity;
+
+    /* the data operations are striped over these workers (NULL: serial) */
+    swif_workers_t *workers;
+
+    /* the full_symbols of a fixed capacity set (NULL otherwise) */
+    swif_full_symbol_pool_t *pool;
+
+    notify_decodable_func_t notify_decodable_func; /* XXX: manually set */
     notify_decoded_func_t notify_decoded_func; /* XXX: manually set */
+    notify_removed_func_t notify_removed_func; /* XXX: manually set */
     void                 *notify_context;
 };
 
@@ -84,6 +146,145 @@ struct s_swif_full_symbol_set_t {
 symbol_id_t swif_full_symbol_set_add
 (swif_full_symbol_set_t* set, swif_full_symbol_t* full_symbol);
 
+/**
+ * @brief Remove from the set every symbol id strictly below `new_first_id':
+ *        the rows having their pivot there are freed, their table entries
+ *        are reused, and notify_removed_func is called for each symbol id
+ *        leaving the set (oldest first).
+ */
+void full_symbol_set_remove_before
+(swif_full_symbol_set_t *set, symbol_id_t new_first_id);
+
+/**
+ * @brief Remove one symbol id from the set, e.g. because it is no longer
+ *        useful to the application (deadline passed). Its column is
+ *        projected out of the linear system (the row used for this is
+ *        freed), notify_removed_func is called, and the set slides
+ *        forward when the symbol id is the oldest one.
+ *        Symbols including it that are added later are ignored.
+ */
+void full_symbol_set_remove_id
+(swif_full_symbol_set_t *set, symbol_id_t symbol_id);
+
+/**
+ * @brief Create a full_symbol set that does not allocate memory anymore:
+ *        its table and its full_symbols are preallocated for at most
+ *        max_symbol_id_span symbol ids (the limit of the set), of
+ *        symbol_size bytes. The full_symbols added must be taken from
+ *        its pool (see full_symbol_pool_create()).
+ */
+swif_full_symbol_set_t *full_symbol_set_alloc_fixed
+(uint32_t max_symbol_id_span, uint32_t symbol_size);
+
+/**
+ * @brief Allocate/free a pool of nb_symbols full_symbols, with at most
+ *        coef_capacity symbol ids and data_capacity bytes each.
+ */
+swif_full_symbol_pool_t *full_symbol_pool_alloc
+(uint32_t nb_symbols, uint32_t coef_capacity, uint32_t data_capacity);
+
+void full_symbol_pool_free(swif_full_symbol_pool_t *pool);
+
+/**
+ * @brief Take a full_symbol from the pool (with zero coefficients, and
+ *        either zero data or borrowed_data if not NULL). Returns NULL if
+ *        the pool is exhausted or the full_symbol would not fit.
+ */
+swif_full_symbol_t *full_symbol_pool_get
+(swif_full_symbol_pool_t *pool, symbol_id_t first_symbol_id,
+ symbol_id_t last_symbol_id, uint32_t symbol_size, uint8_t *borrowed_data);
+
+/**
+ * @brief Get the data buffer owned by an entry of the pool
+ */
+uint8_t *full_symbol_pool_get_data
+(swif_full_symbol_pool_t *pool, swif_full_symbol_t *symbol);
+
+/**
+ * @brief Same as full_symbol_create_from_source() (or _ref() when
+ *        is_borrowed) and full_symbol_create(), the full_symbol being taken
+ *        from pool (or the heap if pool is NULL).
+ */
+swif_full_symbol_t *full_symbol_pool_create_from_source
+(swif_full_symbol_pool_t *pool, uint32_t symbol_id, uint8_t *symbol_data,
+ uint32_t symbol_size, bool is_borrowed);
+
+swif_full_symbol_t *full_symbol_pool_create
+(swif_full_symbol_pool_t *pool, uint8_t *symbol_coef_table, uint32_t min_symbol_id,
+ uint32_t nb_symbol_id, uint8_t *symbol_data, uint32_t symbol_size);
+
+/**
+ * @brief Do the data operations of op_tab (in order) on the bytes
+ *        [start, end) of the symbols (and within the `size' of each
+ *        operation), FULL_SYMBOL_TILE_SIZE bytes at a time: each tile of
+ *        a source shared by several operations (the pivot of a
+ *        back-substitution) is read from memory only once.
+ */
+void full_symbol_apply_data_ops
+(full_symbol_data_op_t *op_tab, uint32_t nb_op, uint32_t start, uint32_t end);
+
+/**
+ * @brief Same as full_symbol_apply_data_ops() on the bytes [0, data_size),
+ *        each of the workers (if not NULL) doing its own stripe when the
+ *        symbols are large enough (the result is the same).
+ */
+void full_symbol_run_data_ops
+(swif_workers_t *workers, full_symbol_data_op_t *op_tab, uint32_t nb_op,
+ uint32_t data_size);
+
+/**
+ * @brief Go on with the pending back-substitutions, doing at most `budget'
+ *        row operations (0 means no limit). Returns the number of pivots
+ *        whose back-substitution is still pending.
+ */
+uint32_t full_symbol_set_make_progress
+(swif_full_symbol_set_t *set, uint32_t budget);
+
+/**
+ * @brief Serialization of the state of a set (see full_symbol_set_snapshot)
+ *        in a portable format (little endian integers)
+ */
+#define FULL_SYMBOL_SET_SNAPSHOT_MAGIC   0x46495753ul /* "SWIF" */
+#define FULL_SYMBOL_SET_SNAPSHOT_VERSION 1
+
+static inline uint8_t *snapshot_put_u32(uint8_t *buf, uint32_t value)
+{
+    buf[0] = (uint8_t)value;
+    buf[1] = (uint8_t)(value >> 8);
+    buf[2] = (uint8_t)(value >> 16);
+    buf[3] = (uint8_t)(value >> 24);
+    return buf + 4;
+}
+
+static inline uint32_t snapshot_get_u32(const uint8_t *buf)
+{
+    return (uint32_t)buf[0] | ((uint32_t)buf[1] << 8) | ((uint32_t)buf[2] << 16) |
+           ((uint32_t)buf[3] << 24);
+}
+
+/**
+ * @brief Number of bytes needed by full_symbol_set_snapshot()
+ */
+uint32_t full_symbol_set_get_snapshot_size(swif_full_symbol_set_t *set);
+
+/**
+ * @brief Write the state of the set in buf: the rows (their nonzero
+ *        coefficients and data), the symbol ids removed and the pending
+ *        back-substitutions. Returns the number of bytes written, or 0 if
+ *        size is too small.
+ */
+uint32_t full_symbol_set_snapshot
+(swif_full_symbol_set_t *set, uint8_t *buf, uint32_t size);
+
+/**
+ * @brief Restore a state written by full_symbol_set_snapshot() in an
+ *        empty set (with the same max_symbol_id_span), without any
+ *        elimination. Returns the number of bytes read, or 0 if the
+ *        snapshot is invalid (the set is then left empty).
+ */
+uint32_t full_symbol_set_restore
+(swif_full_symbol_set_t *set, const uint8_t *buf, uint32_t size);
+
 /**
  * @brief Create a full_symbol from a raw packet (a set of bytes)
  *        and initialize it with content '0'
@@ -14,7 +14,11 @@
 #include <stdbool.h>
 
 #include "swif_general.h"
+#include "swif_workers.h"
+#include "swif_speculator.h"
 #include "swif_api.h"
+#include "swif_coefs_cache.h"
+#include "swif_coefs_atlas.h"
 #include "swif_rlc_cb.h"
 #include "swif_linear-code.h"
 #include "swif_prng.h"
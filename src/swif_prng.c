@@ -140,3 +140,67 @@ static uint32_t tinymt32_temper (tinymt32_t * s)
     return t0;
 }
 
+
+/**
+ * Interleaved version of tinymt32_next_state(): the if-branch is replaced
+ * by a mask, so that all the lanes take the same path.
+ */
+static inline void tinymt32_lanes_next_state (tinymt32_lanes_t * s)
+{
+    for (int l = 0; l < TINYMT32_NB_LANES; l++) {
+        uint32_t x;
+        uint32_t y;
+        uint32_t mask;
+
+        y = s->status[3][l];
+        x = (s->status[0][l] & TINYMT32_MASK)
+            ^ s->status[1][l]
+            ^ s->status[2][l];
+        x ^= (x << TINYMT32_SH0);
+        y ^= (y >> TINYMT32_SH0) ^ x;
+        mask = UINT32_C(0) - (y & 1);
+        s->status[0][l] = s->status[1][l];
+        s->status[1][l] = s->status[2][l] ^ (mask & TINYMT32_MAT1_PARAM);
+        s->status[2][l] = x ^ (y << TINYMT32_SH1) ^ (mask & TINYMT32_MAT2_PARAM);
+        s->status[3][l] = y;
+    }
+}
+
+void tinymt32_lanes_init (tinymt32_lanes_t * s,
+                          const uint32_t seed_tab[TINYMT32_NB_LANES])
+{
+    const uint32_t    MIN_LOOP = 8;
+    const uint32_t    PRE_LOOP = 8;
+
+    for (int l = 0; l < TINYMT32_NB_LANES; l++) {
+        s->status[0][l] = seed_tab[l];
+        s->status[1][l] = TINYMT32_MAT1_PARAM;
+        s->status[2][l] = TINYMT32_MAT2_PARAM;
+        s->status[3][l] = TINYMT32_TMAT_PARAM;
+    }
+    for (int i = 1; i < MIN_LOOP; i++) {
+        for (int l = 0; l < TINYMT32_NB_LANES; l++) {
+            s->status[i & 3][l] ^= i + UINT32_C(1812433253)
+                * (s->status[(i - 1) & 3][l]
+                   ^ (s->status[(i - 1) & 3][l] >> 30));
+        }
+    }
+    for (int i = 0; i < PRE_LOOP; i++) {
+        tinymt32_lanes_next_state(s);
+    }
+}
+
+void tinymt32_lanes_generate_uint32 (tinymt32_lanes_t * s,
+                                     uint32_t r_tab[TINYMT32_NB_LANES])
+{
+    tinymt32_lanes_next_state(s);
+    /* tinymt32_temper() */
+    for (int l = 0; l < TINYMT32_NB_LANES; l++) {
+        uint32_t t0, t1;
+        t0 = s->status[3][l];
+        t1 = s->status[0][l] + (s->status[2][l] >> TINYMT32_SH8);
+        t0 ^= t1;
+        t0 ^= (UINT32_C(0) - (t1 & 1)) & TINYMT32_TMAT_PARAM;
+        r_tab[l] = t0;
+    }
+}
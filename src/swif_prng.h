@@ -72,3 +72,38 @@ static inline uint32_t tinymt32_rand256(tinymt32_t *s)
     return (tinymt32_generate_uint32(s) & 0xFF);
 }
 
+
+
+/**
+ * Number of tinymt32 generators run side by side by tinymt32_lanes_t.
+ */
+#define TINYMT32_NB_LANES 8
+
+/**
+ * TINYMT32_NB_LANES tinymt32 internal states, interleaved (word by word)
+ * so that the same step of all of them is done by a loop over the lanes,
+ * that the compiler turns into vector instructions. Each lane produces
+ * exactly the sequence of a tinymt32_t initialized with the same seed.
+ */
+typedef struct {
+    uint32_t status[4][TINYMT32_NB_LANES];
+} tinymt32_lanes_t;
+
+
+/**
+ * This function initializes each lane as tinymt32_init() with its seed.
+ * @param s         pointer to the internal states.
+ * @param seed_tab  TINYMT32_NB_LANES 32-bit unsigned integer seeds.
+ */
+void tinymt32_lanes_init (tinymt32_lanes_t *	s,
+			  const uint32_t	seed_tab[TINYMT32_NB_LANES]);
+
+
+/**
+ * This function outputs the next 32-bit unsigned integer of each lane,
+ * as tinymt32_generate_uint32() does.
+ * @param s         pointer to the internal states.
+ * @param r_tab     (out) TINYMT32_NB_LANES 32-bit unsigned integers.
+ */
+void tinymt32_lanes_generate_uint32 (tinymt32_lanes_t *	s,
+				     uint32_t		r_tab[TINYMT32_NB_LANES]);
@@ -7,49 +7,1639 @@
  * Encoder functions
  */
 
+/* ESI of the first source symbol of the coding window */
+#define RLC_ENCODER_FIRST_ESI(enc) ((enc)->ew_esi_right + 1 - (enc)->ew_ss_nb)
+
+/* CPU time stamp counter, for the statistics (0 where there is none) */
+static inline uint64_t rlc_read_cycles(void)
+{
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+    return __builtin_ia32_rdtsc();
+#elif defined(__GNUC__) && defined(__aarch64__)
+    uint64_t cycles;
+
+    __asm__ __volatile__("mrs %0, cntvct_el0" : "=r"(cycles));
+    return cycles;
+#else
+    return 0;
+#endif
+}
+
+/**
+ * Coding coefficients of a repair key for the coding window starting at
+ * first_esi: those of the atlas if it has them (they must not be
+ * modified), otherwise cc_tab, where they are generated (through the
+ * cache, if any).
+ */
+static const uint8_t *rlc_generate_coding_coefficients(swif_codepoint_t codepoint,
+                                                       swif_coefs_atlas_t *atlas,
+                                                       swif_coefs_cache_t *cache,
+                                                       uint16_t key,
+                                                       esi_t first_esi,
+                                                       uint8_t *cc_tab,
+                                                       uint32_t cc_nb,
+                                                       uint8_t dt)
+{
+    const uint8_t *atlas_cc_tab;
+
+    if(codepoint == SWIF_CODEPOINT_RLC_GF_256_VANDERMONDE_CODEC)
+    {
+        swif_rlc_generate_vandermonde_coefficients(key, first_esi, cc_tab, cc_nb);
+        return cc_tab;
+    }
+    atlas_cc_tab = swif_coefs_atlas_lookup(atlas, key, cc_nb, dt, 8);
+
+    if(atlas_cc_tab != NULL)
+    {
+        return atlas_cc_tab;
+    }
+    swif_coefs_cache_generate_coding_coefficients(cache, key, cc_tab, cc_nb, dt, 8);
+    return cc_tab;
+}
+
+/* data operations per source symbol of a repair symbol: its data, and
+   its length field with variable length source symbols */
+#define RLC_ENCODER_NB_OP_PER_SOURCE(enc) (((enc)->ew_length_tab != NULL) ? 2 : 1)
+
+/**
+ * Bytes of the source symbol at idx in the ring that may not be zero
+ * within the code.
+ */
+static inline uint32_t rlc_encoder_source_size(swif_encoder_rlc_cb_t *enc, uint32_t idx)
+{
+    if(enc->ew_length_tab == NULL)
+    {
+        return enc->symbol_size;
+    }
+    return SWIF_LENGTH_FIELD_SIZE + enc->ew_length_tab[idx];
+}
+
+/**
+ * Bytes of the repair symbols of the coding window that may not be zero:
+ * those of its longest source symbol.
+ */
+static uint32_t rlc_encoder_repair_size(swif_encoder_rlc_cb_t *enc)
+{
+    uint32_t size = SWIF_LENGTH_FIELD_SIZE;
+    uint32_t i;
+
+    if(enc->ew_length_tab == NULL)
+    {
+        return enc->symbol_size;
+    }
+    for(i = 0; i < enc->ew_ss_nb; i++)
+    {
+        size = MAX(size, rlc_encoder_source_size(enc, (enc->ew_left + i) % enc->max_coding_window_size));
+    }
+    return size;
+}
+
+/**
+ * Set the operations adding coef times the source symbol at idx in the
+ * ring to dst (RLC_ENCODER_NB_OP_PER_SOURCE of them): its length field
+ * then its bytes with variable length source symbols, each on its own
+ * size only.
+ */
+static void rlc_encoder_set_source_data_ops(swif_encoder_rlc_cb_t *enc,
+                                            full_symbol_data_op_t *op_tab,
+                                            uint8_t *dst,
+                                            uint32_t idx,
+                                            uint8_t coef)
+{
+    if(enc->ew_length_tab != NULL)
+    {
+        op_tab->dst = dst;
+        op_tab->src1 = dst;
+        op_tab->src2 = enc->ew_length_field_tab + idx * SWIF_LENGTH_FIELD_SIZE;
+        op_tab->coef = coef;
+        op_tab->size = SWIF_LENGTH_FIELD_SIZE;
+        op_tab++;
+        dst += SWIF_LENGTH_FIELD_SIZE;
+    }
+    op_tab->dst = dst;
+    op_tab->src1 = dst;
+    op_tab->src2 = enc->ew_tab[idx];
+    op_tab->coef = coef;
+    op_tab->size = rlc_encoder_source_size(enc, idx) - ((enc->ew_length_tab != NULL)
+                                                        ? SWIF_LENGTH_FIELD_SIZE : 0);
+}
+
+/**
+ * Account for the source bytes of these operations in the statistics
+ */
+static inline void rlc_encoder_count_data_ops(swif_encoder_stats_t *stats,
+                                              const full_symbol_data_op_t *op_tab,
+                                              uint32_t nb_op)
+{
+    uint32_t i;
+
+    for(i = 0; i < nb_op; i++)
+    {
+        if(op_tab[i].coef == 1)
+            stats->nb_bytes_xored += op_tab[i].size;
+        else
+            stats->nb_bytes_multiplied += op_tab[i].size;
+    }
+}
+
+/**
+ * dst += coef * the source symbol at idx in the ring
+ */
+static void rlc_encoder_add_scaled_source_symbol(swif_encoder_rlc_cb_t *enc,
+                                                 void *dst,
+                                                 uint8_t coef,
+                                                 uint32_t idx)
+{
+    full_symbol_data_op_t op_tab[2];
+
+    if(coef == 0)
+    {
+        return;
+    }
+    rlc_encoder_set_source_data_ops(enc, op_tab, dst, idx, coef);
+    rlc_encoder_count_data_ops(&enc->stats, op_tab, RLC_ENCODER_NB_OP_PER_SOURCE(enc));
+    full_symbol_apply_data_ops(op_tab, RLC_ENCODER_NB_OP_PER_SOURCE(enc), 0,
+                               rlc_encoder_source_size(enc, idx));
+}
+
+/**
+ * Get a repair symbol buffer (not initialized) from the pool of the
+ * encoder, allocating a new one if none was given back.
+ */
+static void *rlc_encoder_alloc_repair_buffer(swif_encoder_rlc_cb_t *enc)
+{
+    void *buf;
+
+    if(enc->nb_free_buf > 0)
+    {
+        buf = enc->free_buf_tab[--enc->nb_free_buf];
+    }
+    else if((buf = symbol_alloc_aligned(enc->symbol_size)) == NULL)
+    {
+        return NULL;
+    }
+    enc->nb_buf_in_use++;
+    if(enc->nb_buf_in_use > enc->max_nb_buf_in_use)
+    {
+        enc->max_nb_buf_in_use = enc->nb_buf_in_use;
+    }
+    return buf;
+}
+
+/**
+ * Forget the i-th precommitted repair symbol (its buffer, if still there,
+ * goes back to the pool). The last one takes its place, and its table of
+ * coding coefficients is kept for the next one.
+ */
+static void rlc_encoder_drop_accumulator(swif_encoder_rlc_cb_t *enc, uint32_t i)
+{
+    uint8_t *cc_tab = enc->acc_tab[i].cc_tab;
+
+    assert(i < enc->nb_acc);
+    swif_rlc_encoder_release_repair_buffer((swif_encoder_t *)enc, enc->acc_tab[i].buf);
+    enc->nb_acc--;
+    enc->acc_tab[i] = enc->acc_tab[enc->nb_acc];
+    enc->acc_tab[enc->nb_acc].cc_tab = cc_tab;
+    enc->acc_tab[enc->nb_acc].buf = NULL;
+}
+
+/**
+ * Fold the source symbol just added to the coding window into the
+ * precommitted repair symbols, dropping those that can no longer be built
+ * (the coding window went past their last source symbol).
+ */
+static void rlc_encoder_accumulate_source_symbol(swif_encoder_rlc_cb_t *enc,
+                                                 uint32_t src_symbol_idx,
+                                                 esi_t src_symbol_esi)
+{
+    uint32_t i = 0;
+
+    while(i < enc->nb_acc)
+    {
+        swif_rlc_repair_accumulator_t *acc = &enc->acc_tab[i];
+
+        if(src_symbol_esi > acc->last_esi)
+        {
+            rlc_encoder_drop_accumulator(enc, i);
+            continue;
+        }
+        if(src_symbol_esi >= acc->first_esi)
+        {
+            rlc_encoder_add_scaled_source_symbol(enc, acc->buf,
+                                                 acc->cc_tab[src_symbol_esi - acc->first_esi],
+                                                 src_symbol_idx);
+        }
+        i++;
+    }
+}
+
+/**
+ * Return the index of the precommitted repair symbol of this key and
+ * density for the current coding window, or nb_acc if there is none.
+ */
+static uint32_t rlc_encoder_find_accumulator(swif_encoder_rlc_cb_t *enc, uint32_t key, uint8_t dt)
+{
+    uint32_t i;
+
+    if(enc->ew_ss_nb == 0)
+    {
+        return enc->nb_acc;
+    }
+    for(i = 0; i < enc->nb_acc; i++)
+    {
+        swif_rlc_repair_accumulator_t *acc = &enc->acc_tab[i];
+
+        if(acc->key == key && acc->dt == dt
+           && acc->last_esi == enc->ew_esi_right
+           && acc->first_esi == enc->ew_esi_right + 1 - enc->ew_ss_nb)
+        {
+            break;
+        }
+    }
+    return i;
+}
+
+/**
+ * Hand the i-th precommitted repair symbol over to the application, as
+ * swif_rlc_build_repair_symbol() would for new_buf, and forget it.
+ */
+static void rlc_encoder_take_accumulator(swif_encoder_rlc_cb_t *enc, uint32_t i, void **new_buf)
+{
+    if(*new_buf == 0)
+    {
+        *new_buf = enc->acc_tab[i].buf;
+        enc->acc_tab[i].buf = NULL;
+    }
+    else
+    {
+        memcpy(*new_buf, enc->acc_tab[i].buf, enc->repair_size);
+    }
+    rlc_encoder_drop_accumulator(enc, i);
+}
+
+/**
+ * Add (or remove, the same in GF(2^8)) a source symbol of the coding
+ * window to the standing repair symbols.
+ */
+static void rlc_encoder_update_standing_repairs(swif_encoder_rlc_cb_t *enc,
+                                                uint32_t src_symbol_idx,
+                                                esi_t src_symbol_esi)
+{
+    uint8_t coef;
+    uint32_t i;
+
+    for(i = 0; i < enc->nb_standing; i++)
+    {
+        swif_rlc_generate_vandermonde_coefficients((uint16_t)enc->standing_tab[i].key,
+                                                   src_symbol_esi, &coef, 1);
+        rlc_encoder_add_scaled_source_symbol(enc, enc->standing_tab[i].buf, coef, src_symbol_idx);
+    }
+}
+
+/**
+ * The oldest source symbol leaves the coding window (which must not be
+ * empty): it is removed from the standing repair symbols, the precommitted
+ * repair symbols whose coding window started with it are dropped, and
+ * the application is told.
+ */
+static void rlc_encoder_remove_oldest_source_symbol(swif_encoder_rlc_cb_t *enc)
+{
+    esi_t old_esi = RLC_ENCODER_FIRST_ESI(enc);
+    uint32_t i = 0;
+
+    assert(enc->ew_ss_nb > 0);
+    if(enc->nb_standing > 0)
+    {
+        rlc_encoder_update_standing_repairs(enc, enc->ew_left, old_esi);
+    }
+    while(i < enc->nb_acc)
+    {
+        if(enc->acc_tab[i].first_esi <= old_esi)
+        {
+            rlc_encoder_drop_accumulator(enc, i);
+            continue;
+        }
+        i++;
+    }
+    enc->ew_ss_nb--;
+    if(enc->ew_ss_nb == 0)
+    {
+        enc->ew_right = enc->ew_left;
+    }
+    else
+    {
+        enc->ew_left = (enc->ew_left + 1) % enc->max_coding_window_size;
+    }
+    if(enc->source_symbol_removed_from_coding_window_callback != NULL)
+    {
+        enc->source_symbol_removed_from_coding_window_callback(enc->context_4_callback, old_esi);
+    }
+}
+
+/**
+ * Return the index of the standing repair symbol of this key, or
+ * nb_standing if there is none.
+ */
+static uint32_t rlc_encoder_find_standing_repair(swif_encoder_rlc_cb_t *enc, uint32_t key)
+{
+    uint32_t i;
+
+    for(i = 0; i < enc->nb_standing; i++)
+    {
+        /* the coefficients only depend on the 16-bit key */
+        if((uint16_t)enc->standing_tab[i].key == (uint16_t)key)
+        {
+            break;
+        }
+    }
+    return i;
+}
+
+/**
+ * Replace the standing repair symbols by those of these keys, computed
+ * from the source symbols already in the coding window.
+ */
+static swif_status_t rlc_encoder_set_standing_repair_keys(swif_encoder_rlc_cb_t *enc,
+                                                          const uint32_t *key_tab,
+                                                          uint32_t nb_key)
+{
+    swif_rlc_standing_repair_t *new_tab = NULL;
+    uint32_t i, k;
+
+    if(nb_key > 0 && enc->generic_encoder.codepoint != SWIF_CODEPOINT_RLC_GF_256_VANDERMONDE_CODEC)
+    {
+        fprintf(stderr, "swif_rlc_encoder_set_parameters: standing repair symbols need "
+                        "SWIF_CODEPOINT_RLC_GF_256_VANDERMONDE_CODEC\n");
+        return SWIF_STATUS_ERROR;
+    }
+    if(nb_key > 0 && (new_tab = calloc(nb_key, sizeof(swif_rlc_standing_repair_t))) == NULL)
+    {
+        fprintf(stderr, "swif_rlc_encoder_set_parameters: no memory\n");
+        return SWIF_STATUS_ERROR;
+    }
+    for(k = 0; k < nb_key; k++)
+    {
+        new_tab[k].key = key_tab[k];
+        if((new_tab[k].buf = symbol_alloc_aligned(enc->symbol_size)) == NULL)
+        {
+            fprintf(stderr, "swif_rlc_encoder_set_parameters: no memory\n");
+            while(k-- > 0)
+                free(new_tab[k].buf);
+            free(new_tab);
+            return SWIF_STATUS_ERROR;
+        }
+        memset(new_tab[k].buf, 0, enc->symbol_size);
+    }
+    for(i = 0; i < enc->nb_standing; i++)
+    {
+        free(enc->standing_tab[i].buf);
+    }
+    free(enc->standing_tab);
+    enc->standing_tab = new_tab;
+    enc->nb_standing = nb_key;
+
+    /* source symbols already there */
+    for(i = 0; i < enc->ew_ss_nb; i++)
+    {
+        rlc_encoder_update_standing_repairs(enc, (enc->ew_left + i) % enc->max_coding_window_size,
+                                            RLC_ENCODER_FIRST_ESI(enc) + i);
+    }
+    return SWIF_STATUS_OK;
+}
+
+/**
+ * Make room for the operations and coefficients of nb_repair repair
+ * symbols built together.
+ */
+static bool rlc_encoder_reserve_repair_data_ops(swif_encoder_rlc_cb_t *enc, uint32_t nb_repair)
+{
+    full_symbol_data_op_t *new_data_op_tab;
+    uint8_t *new_cc_tab;
+
+    if(nb_repair <= enc->nb_repair_data_op)
+    {
+        return true;
+    }
+    /* up to RLC_ENCODER_NB_OP_PER_SOURCE operations per source symbol of
+       each repair symbol, then the destination of each repair symbol */
+    new_data_op_tab = realloc(enc->data_op_tab,
+                              (size_t)nb_repair
+                                  * (RLC_ENCODER_NB_OP_PER_SOURCE(enc) * enc->max_coding_window_size + 1)
+                                  * sizeof(full_symbol_data_op_t));
+    if(new_data_op_tab == NULL)
+    {
+        return false;
+    }
+    enc->data_op_tab = new_data_op_tab;
+    new_cc_tab = realloc(enc->batch_cc_tab, (size_t)nb_repair * enc->max_coding_window_size);
+    if(new_cc_tab == NULL)
+    {
+        return false;
+    }
+    enc->batch_cc_tab = new_cc_tab;
+    enc->nb_repair_data_op = nb_repair;
+    return true;
+}
+
+/**
+ * Helper thread: build the speculative repair symbols of the current job,
+ * in order, for the coding window they were started with. A tile of all
+ * the source symbols at a time, so that a change of the coding window
+ * does not wait long.
+ */
+static void rlc_encoder_speculate(swif_speculator_t *spec, void *context)
+{
+    swif_encoder_rlc_cb_t *enc = (swif_encoder_rlc_cb_t *)context;
+    uint32_t repair_size = rlc_encoder_repair_size(enc);
+    const uint8_t *cc_tab;
+    uint32_t s, i, tile, nb_op;
+    uint64_t start;
+
+    for(s = 0; s < enc->nb_spec; s++)
+    {
+        swif_rlc_speculative_repair_t *sr = &enc->spec_tab[s];
+
+        start = rlc_read_cycles();
+        cc_tab = rlc_generate_coding_coefficients(enc->generic_encoder.codepoint, enc->coefs_atlas,
+                                                  enc->coefs_cache, (uint16_t)sr->key,
+                                                  enc->spec_first_esi, enc->spec_cc_tab,
+                                                  enc->spec_ss_nb, sr->dt);
+        sr->stats.coefs_cycles = rlc_read_cycles() - start;
+        start = rlc_read_cycles();
+        nb_op = 0;
+        for(i = 0; i < enc->spec_ss_nb; i++)
+        {
+            if(cc_tab[i] == 0)
+            {
+                continue;
+            }
+            rlc_encoder_set_source_data_ops(enc, &enc->spec_op_tab[nb_op], sr->buf,
+                                            (enc->spec_ew_left + i) % enc->max_coding_window_size,
+                                            cc_tab[i]);
+            nb_op += RLC_ENCODER_NB_OP_PER_SOURCE(enc);
+        }
+        memset(sr->buf, 0, repair_size);
+        for(tile = 0; tile < repair_size; tile += FULL_SYMBOL_TILE_SIZE)
+        {
+            if(swif_speculator_is_cancelled(spec))
+            {
+                sr->stats.build_cycles = rlc_read_cycles() - start;
+                return;
+            }
+            full_symbol_apply_data_ops(enc->spec_op_tab, nb_op, tile,
+                                       MIN(tile + FULL_SYMBOL_TILE_SIZE, repair_size));
+        }
+        rlc_encoder_count_data_ops(&sr->stats, enc->spec_op_tab, nb_op);
+        sr->stats.build_cycles = rlc_read_cycles() - start;
+        swif_speculator_step_done(spec);
+    }
+}
+
+/**
+ * Add the work of the helper thread on this speculative repair symbol to
+ * the statistics of the encoder, once handed over or cancelled (the helper
+ * no longer writes it then).
+ */
+static void rlc_encoder_count_speculative_repair(swif_encoder_rlc_cb_t *enc,
+                                                 swif_rlc_speculative_repair_t *sr)
+{
+    enc->stats.nb_bytes_xored += sr->stats.nb_bytes_xored;
+    enc->stats.nb_bytes_multiplied += sr->stats.nb_bytes_multiplied;
+    enc->stats.coefs_cycles += sr->stats.coefs_cycles;
+    enc->stats.build_cycles += sr->stats.build_cycles;
+    memset(&sr->stats, 0, sizeof(sr->stats));
+}
+
+/**
+ * Stop the speculative repair symbols being built (before the coding
+ * window changes), and give their buffers back to the pool. Those not
+ * handed over were built for nothing.
+ */
+static void rlc_encoder_cancel_speculation(swif_encoder_rlc_cb_t *enc)
+{
+    uint32_t nb_done;
+    uint32_t i;
+
+    if(enc->nb_spec == 0)
+    {
+        return;
+    }
+    nb_done = swif_speculator_cancel(enc->speculator);
+    for(i = 0; i < enc->nb_spec; i++)
+    {
+        if(!enc->spec_tab[i].taken)
+        {
+            enc->spec_stats.nb_wasted++;
+            if(i >= nb_done)
+                enc->spec_stats.nb_aborted++;
+        }
+        rlc_encoder_count_speculative_repair(enc, &enc->spec_tab[i]);
+        swif_rlc_encoder_release_repair_buffer((swif_encoder_t *)enc, enc->spec_tab[i].buf);
+    }
+    enc->nb_spec = 0;
+}
+
+/**
+ * The coding window changed: start building the repair symbols of the
+ * keys expected next (none is built twice: standing repair symbols are
+ * already there).
+ */
+static void rlc_encoder_start_speculation(swif_encoder_rlc_cb_t *enc)
+{
+    uint32_t key;
+    uint32_t k;
+
+    assert(enc->nb_spec == 0);
+    if(enc->speculator == NULL || !enc->spec_has_key || enc->ew_ss_nb == 0)
+    {
+        return;
+    }
+    for(k = 0; k < enc->nb_spec_max; k++)
+    {
+        swif_rlc_speculative_repair_t *sr = &enc->spec_tab[enc->nb_spec];
+
+        key = enc->spec_next_key + k;
+        if(rlc_encoder_find_standing_repair(enc, key) < enc->nb_standing)
+        {
+            continue;
+        }
+        if((sr->buf = rlc_encoder_alloc_repair_buffer(enc)) == NULL)
+        {
+            break;
+        }
+        sr->key = key;
+        sr->dt = enc->spec_dt;
+        sr->taken = false;
+        memset(&sr->stats, 0, sizeof(sr->stats));
+        enc->nb_spec++;
+    }
+    if(enc->nb_spec == 0)
+    {
+        return;
+    }
+    enc->spec_stats.nb_speculations += enc->nb_spec;
+    enc->spec_first_esi = RLC_ENCODER_FIRST_ESI(enc);
+    enc->spec_ew_left = enc->ew_left;
+    enc->spec_ss_nb = enc->ew_ss_nb;
+    swif_speculator_start(enc->speculator);
+}
+
+/**
+ * Hand the speculative repair symbol of this key and density over to the
+ * application, as swif_rlc_build_repair_symbol() would for new_buf, once
+ * built. Returns false (a miss) if it was not expected.
+ */
+static bool rlc_encoder_take_speculative_repair(swif_encoder_rlc_cb_t *enc,
+                                                uint32_t key,
+                                                uint8_t dt,
+                                                void **new_buf)
+{
+    swif_rlc_speculative_repair_t *sr = NULL;
+    uint32_t i;
+
+    for(i = 0; i < enc->nb_spec; i++)
+    {
+        sr = &enc->spec_tab[i];
+        if(sr->key == key && sr->dt == dt && !sr->taken)
+        {
+            break;
+        }
+    }
+    /* the steps are the repair symbols, in order */
+    if(i == enc->nb_spec || swif_speculator_wait(enc->speculator, i + 1) <= i)
+    {
+        enc->spec_stats.nb_misses++;
+        return false;
+    }
+    if(*new_buf == 0)
+    {
+        *new_buf = sr->buf;
+        sr->buf = NULL;
+    }
+    else
+    {
+        memcpy(*new_buf, sr->buf, enc->repair_size);
+    }
+    sr->taken = true;
+    rlc_encoder_count_speculative_repair(enc, sr);
+    enc->spec_stats.nb_hits++;
+    return true;
+}
+
+/**
+ * Build nb_spec_max repair symbols ahead of time (none if 0), with the
+ * helper thread started on the first use.
+ */
+static swif_status_t rlc_encoder_set_speculative_repairs(swif_encoder_rlc_cb_t *enc,
+                                                         uint32_t nb_spec_max)
+{
+    swif_rlc_speculative_repair_t *new_tab;
+
+    rlc_encoder_cancel_speculation(enc);
+    if(nb_spec_max == 0)
+    {
+        swif_speculator_free(enc->speculator);
+        enc->speculator = NULL;
+        free(enc->spec_tab);
+        free(enc->spec_cc_tab);
+        free(enc->spec_op_tab);
+        enc->spec_tab = NULL;
+        enc->spec_cc_tab = NULL;
+        enc->spec_op_tab = NULL;
+        enc->nb_spec_max = 0;
+        return SWIF_STATUS_OK;
+    }
+    if(enc->spec_cc_tab == NULL)
+    {
+        enc->spec_cc_tab = malloc(enc->max_coding_window_size);
+        enc->spec_op_tab = calloc(2 * enc->max_coding_window_size, sizeof(full_symbol_data_op_t));
+    }
+    new_tab = realloc(enc->spec_tab, nb_spec_max * sizeof(swif_rlc_speculative_repair_t));
+    if(new_tab == NULL || enc->spec_cc_tab == NULL || enc->spec_op_tab == NULL)
+    {
+        fprintf(stderr, "swif_rlc_encoder_set_parameters: no memory\n");
+        if(new_tab != NULL)
+            enc->spec_tab = new_tab;
+        rlc_encoder_set_speculative_repairs(enc, 0);
+        return SWIF_STATUS_ERROR;
+    }
+    enc->spec_tab = new_tab;
+    if(enc->speculator == NULL
+       && (enc->speculator = swif_speculator_create(rlc_encoder_speculate, enc)) == NULL)
+    {
+        fprintf(stderr, "swif_rlc_encoder_set_parameters: cannot start the speculation thread\n");
+        rlc_encoder_set_speculative_repairs(enc, 0);
+        return SWIF_STATUS_ERROR;
+    }
+    enc->nb_spec_max = nb_spec_max;
+    return SWIF_STATUS_OK;
+}
+
+/**
+ * Release an encoder and its associated ressources.
+ **/
+swif_status_t swif_rlc_encoder_release(swif_encoder_t *enc)
+{
+    assert(enc);
+    swif_encoder_rlc_cb_t *rlc_enc = (swif_encoder_rlc_cb_t *)enc;
+    rlc_encoder_set_speculative_repairs(rlc_enc, 0);
+    while(rlc_enc->nb_acc > 0)
+        rlc_encoder_drop_accumulator(rlc_enc, rlc_enc->nb_acc - 1);
+    while(rlc_enc->acc_capacity > 0)
+        free(rlc_enc->acc_tab[--rlc_enc->acc_capacity].cc_tab);
+    free(rlc_enc->acc_tab);
+    rlc_encoder_set_standing_repair_keys(rlc_enc, NULL, 0);
+    while(rlc_enc->nb_free_buf > 0)
+        free(rlc_enc->free_buf_tab[--rlc_enc->nb_free_buf]);
+    free(rlc_enc->free_buf_tab);
+    if(rlc_enc->cc_tab)
+        free(rlc_enc->cc_tab);
+    if(rlc_enc->ew_tab)
+        free(rlc_enc->ew_tab);
+    free(rlc_enc->data_op_tab);
+    free(rlc_enc->batch_cc_tab);
+    free(rlc_enc->ew_data);
+    free(rlc_enc->ew_length_tab);
+    free(rlc_enc->ew_length_field_tab);
+    swif_workers_free(rlc_enc->workers);
+    free(enc);
+    return SWIF_STATUS_OK;
+}
+
+/**
+ * Set the various callback functions for this encoder.
+ * All the callback functions require an opaque context parameter, that must be
+ * initialized accordingly by the application, since it is application specific.
+ */
+swif_status_t swif_rlc_encoder_set_callback_functions(
+    swif_encoder_t *enc,
+    void (*source_symbol_removed_from_coding_window_callback)(void *context, esi_t old_symbol_esi),
+    void *context_4_callback)
+{
+    swif_encoder_rlc_cb_t *rlc_enc = (swif_encoder_rlc_cb_t *)enc;
+
+    assert(enc);
+    rlc_enc->source_symbol_removed_from_coding_window_callback =
+        source_symbol_removed_from_coding_window_callback;
+    rlc_enc->context_4_callback = context_4_callback;
+    return SWIF_STATUS_OK;
+}
+
+/**
+ * Switch to (or back from) source symbols copied into a ring owned by the
+ * encoder. The coding window must be empty.
+ */
+static swif_status_t rlc_encoder_set_copy_source_symbols(swif_encoder_rlc_cb_t *enc, bool enable)
+{
+    uint32_t stride = (enc->symbol_size + SYMBOL_ALIGN - 1) & ~(uint32_t)(SYMBOL_ALIGN - 1);
+    uint8_t *ew_data = NULL;
+    uint32_t i;
+
+    if(enc->ew_ss_nb > 0)
+    {
+        fprintf(stderr, "swif_rlc_encoder_set_parameters: copy of source symbols must be set "
+                        "with an empty coding window\n");
+        return SWIF_STATUS_ERROR;
+    }
+    if(enable && enc->ew_data == NULL)
+    {
+        if(stride == 0 || (uint64_t)stride * enc->max_coding_window_size > UINT32_MAX
+           || (ew_data = symbol_alloc_aligned(stride * enc->max_coding_window_size)) == NULL)
+        {
+            fprintf(stderr, "swif_rlc_encoder_set_parameters: cannot allocate the source "
+                            "symbol ring (%u x %u bytes)\n", enc->max_coding_window_size, stride);
+            return SWIF_STATUS_ERROR;
+        }
+        for(i = 0; i < enc->max_coding_window_size; i++)
+        {
+            enc->ew_tab[i] = ew_data + (size_t)i * stride;
+        }
+        enc->ew_data = ew_data;
+        enc->ew_data_stride = stride;
+    }
+    else if(!enable && enc->ew_data != NULL)
+    {
+        free(enc->ew_data);
+        enc->ew_data = NULL;
+        enc->ew_data_stride = 0;
+    }
+    return SWIF_STATUS_OK;
+}
+
+/**
+ * Switch to (or back from) variable length source symbols. The coding
+ * window must be empty.
+ */
+static swif_status_t rlc_encoder_set_variable_length_source_symbols(swif_encoder_rlc_cb_t *enc,
+                                                                    bool enable)
+{
+    uint32_t nb_repair = enc->nb_repair_data_op;
+
+    if(enc->ew_ss_nb > 0)
+    {
+        fprintf(stderr, "swif_rlc_encoder_set_parameters: variable length source symbols must "
+                        "be set with an empty coding window\n");
+        return SWIF_STATUS_ERROR;
+    }
+    if(enable == (enc->ew_length_tab != NULL))
+    {
+        return SWIF_STATUS_OK;
+    }
+    if(enable)
+    {
+        if(enc->symbol_size <= SWIF_LENGTH_FIELD_SIZE
+           || enc->symbol_size > SWIF_LENGTH_FIELD_SIZE + UINT16_MAX)
+        {
+            fprintf(stderr, "swif_rlc_encoder_set_parameters: symbol_size %u does not allow "
+                            "variable length source symbols\n", enc->symbol_size);
+            return SWIF_STATUS_ERROR;
+        }
+        enc->ew_length_tab = calloc(enc->max_coding_window_size, sizeof(uint16_t));
+        enc->ew_length_field_tab = calloc(enc->max_coding_window_size, SWIF_LENGTH_FIELD_SIZE);
+        if(enc->ew_length_tab == NULL || enc->ew_length_field_tab == NULL)
+        {
+            fprintf(stderr, "swif_rlc_encoder_set_parameters: no memory\n");
+            enable = false;
+        }
+    }
+    if(!enable)
+    {
+        free(enc->ew_length_tab);
+        free(enc->ew_length_field_tab);
+        enc->ew_length_tab = NULL;
+        enc->ew_length_field_tab = NULL;
+    }
+    /* the number of operations per repair symbol changed */
+    enc->nb_repair_data_op = 0;
+    if(!rlc_encoder_reserve_repair_data_ops(enc, nb_repair))
+    {
+        fprintf(stderr, "swif_rlc_encoder_set_parameters: no memory\n");
+        return SWIF_STATUS_ERROR;
+    }
+    enc->repair_size = enc->symbol_size;
+    return (enable == (enc->ew_length_tab != NULL)) ? SWIF_STATUS_OK : SWIF_STATUS_ERROR;
+}
+
+/**
+ * This function sets one or more FEC codec specific parameters,
+ * using a type/length/value approach for maximum flexibility.
+ */
+swif_status_t
+swif_rlc_encoder_set_parameters(swif_encoder_t *enc, uint32_t type, uint32_t length, void *value)
+{
+    swif_encoder_rlc_cb_t *rlc_enc = (swif_encoder_rlc_cb_t *)enc;
+    swif_workers_t *workers = NULL;
+
+    switch(type)
+    {
+    case swif_ENCODER_SET_PARAM_NB_THREADS:
+        if(value == NULL || length != sizeof(uint32_t) || *(uint32_t *)value == 0)
+        {
+            fprintf(stderr, "swif_rlc_encoder_set_parameters: bad number of threads "
+                            "(length %u)\n", length);
+            return SWIF_STATUS_ERROR;
+        }
+        if(*(uint32_t *)value > 1 && (workers = swif_workers_create(*(uint32_t *)value)) == NULL)
+        {
+            fprintf(stderr, "swif_rlc_encoder_set_parameters: cannot start %u threads\n",
+                    *(uint32_t *)value);
+            return SWIF_STATUS_ERROR;
+        }
+        swif_workers_free(rlc_enc->workers);
+        rlc_enc->workers = workers;
+        return SWIF_STATUS_OK;
+
+    case swif_ENCODER_SET_PARAM_COPY_SOURCE_SYMBOLS:
+        if(value == NULL || length != sizeof(uint32_t))
+        {
+            fprintf(stderr, "swif_rlc_encoder_set_parameters: bad copy source symbols value "
+                            "(length %u)\n", length);
+            return SWIF_STATUS_ERROR;
+        }
+        return rlc_encoder_set_copy_source_symbols(rlc_enc, *(uint32_t *)value != 0);
+
+    case swif_ENCODER_SET_PARAM_COEFS_CACHE:
+        if(value == NULL || length != sizeof(swif_coefs_cache_t *))
+        {
+            fprintf(stderr, "swif_rlc_encoder_set_parameters: bad coefficients cache value "
+                            "(length %u)\n", length);
+            return SWIF_STATUS_ERROR;
+        }
+        rlc_encoder_cancel_speculation(rlc_enc);
+        rlc_enc->coefs_cache = *(swif_coefs_cache_t **)value;
+        return SWIF_STATUS_OK;
+
+    case swif_ENCODER_SET_PARAM_COEFS_ATLAS:
+        if(value == NULL || length != sizeof(swif_coefs_atlas_t *))
+        {
+            fprintf(stderr, "swif_rlc_encoder_set_parameters: bad coefficient atlas value "
+                            "(length %u)\n", length);
+            return SWIF_STATUS_ERROR;
+        }
+        rlc_encoder_cancel_speculation(rlc_enc);
+        rlc_enc->coefs_atlas = *(swif_coefs_atlas_t **)value;
+        rlc_enc->cc_atlas_tab = NULL;
+        rlc_enc->cc_is_generated = false;
+        return SWIF_STATUS_OK;
+
+    case swif_ENCODER_SET_PARAM_STANDING_REPAIR_KEYS:
+        if((value == NULL && length != 0) || length % sizeof(uint32_t) != 0)
+        {
+            fprintf(stderr, "swif_rlc_encoder_set_parameters: bad standing repair keys "
+                            "(length %u)\n", length);
+            return SWIF_STATUS_ERROR;
+        }
+        return rlc_encoder_set_standing_repair_keys(rlc_enc, (const uint32_t *)value,
+                                                    length / sizeof(uint32_t));
+
+    case swif_ENCODER_SET_PARAM_SPECULATIVE_REPAIRS:
+        if(value == NULL || length != sizeof(uint32_t))
+        {
+            fprintf(stderr, "swif_rlc_encoder_set_parameters: bad number of speculative repair "
+                            "symbols (length %u)\n", length);
+            return SWIF_STATUS_ERROR;
+        }
+        return rlc_encoder_set_speculative_repairs(rlc_enc, *(uint32_t *)value);
+
+    case swif_ENCODER_SET_PARAM_VARIABLE_LENGTH_SOURCE_SYMBOLS:
+        if(value == NULL || length != sizeof(uint32_t))
+        {
+            fprintf(stderr, "swif_rlc_encoder_set_parameters: bad variable length source "
+                            "symbols value (length %u)\n", length);
+            return SWIF_STATUS_ERROR;
+        }
+        return rlc_encoder_set_variable_length_source_symbols(rlc_enc, *(uint32_t *)value != 0);
+
+    default:
+        // NOT YET
+        return SWIF_STATUS_OK;
+    }
+}
+
+/**
+ * This function gets one or more FEC codec specific parameters,
+ * using a type/length/value approach for maximum flexibility.
+ */
+swif_status_t
+swif_rlc_encoder_get_parameters(swif_encoder_t *enc, uint32_t type, uint32_t length, void *value)
+{
+    swif_encoder_rlc_cb_t *rlc_enc = (swif_encoder_rlc_cb_t *)enc;
+
+    switch(type)
+    {
+    case swif_ENCODER_GET_PARAM_REPAIR_BUFFER_POOL_SIZE:
+    case swif_ENCODER_GET_PARAM_REPAIR_BUFFER_HIGH_WATER_MARK:
+        if(value == NULL || length != sizeof(uint32_t))
+        {
+            fprintf(stderr, "swif_rlc_encoder_get_parameters: bad repair buffer pool value "
+                            "(length %u)\n", length);
+            return SWIF_STATUS_ERROR;
+        }
+        if(type == swif_ENCODER_GET_PARAM_REPAIR_BUFFER_POOL_SIZE)
+            *(uint32_t *)value = rlc_enc->nb_buf_in_use + rlc_enc->nb_free_buf;
+        else
+            *(uint32_t *)value = rlc_enc->max_nb_buf_in_use;
+        return SWIF_STATUS_OK;
+
+    case swif_ENCODER_GET_PARAM_SPECULATION_STATISTICS:
+        if(value == NULL || length != sizeof(swif_encoder_speculation_stats_t))
+        {
+            fprintf(stderr, "swif_rlc_encoder_get_parameters: bad speculation statistics value "
+                            "(length %u)\n", length);
+            return SWIF_STATUS_ERROR;
+        }
+        *(swif_encoder_speculation_stats_t *)value = rlc_enc->spec_stats;
+        return SWIF_STATUS_OK;
+
+    case swif_ENCODER_GET_PARAM_REPAIR_SYMBOL_SIZE:
+        if(value == NULL || length != sizeof(uint32_t))
+        {
+            fprintf(stderr, "swif_rlc_encoder_get_parameters: bad repair symbol size value "
+                            "(length %u)\n", length);
+            return SWIF_STATUS_ERROR;
+        }
+        *(uint32_t *)value = rlc_enc->repair_size;
+        return SWIF_STATUS_OK;
+
+    case swif_ENCODER_GET_PARAM_ENCODER_STATISTICS:
+        if(value == NULL || length != sizeof(swif_encoder_stats_t))
+        {
+            fprintf(stderr, "swif_rlc_encoder_get_parameters: bad encoder statistics value "
+                            "(length %u)\n", length);
+            return SWIF_STATUS_ERROR;
+        }
+        rlc_enc->stats.nb_repair_buffers = rlc_enc->nb_buf_in_use + rlc_enc->nb_free_buf;
+        rlc_enc->stats.max_nb_repair_buffers_in_use = rlc_enc->max_nb_buf_in_use;
+        *(swif_encoder_stats_t *)value = rlc_enc->stats;
+        return SWIF_STATUS_OK;
+
+    default:
+        // NOT YET
+        return SWIF_STATUS_OK;
+    }
+}
+
+/**
+ * Give back a repair symbol buffer allocated by the encoder: it is kept
+ * for the next repair symbols.
+ */
+swif_status_t swif_rlc_encoder_release_repair_buffer(swif_encoder_t *generic_encoder, void *buf)
+{
+    swif_encoder_rlc_cb_t *enc = (swif_encoder_rlc_cb_t *)generic_encoder;
+
+    if(buf == NULL)
+    {
+        return SWIF_STATUS_OK;
+    }
+    if(enc->nb_free_buf == enc->free_buf_capacity)
+    {
+        uint32_t new_capacity = (enc->free_buf_capacity == 0) ? 4 : 2 * enc->free_buf_capacity;
+        void **new_tab = realloc(enc->free_buf_tab, new_capacity * sizeof(void *));
+
+        if(new_tab == NULL)
+        {
+            /* not kept */
+            free(buf);
+            if(enc->nb_buf_in_use > 0)
+                enc->nb_buf_in_use--;
+            return SWIF_STATUS_OK;
+        }
+        enc->free_buf_tab = new_tab;
+        enc->free_buf_capacity = new_capacity;
+    }
+    enc->free_buf_tab[enc->nb_free_buf++] = buf;
+    if(enc->nb_buf_in_use > 0)
+        enc->nb_buf_in_use--;
+    return SWIF_STATUS_OK;
+}
+
+/**
+ * Create a single repair symbol (i.e. perform an encoding).
+ */
+static swif_status_t rlc_encoder_build_repair_symbol(swif_encoder_rlc_cb_t *enc, void **new_buf)
+{
+    const uint8_t *cc_tab = (enc->cc_atlas_tab != NULL) ? enc->cc_atlas_tab : enc->cc_tab;
+    uint32_t nb_op;
+    uint32_t i;
+
+    enc->repair_size = rlc_encoder_repair_size(enc);
+    if(enc->cc_is_generated)
+    {
+        enc->spec_has_key = true;
+        enc->spec_next_key = enc->cc_key + 1;
+        enc->spec_dt = enc->cc_dt;
+    }
+    /* precommitted repair symbol: it is already there */
+    if(enc->cc_is_generated
+       && (i = rlc_encoder_find_accumulator(enc, enc->cc_key, enc->cc_dt)) < enc->nb_acc)
+    {
+        rlc_encoder_take_accumulator(enc, i, new_buf);
+        return SWIF_STATUS_OK;
+    }
+    /* speculative repair symbol: built (or being built) in the background */
+    if(enc->cc_is_generated && enc->speculator != NULL
+       && rlc_encoder_take_speculative_repair(enc, enc->cc_key, enc->cc_dt, new_buf))
+    {
+        return SWIF_STATUS_OK;
+    }
+
+    if(*new_buf == 0 && (*new_buf = rlc_encoder_alloc_repair_buffer(enc)) == NULL)
+    {
+        fprintf(stderr, "swif_rlc_build_repair_symbol failed! No memory\n");
+        return SWIF_STATUS_ERROR;
+    }
+    /* standing repair symbol: it is up to date */
+    if(enc->cc_is_generated
+       && (i = rlc_encoder_find_standing_repair(enc, enc->cc_key)) < enc->nb_standing)
+    {
+        memcpy(*new_buf, enc->standing_tab[i].buf, enc->repair_size);
+        return SWIF_STATUS_OK;
+    }
+    memset(*new_buf, 0, enc->repair_size);
+
+    DEBUG_PRINT("\nbuild-repair: \n");
+    /* cc_tab[i] is the coefficient of the i-th source symbol of the window,
+       which starts at ew_left in the ring. Null coefficients get no
+       operation (those equal to 1 are a XOR, see full_symbol_apply_data_ops()).
+       The combination is done by tiles of the repair symbol (by stripes of
+       them with several threads) */
+    nb_op = 0;
+    for(i = 0; i < enc->ew_ss_nb; i++)
+    {
+        uint32_t idx = (enc->ew_left + i) % enc->max_coding_window_size;
+        DEBUG_PRINT(" +%u.P[%u->%u]", cc_tab[i], i, idx);
+        if(cc_tab[i] == 0)
+        {
+            continue;
+        }
+        rlc_encoder_set_source_data_ops(enc, &enc->data_op_tab[nb_op], *new_buf, idx, cc_tab[i]);
+        nb_op += RLC_ENCODER_NB_OP_PER_SOURCE(enc);
+    }
+    DEBUG_PRINT("\n");
+    rlc_encoder_count_data_ops(&enc->stats, enc->data_op_tab, nb_op);
+    full_symbol_run_data_ops(enc->workers, enc->data_op_tab, nb_op, enc->repair_size);
+    return SWIF_STATUS_OK;
+}
+
+swif_status_t swif_rlc_build_repair_symbol(swif_encoder_t *generic_encoder, void **new_buf)
+{
+    swif_encoder_rlc_cb_t *enc = (swif_encoder_rlc_cb_t *)generic_encoder;
+    uint64_t start = rlc_read_cycles();
+    swif_status_t status = rlc_encoder_build_repair_symbol(enc, new_buf);
+
+    if(status == SWIF_STATUS_OK)
+    {
+        enc->stats.nb_repair_symbols++;
+    }
+    enc->stats.build_cycles += rlc_read_cycles() - start;
+    return status;
+}
+
 /**
- * Release an encoder and its associated ressources.
+ * Create several repair symbols at once. The operations are ordered by
+ * source symbol, so that a tile of a source symbol is read once for all
+ * of the repair symbols. As for one repair symbol, null coefficients get
+ * no operation.
+ */
+static swif_status_t rlc_encoder_build_repair_symbols(swif_encoder_rlc_cb_t *enc,
+                                                      uint32_t *keys,
+                                                      uint8_t dt,
+                                                      uint32_t nb_repair,
+                                                      void **new_bufs)
+{
+    /* without a cache, the coefficients are generated by groups of keys */
+    uint16_t key_tab[TINYMT32_NB_LANES];
+    uint8_t *cc_ptr_tab[TINYMT32_NB_LANES];
+    uint16_t cc_nb_tab[TINYMT32_NB_LANES];
+    uint32_t nb_key = 0;
+    const uint8_t *cc_tab;
+    full_symbol_data_op_t *dst_tab;
+    uint64_t start;
+    uint32_t nb_pending = 0;
+    uint32_t nb_op = 0;
+    uint32_t r, i, k;
+
+    if(nb_repair == 0)
+    {
+        return SWIF_STATUS_OK;
+    }
+    enc->repair_size = rlc_encoder_repair_size(enc);
+    if(!rlc_encoder_reserve_repair_data_ops(enc, nb_repair))
+    {
+        fprintf(stderr, "swif_rlc_build_repair_symbols failed! No memory\n");
+        return SWIF_STATUS_ERROR;
+    }
+
+    /* the buffers still to be computed are kept after the operations (in
+       dst_tab[k].dst for the k-th of them) */
+    dst_tab = enc->data_op_tab
+              + (size_t)nb_repair * RLC_ENCODER_NB_OP_PER_SOURCE(enc) * enc->max_coding_window_size;
+    for(r = 0; r < nb_repair; r++)
+    {
+        if((i = rlc_encoder_find_accumulator(enc, keys[r], dt)) < enc->nb_acc)
+        {
+            rlc_encoder_take_accumulator(enc, i, &new_bufs[r]);
+            continue;
+        }
+        if(enc->speculator != NULL
+           && rlc_encoder_take_speculative_repair(enc, keys[r], dt, &new_bufs[r]))
+        {
+            continue;
+        }
+        if(new_bufs[r] == 0 && (new_bufs[r] = rlc_encoder_alloc_repair_buffer(enc)) == NULL)
+        {
+            fprintf(stderr, "swif_rlc_build_repair_symbols failed! No memory\n");
+            return SWIF_STATUS_ERROR;
+        }
+        if((i = rlc_encoder_find_standing_repair(enc, keys[r])) < enc->nb_standing)
+        {
+            memcpy(new_bufs[r], enc->standing_tab[i].buf, enc->repair_size);
+            continue;
+        }
+        memset(new_bufs[r], 0, enc->repair_size);
+        start = rlc_read_cycles();
+        if(enc->generic_encoder.codepoint == SWIF_CODEPOINT_RLC_GF_256_VANDERMONDE_CODEC)
+        {
+            swif_rlc_generate_vandermonde_coefficients(
+                (uint16_t)keys[r], RLC_ENCODER_FIRST_ESI(enc),
+                enc->batch_cc_tab + nb_pending * enc->max_coding_window_size, enc->ew_ss_nb);
+        }
+        else if((cc_tab = swif_coefs_atlas_lookup(enc->coefs_atlas, (uint16_t)keys[r],
+                                                  enc->ew_ss_nb, dt, 8)) != NULL)
+        {
+            memcpy(enc->batch_cc_tab + nb_pending * enc->max_coding_window_size, cc_tab,
+                   enc->ew_ss_nb);
+        }
+        else if(enc->coefs_cache != NULL)
+        {
+            swif_coefs_cache_generate_coding_coefficients(
+                enc->coefs_cache, (uint16_t)keys[r],
+                enc->batch_cc_tab + nb_pending * enc->max_coding_window_size, enc->ew_ss_nb, dt, 8);
+        }
+        else
+        {
+            key_tab[nb_key] = (uint16_t)keys[r];
+            cc_ptr_tab[nb_key] = enc->batch_cc_tab + nb_pending * enc->max_coding_window_size;
+            cc_nb_tab[nb_key] = enc->ew_ss_nb;
+            if(++nb_key == TINYMT32_NB_LANES)
+            {
+                swif_rlc_generate_coding_coefficients_batch(key_tab, cc_ptr_tab, cc_nb_tab,
+                                                            nb_key, dt, 8);
+                nb_key = 0;
+            }
+        }
+        enc->stats.coefs_cycles += rlc_read_cycles() - start;
+        dst_tab[nb_pending].dst = new_bufs[r];
+        nb_pending++;
+    }
+    if(nb_key > 0)
+    {
+        start = rlc_read_cycles();
+        swif_rlc_generate_coding_coefficients_batch(key_tab, cc_ptr_tab, cc_nb_tab, nb_key, dt, 8);
+        enc->stats.coefs_cycles += rlc_read_cycles() - start;
+    }
+
+    for(i = 0; i < enc->ew_ss_nb; i++)
+    {
+        uint32_t idx = (enc->ew_left + i) % enc->max_coding_window_size;
+
+        for(k = 0; k < nb_pending; k++)
+        {
+            uint8_t coef = enc->batch_cc_tab[k * enc->max_coding_window_size + i];
+
+            if(coef == 0)
+            {
+                continue;
+            }
+            rlc_encoder_set_source_data_ops(enc, &enc->data_op_tab[nb_op], dst_tab[k].dst, idx,
+                                            coef);
+            nb_op += RLC_ENCODER_NB_OP_PER_SOURCE(enc);
+        }
+    }
+    rlc_encoder_count_data_ops(&enc->stats, enc->data_op_tab, nb_op);
+    full_symbol_run_data_ops(enc->workers, enc->data_op_tab, nb_op, enc->repair_size);
+
+    /* as after generating the coefficients of the last key */
+    start = rlc_read_cycles();
+    cc_tab = rlc_generate_coding_coefficients(enc->generic_encoder.codepoint, enc->coefs_atlas,
+                                              enc->coefs_cache, (uint16_t)keys[nb_repair - 1],
+                                              RLC_ENCODER_FIRST_ESI(enc), enc->cc_tab,
+                                              enc->ew_ss_nb, dt);
+    enc->stats.coefs_cycles += rlc_read_cycles() - start;
+    enc->cc_atlas_tab = (cc_tab != enc->cc_tab) ? cc_tab : NULL;
+    enc->cc_is_generated = true;
+    enc->cc_key = keys[nb_repair - 1];
+    enc->cc_dt = dt;
+    enc->spec_has_key = true;
+    enc->spec_next_key = keys[nb_repair - 1] + 1;
+    enc->spec_dt = dt;
+    return SWIF_STATUS_OK;
+}
+
+swif_status_t swif_rlc_build_repair_symbols(swif_encoder_t *generic_encoder,
+                                            uint32_t *keys,
+                                            uint8_t dt,
+                                            uint32_t nb_repair,
+                                            void **new_bufs)
+{
+    swif_encoder_rlc_cb_t *enc = (swif_encoder_rlc_cb_t *)generic_encoder;
+    uint64_t start = rlc_read_cycles();
+    swif_status_t status = rlc_encoder_build_repair_symbols(enc, keys, dt, nb_repair, new_bufs);
+
+    if(status == SWIF_STATUS_OK)
+    {
+        enc->stats.nb_repair_symbols += nb_repair;
+    }
+    enc->stats.build_cycles += rlc_read_cycles() - start;
+    return status;
+}
+
+/**
+ * Announce a repair symbol built later, once last_esi ends the coding
+ * window: it is computed as its source symbols are added.
+ */
+swif_status_t swif_rlc_encoder_precommit_repair_key(swif_encoder_t *generic_encoder,
+                                                    uint32_t key,
+                                                    uint8_t dt,
+                                                    esi_t last_esi)
+{
+    swif_encoder_rlc_cb_t *enc = (swif_encoder_rlc_cb_t *)generic_encoder;
+    swif_rlc_repair_accumulator_t *acc;
+    const uint8_t *cc_tab;
+    uint64_t start;
+    esi_t first_esi;
+    esi_t esi;
+
+    /* the coding window of the repair symbol: the max_coding_window_size
+       last source symbols, but none of those already gone */
+    first_esi = (last_esi + 1 >= enc->max_coding_window_size)
+                    ? last_esi + 1 - enc->max_coding_window_size : 0;
+    if(enc->ew_esi_right != INVALID_ESI)
+    {
+        if(last_esi < enc->ew_esi_right)
+        {
+            fprintf(stderr, "swif_rlc_encoder_precommit_repair_key: coding window already "
+                            "goes past %u (up to %u)\n", last_esi, enc->ew_esi_right);
+            return SWIF_STATUS_ERROR;
+        }
+        if(first_esi < enc->ew_esi_right + 1 - enc->ew_ss_nb)
+            first_esi = enc->ew_esi_right + 1 - enc->ew_ss_nb;
+    }
+
+    if(enc->nb_acc == enc->acc_capacity)
+    {
+        uint32_t new_capacity = (enc->acc_capacity == 0) ? 4 : 2 * enc->acc_capacity;
+        swif_rlc_repair_accumulator_t *new_tab;
+
+        new_tab = realloc(enc->acc_tab, new_capacity * sizeof(swif_rlc_repair_accumulator_t));
+        if(new_tab == NULL)
+        {
+            fprintf(stderr, "swif_rlc_encoder_precommit_repair_key: no memory\n");
+            return SWIF_STATUS_ERROR;
+        }
+        enc->acc_tab = new_tab;
+        /* the coefficient tables are allocated once, for any coding window */
+        for(; enc->acc_capacity < new_capacity; enc->acc_capacity++)
+        {
+            enc->acc_tab[enc->acc_capacity].buf = NULL;
+            if((enc->acc_tab[enc->acc_capacity].cc_tab = malloc(enc->max_coding_window_size))
+               == NULL)
+            {
+                fprintf(stderr, "swif_rlc_encoder_precommit_repair_key: no memory\n");
+                return SWIF_STATUS_ERROR;
+            }
+        }
+    }
+    acc = &enc->acc_tab[enc->nb_acc];
+    acc->key = key;
+    acc->dt = dt;
+    acc->first_esi = first_esi;
+    acc->last_esi = last_esi;
+    if((acc->buf = rlc_encoder_alloc_repair_buffer(enc)) == NULL)
+    {
+        fprintf(stderr, "swif_rlc_encoder_precommit_repair_key: no memory\n");
+        return SWIF_STATUS_ERROR;
+    }
+    memset(acc->buf, 0, enc->symbol_size);
+    /* the same coefficients as swif_rlc_encoder_generate_coding_coefs()
+       for this coding window */
+    start = rlc_read_cycles();
+    cc_tab = rlc_generate_coding_coefficients(enc->generic_encoder.codepoint, enc->coefs_atlas,
+                                              enc->coefs_cache, (uint16_t)key, first_esi,
+                                              acc->cc_tab, last_esi - first_esi + 1, dt);
+    enc->stats.coefs_cycles += rlc_read_cycles() - start;
+    if(cc_tab != acc->cc_tab)
+    {
+        memcpy(acc->cc_tab, cc_tab, last_esi - first_esi + 1);
+    }
+    enc->nb_acc++;
+
+    /* source symbols already there */
+    if(enc->ew_esi_right != INVALID_ESI)
+    {
+        for(esi = first_esi; esi <= enc->ew_esi_right; esi++)
+        {
+            uint32_t idx = (enc->ew_left + esi - (enc->ew_esi_right + 1 - enc->ew_ss_nb))
+                           % enc->max_coding_window_size;
+            rlc_encoder_add_scaled_source_symbol(enc, acc->buf, acc->cc_tab[esi - first_esi], idx);
+        }
+    }
+    return SWIF_STATUS_OK;
+}
+
+/*******************************************************************************
+ * Decoder functions
+ */
+
+/**
+ * Release a decoder and its associated ressources.
  **/
-swif_status_t swif_rlc_encoder_release(swif_encoder_t *enc)
+swif_status_t swif_rlc_decoder_release(swif_decoder_t *dec)
 {
-    assert(enc);
-    swif_encoder_rlc_cb_t *rlc_enc = (swif_encoder_rlc_cb_t *)enc;
-    if(rlc_enc->cc_tab)
-        free(rlc_enc->cc_tab);
-    if(rlc_enc->ew_tab)
-        free(rlc_enc->ew_tab);
-    free(enc);
+    assert(dec);
+    swif_decoder_rlc_cb_t *rlc_dec = (swif_decoder_rlc_cb_t *)dec;
+    if(rlc_dec->coef_tab)
+        free(rlc_dec->coef_tab);
+    if(rlc_dec->symbol_set)
+        full_symbol_set_free(rlc_dec->symbol_set);
+    free(rlc_dec->variable_length_buf);
+    swif_workers_free(rlc_dec->workers);
+    free(rlc_dec);
     return SWIF_STATUS_OK;
 }
 
 /**
- * Set the various callback functions for this encoder.
- * All the callback functions require an opaque context parameter, that must be
- * initialized accordingly by the application, since it is application specific.
+ * Internal function: map the decoded callback function of full_symbol
+ * to the one of swif_rlc_decoder,
+ **/
+static void
+rlc_decoder_notify_decoded(swif_full_symbol_set_t *set, symbol_id_t decoded_id, void *dec)
+{
+    swif_decoder_rlc_cb_t *rlc_dec = (swif_decoder_rlc_cb_t *)dec;
+    swif_full_symbol_t *full_symbol = full_symbol_set_get_pivot(rlc_dec->symbol_set, decoded_id);
+
+    if(rlc_dec->decoded_source_symbol_callback != NULL)
+    {
+        rlc_dec->decoded_source_symbol_callback(
+            rlc_dec->context_4_callback, full_symbol->data,
+            (esi_t)decoded_id); // XXX: esi_t is different from symbol_id_t
+    }
+}
+
+/**
+ * Internal function: map the decodable callback function of full_symbol
+ * to the one of swif_rlc_decoder. The buffer returned, provided by the
+ * application (or allocated here when it returns NULL), belongs to the
+ * application: the decoded source symbol is directly computed there.
+ **/
+static uint8_t *
+rlc_decoder_notify_decodable(swif_full_symbol_set_t *set, symbol_id_t decodable_id, void *dec)
+{
+    swif_decoder_rlc_cb_t *rlc_dec = (swif_decoder_rlc_cb_t *)dec;
+    uint8_t *buffer;
+
+    if(rlc_dec->decodable_source_symbol_callback == NULL)
+    {
+        /* the application reads the decoded symbol from our own buffer */
+        return NULL;
+    }
+    buffer = rlc_dec->decodable_source_symbol_callback(rlc_dec->context_4_callback,
+                                                       (esi_t)decodable_id);
+    if(buffer == NULL && (buffer = malloc(MAX(rlc_dec->symbol_size, 1))) == NULL)
+    {
+        fprintf(stderr, "rlc_decoder_notify_decodable() failed! No memory \n");
+    }
+    return buffer;
+}
+
+/**
+ * Internal function: map the removed callback function of full_symbol
+ * to the one of swif_rlc_decoder,
+ **/
+static void
+rlc_decoder_notify_removed(swif_full_symbol_set_t *set, symbol_id_t removed_id, void *dec)
+{
+    swif_decoder_rlc_cb_t *rlc_dec = (swif_decoder_rlc_cb_t *)dec;
+
+    if(rlc_dec->source_symbol_removed_from_linear_system_callback != NULL)
+    {
+        rlc_dec->source_symbol_removed_from_linear_system_callback(rlc_dec->context_4_callback,
+                                                                   (esi_t)removed_id);
+    }
+}
+
+/**
+ * Set the various callback functions for this decoder.
+ * All the callback functions require an opaque context parameter, that
+ * must be initialized accordingly by the application, since it is
+ * application specific.
  */
-swif_status_t swif_rlc_encoder_set_callback_functions(
-    swif_encoder_t *enc,
-    void (*source_symbol_removed_from_coding_window_callback)(void *context, esi_t old_symbol_esi),
+swif_status_t swif_rlc_decoder_set_callback_functions(
+    swif_decoder_t *dec,
+    void (*source_symbol_removed_from_linear_system_callback)(void *context, esi_t old_symbol_esi),
+    void *(*decodable_source_symbol_callback)(void *context, esi_t esi),
+    void *(*decoded_source_symbol_callback)(void *context, void *new_symbol_buf, esi_t esi),
     void *context_4_callback)
 {
-    swif_encoder_rlc_cb_t *rlc_enc = (swif_encoder_rlc_cb_t *)enc;
+    swif_decoder_rlc_cb_t *rlc_dec = (swif_decoder_rlc_cb_t *)dec;
+    rlc_dec->context_4_callback = context_4_callback;
+    rlc_dec->source_symbol_removed_from_linear_system_callback =
+        source_symbol_removed_from_linear_system_callback;
+    rlc_dec->decodable_source_symbol_callback = decodable_source_symbol_callback;
+    rlc_dec->decoded_source_symbol_callback = decoded_source_symbol_callback;
+    assert(rlc_dec->symbol_set != NULL);
+    rlc_dec->symbol_set->notify_decodable_func = rlc_decoder_notify_decodable;
+    rlc_dec->symbol_set->notify_decoded_func = rlc_decoder_notify_decoded;
+    rlc_dec->symbol_set->notify_removed_func = rlc_decoder_notify_removed;
+    rlc_dec->symbol_set->notify_context = (void *)rlc_dec;
+    return SWIF_STATUS_OK;
+}
 
-    assert(enc);
-    rlc_enc->source_symbol_removed_from_coding_window_callback =
-        source_symbol_removed_from_coding_window_callback;
-    rlc_enc->context_4_callback = context_4_callback;
+/**
+ * Internal function: allocate the linear system of a decoder, either
+ * growing as needed, or with a fixed capacity (no memory allocation
+ * during decoding).
+ **/
+static swif_full_symbol_set_t *rlc_decoder_alloc_symbol_set(swif_decoder_rlc_cb_t *rlc_dec,
+                                                            bool fixed_capacity)
+{
+    swif_full_symbol_set_t *set;
+
+    if(fixed_capacity)
+    {
+        set = full_symbol_set_alloc_fixed(rlc_dec->max_linear_system_size, rlc_dec->symbol_size);
+    }
+    else
+    {
+        set = full_symbol_set_alloc();
+    }
+    if(set != NULL)
+    {
+        /* the linear system slides over the max_linear_system_size most recent
+           source symbols, older ones being removed (0 means no limit) */
+        set->max_symbol_id_span = rlc_dec->max_linear_system_size;
+    }
+    return set;
+}
+
+/**
+ * Internal function: switch to a linear system of fixed capacity or back,
+ * possible only before the first symbol is submitted.
+ **/
+static swif_status_t rlc_decoder_set_fixed_capacity(swif_decoder_rlc_cb_t *rlc_dec,
+                                                    bool fixed_capacity)
+{
+    swif_full_symbol_set_t *old_set = rlc_dec->symbol_set;
+    swif_full_symbol_set_t *new_set;
+
+    if(fixed_capacity == (old_set->pool != NULL))
+    {
+        return SWIF_STATUS_OK;
+    }
+    if(fixed_capacity && rlc_dec->max_linear_system_size == 0)
+    {
+        fprintf(stderr, "swif_rlc_decoder_set_parameters: fixed capacity requires a "
+                        "max_linear_system_size\n");
+        return SWIF_STATUS_ERROR;
+    }
+    if(old_set->last_symbol_id != SYMBOL_ID_NONE)
+    {
+        fprintf(stderr, "swif_rlc_decoder_set_parameters: fixed capacity must be set before "
+                        "decoding\n");
+        return SWIF_STATUS_ERROR;
+    }
+    if((new_set = rlc_decoder_alloc_symbol_set(rlc_dec, fixed_capacity)) == NULL)
+    {
+        fprintf(stderr, "swif_rlc_decoder_set_parameters() failed! No memory \n");
+        return SWIF_STATUS_ERROR;
+    }
+    new_set->elimination_budget = old_set->elimination_budget;
+    new_set->notify_decodable_func = old_set->notify_decodable_func;
+    new_set->notify_decoded_func = old_set->notify_decoded_func;
+    new_set->notify_removed_func = old_set->notify_removed_func;
+    new_set->notify_context = old_set->notify_context;
+    new_set->workers = old_set->workers;
+    full_symbol_set_free(old_set);
+    rlc_dec->symbol_set = new_set;
+    return SWIF_STATUS_OK;
+}
+
+/* Replace the workers of the decoder by nb_threads ones (none for 1) */
+static swif_status_t rlc_decoder_set_nb_threads(swif_decoder_rlc_cb_t *rlc_dec, uint32_t nb_threads)
+{
+    swif_workers_t *workers = NULL;
+    if(nb_threads > 1 && (workers = swif_workers_create(nb_threads)) == NULL)
+    {
+        fprintf(stderr, "swif_rlc_decoder_set_parameters: cannot start %u threads\n", nb_threads);
+        return SWIF_STATUS_ERROR;
+    }
+    swif_workers_free(rlc_dec->workers);
+    rlc_dec->workers = workers;
+    rlc_dec->symbol_set->workers = workers;
     return SWIF_STATUS_OK;
 }
 
-/**
- * This function sets one or more FEC codec specific parameters,
- * using a type/length/value approach for maximum flexibility.
- */
-swif_status_t
-swif_rlc_encoder_set_parameters(swif_encoder_t *enc, uint32_t type, uint32_t length, void *value)
-{
-    // NOT YET
-    return SWIF_STATUS_OK;
+/**
+ * This function sets one or more FEC codec specific parameters,
+ *        using a type/length/value approach for maximum flexibility.
+ */
+swif_status_t
+swif_rlc_decoder_set_parameters(swif_decoder_t *dec, uint32_t type, uint32_t length, void *value)
+{
+    swif_decoder_rlc_cb_t *rlc_dec = (swif_decoder_rlc_cb_t *)dec;
+
+    switch(type)
+    {
+    case swif_DECODER_SET_PARAM_ZERO_COPY_SOURCE_SYMBOLS:
+        if(value == NULL || length != sizeof(uint32_t))
+        {
+            fprintf(stderr, "swif_rlc_decoder_set_parameters: bad zero copy value (length %u)\n",
+                    length);
+            return SWIF_STATUS_ERROR;
+        }
+        rlc_dec->zero_copy_source_symbols = (*(uint32_t *)value != 0);
+        return SWIF_STATUS_OK;
+
+    case swif_DECODER_SET_PARAM_ELIMINATION_BUDGET:
+        if(value == NULL || length != sizeof(uint32_t))
+        {
+            fprintf(stderr, "swif_rlc_decoder_set_parameters: bad budget value (length %u)\n",
+                    length);
+            return SWIF_STATUS_ERROR;
+        }
+        rlc_dec->symbol_set->elimination_budget = *(uint32_t *)value;
+        return SWIF_STATUS_OK;
+
+    case swif_DECODER_SET_PARAM_FIXED_CAPACITY:
+        if(value == NULL || length != sizeof(uint32_t))
+        {
+            fprintf(stderr, "swif_rlc_decoder_set_parameters: bad fixed capacity value "
+                            "(length %u)\n", length);
+            return SWIF_STATUS_ERROR;
+        }
+        return rlc_decoder_set_fixed_capacity(rlc_dec, *(uint32_t *)value != 0);
+
+    case swif_DECODER_SET_PARAM_NB_THREADS:
+        if(value == NULL || length != sizeof(uint32_t) || *(uint32_t *)value == 0)
+        {
+            fprintf(stderr, "swif_rlc_decoder_set_parameters: bad number of threads "
+                            "(length %u)\n", length);
+            return SWIF_STATUS_ERROR;
+        }
+        return rlc_decoder_set_nb_threads(rlc_dec, *(uint32_t *)value);
+
+    case swif_DECODER_SET_PARAM_COEFS_CACHE:
+        if(value == NULL || length != sizeof(swif_coefs_cache_t *))
+        {
+            fprintf(stderr, "swif_rlc_decoder_set_parameters: bad coefficients cache value "
+                            "(length %u)\n", length);
+            return SWIF_STATUS_ERROR;
+        }
+        rlc_dec->coefs_cache = *(swif_coefs_cache_t **)value;
+        return SWIF_STATUS_OK;
+
+    case swif_DECODER_SET_PARAM_COEFS_ATLAS:
+        if(value == NULL || length != sizeof(swif_coefs_atlas_t *))
+        {
+            fprintf(stderr, "swif_rlc_decoder_set_parameters: bad coefficient atlas value "
+                            "(length %u)\n", length);
+            return SWIF_STATUS_ERROR;
+        }
+        rlc_dec->coefs_atlas = *(swif_coefs_atlas_t **)value;
+        rlc_dec->coef_atlas_tab = NULL;
+        return SWIF_STATUS_OK;
+
+    case swif_DECODER_SET_PARAM_VARIABLE_LENGTH_SOURCE_SYMBOLS:
+        if(value == NULL || length != sizeof(uint32_t))
+        {
+            fprintf(stderr, "swif_rlc_decoder_set_parameters: bad variable length source "
+                            "symbols value (length %u)\n", length);
+            return SWIF_STATUS_ERROR;
+        }
+        if(*(uint32_t *)value == 0)
+        {
+            free(rlc_dec->variable_length_buf);
+            rlc_dec->variable_length_buf = NULL;
+            return SWIF_STATUS_OK;
+        }
+        if(rlc_dec->symbol_size <= SWIF_LENGTH_FIELD_SIZE)
+        {
+            fprintf(stderr, "swif_rlc_decoder_set_parameters: symbol_size %u does not allow "
+                            "variable length source symbols\n", rlc_dec->symbol_size);
+            return SWIF_STATUS_ERROR;
+        }
+        if(rlc_dec->variable_length_buf == NULL
+           && (rlc_dec->variable_length_buf = malloc(rlc_dec->symbol_size)) == NULL)
+        {
+            fprintf(stderr, "swif_rlc_decoder_set_parameters: no memory\n");
+            return SWIF_STATUS_ERROR;
+        }
+        return SWIF_STATUS_OK;
+
+    default:
+        // NOT YET
+        return SWIF_STATUS_OK;
+    }
 }
 
 /**
@@ -57,122 +1647,103 @@ swif_rlc_encoder_set_parameters(swif_encoder_t *enc, uint32_t type, uint32_t len
  * using a type/length/value approach for maximum flexibility.
  */
 swif_status_t
-swif_rlc_encoder_get_parameters(swif_encoder_t *enc, uint32_t type, uint32_t length, void *value)
-{
-    // NOT YET
-    return SWIF_STATUS_OK;
-}
-
-/**
- * Create a single repair symbol (i.e. perform an encoding).
- */
-swif_status_t swif_rlc_build_repair_symbol(swif_encoder_t *generic_encoder, void **new_buf)
+swif_rlc_decoder_get_parameters(swif_decoder_t *dec, uint32_t type, uint32_t length, void *value)
 {
-    swif_encoder_rlc_cb_t *enc = (swif_encoder_rlc_cb_t *)generic_encoder;
-    uint32_t i;
+    swif_decoder_rlc_cb_t *rlc_dec = (swif_decoder_rlc_cb_t *)dec;
 
-    if(*new_buf == 0)
+    switch(type)
     {
-        if((*new_buf = calloc(1, enc->symbol_size)) == NULL)
+    case swif_DECODER_GET_PARAM_PENDING_WORK:
+        if(value == NULL || length != sizeof(uint32_t))
         {
-            fprintf(stderr, "swif_rlc_build_repair_symbol failed! No memory\n");
+            fprintf(stderr, "swif_rlc_decoder_get_parameters: bad pending work value (length %u)\n",
+                    length);
             return SWIF_STATUS_ERROR;
         }
-    }
-    else
-    {
-        memset(*new_buf, 0, enc->symbol_size);
-    }
+        *(uint32_t *)value = rlc_dec->symbol_set->nb_pending_pivot;
+        return SWIF_STATUS_OK;
 
-    DEBUG_PRINT("\nbuild-repair: \n");
-    for(i = enc->ew_left; i < enc->ew_ss_nb; i++)
-    {
-        uint32_t idx = i % enc->max_coding_window_size;
-        DEBUG_PRINT(" +%u.P[%u->%u]", enc->cc_tab[idx], i, idx);
-        symbol_add_scaled(*new_buf, enc->cc_tab[idx], enc->ew_tab[idx], enc->symbol_size);
+    default:
+        // NOT YET
+        return SWIF_STATUS_OK;
     }
-    DEBUG_PRINT("\n");
-    return SWIF_STATUS_OK;
 }
 
-/*******************************************************************************
- * Decoder functions
- */
-
 /**
- * Release a decoder and its associated ressources.
- **/
-swif_status_t swif_rlc_decoder_release(swif_decoder_t *dec)
+ * Go on with the decoding work queued because of the elimination budget.
+ */
+swif_status_t swif_rlc_decoder_make_progress(swif_decoder_t *dec, uint32_t budget)
 {
-    assert(dec);
     swif_decoder_rlc_cb_t *rlc_dec = (swif_decoder_rlc_cb_t *)dec;
-    if(rlc_dec->coef_tab)
-        free(rlc_dec->coef_tab);
-    if(rlc_dec->symbol_set)
-        full_symbol_set_free(rlc_dec->symbol_set);
-    free(rlc_dec);
+
+    full_symbol_set_make_progress(rlc_dec->symbol_set, budget);
     return SWIF_STATUS_OK;
 }
 
-/**
- * Internal function: map the decoded callback function of full_symbol
- * to the one of swif_rlc_decoder,
- **/
-static void
-rlc_decoder_notify_decoded(swif_full_symbol_set_t *set, symbol_id_t decoded_id, void *dec)
-{
-    swif_decoder_rlc_cb_t *rlc_dec = (swif_decoder_rlc_cb_t *)dec;
-    printf("notify decoded: %u\n", decoded_id);
-    swif_full_symbol_t *full_symbol = full_symbol_set_get_pivot(rlc_dec->symbol_set, decoded_id);
-
-    rlc_dec->decoded_source_symbol_callback(
-        rlc_dec->context_4_callback, full_symbol->data,
-        (esi_t)decoded_id); // XXX: esi_t is different from symbol_id_t
-}
+/* the decoder parameters (codepoint, symbol_size, max_coding_window_size,
+   max_linear_system_size) precede the linear system in a snapshot */
+#define RLC_DECODER_SNAPSHOT_HEADER_SIZE (4 * 4)
 
 /**
- * Set the various callback functions for this decoder.
- * All the callback functions require an opaque context parameter, that
- * must be initialized accordingly by the application, since it is
- * application specific.
+ * Save the state of the decoder in a compact binary buffer.
  */
-swif_status_t swif_rlc_decoder_set_callback_functions(
-    swif_decoder_t *dec,
-    void (*source_symbol_removed_from_linear_system_callback)(void *context, esi_t old_symbol_esi),
-    void *(*decodable_source_symbol_callback)(void *context, esi_t esi),
-    void *(*decoded_source_symbol_callback)(void *context, void *new_symbol_buf, esi_t esi),
-    void *context_4_callback)
+swif_status_t
+swif_rlc_decoder_snapshot(swif_decoder_t *dec, void *snapshot_buf, uint32_t *snapshot_size)
 {
-    // NOT YET
     swif_decoder_rlc_cb_t *rlc_dec = (swif_decoder_rlc_cb_t *)dec;
-    rlc_dec->symbol_set->notify_context = context_4_callback;
-    rlc_dec->context_4_callback = context_4_callback;
-    rlc_dec->decoded_source_symbol_callback = decoded_source_symbol_callback;
-    assert(rlc_dec->symbol_set != NULL);
-    rlc_dec->symbol_set->notify_decoded_func = rlc_decoder_notify_decoded;
-    rlc_dec->symbol_set->notify_context = (void *)rlc_dec;
-    return SWIF_STATUS_OK;
-}
+    uint32_t size = RLC_DECODER_SNAPSHOT_HEADER_SIZE +
+                    full_symbol_set_get_snapshot_size(rlc_dec->symbol_set);
 
-/**
- * This function sets one or more FEC codec specific parameters,
- *        using a type/length/value approach for maximum flexibility.
- */
-swif_status_t
-swif_rlc_decoder_set_parameters(swif_decoder_t *dec, uint32_t type, uint32_t length, void *value)
-{
-    // NOT YET
+    if(snapshot_buf == NULL)
+    {
+        *snapshot_size = size;
+        return SWIF_STATUS_OK;
+    }
+    if(*snapshot_size < size)
+    {
+        fprintf(stderr, "swif_rlc_decoder_snapshot: buffer too small (%u < %u)\n",
+                *snapshot_size, size);
+        return SWIF_STATUS_ERROR;
+    }
+    uint8_t *ptr = (uint8_t *)snapshot_buf;
+    ptr = snapshot_put_u32(ptr, dec->codepoint);
+    ptr = snapshot_put_u32(ptr, rlc_dec->symbol_size);
+    ptr = snapshot_put_u32(ptr, rlc_dec->max_coding_window_size);
+    ptr = snapshot_put_u32(ptr, rlc_dec->max_linear_system_size);
+    full_symbol_set_snapshot(rlc_dec->symbol_set, ptr, size - RLC_DECODER_SNAPSHOT_HEADER_SIZE);
+    *snapshot_size = size;
     return SWIF_STATUS_OK;
 }
 
 /**
- * This function gets one or more FEC codec specific parameters,
- * using a type/length/value approach for maximum flexibility.
+ * Restore a state saved by swif_rlc_decoder_snapshot().
  */
 swif_status_t
-swif_rlc_decoder_get_parameters(swif_decoder_t *dec, uint32_t type, uint32_t length, void *value)
+swif_rlc_decoder_restore(swif_decoder_t *dec, const void *snapshot_buf, uint32_t snapshot_size)
 {
-    // NOT YET
+    swif_decoder_rlc_cb_t *rlc_dec = (swif_decoder_rlc_cb_t *)dec;
+    const uint8_t *ptr = (const uint8_t *)snapshot_buf;
+
+    if(rlc_dec->symbol_set->last_symbol_id != SYMBOL_ID_NONE)
+    {
+        fprintf(stderr, "swif_rlc_decoder_restore: decoder already in use\n");
+        return SWIF_STATUS_ERROR;
+    }
+    if(snapshot_size < RLC_DECODER_SNAPSHOT_HEADER_SIZE ||
+       snapshot_get_u32(ptr) != dec->codepoint ||
+       snapshot_get_u32(ptr + 4) != rlc_dec->symbol_size ||
+       snapshot_get_u32(ptr + 8) != rlc_dec->max_coding_window_size ||
+       snapshot_get_u32(ptr + 12) != rlc_dec->max_linear_system_size)
+    {
+        fprintf(stderr, "swif_rlc_decoder_restore: snapshot of a different decoder\n");
+        return SWIF_STATUS_ERROR;
+    }
+    if(full_symbol_set_restore(rlc_dec->symbol_set, ptr + RLC_DECODER_SNAPSHOT_HEADER_SIZE,
+                               snapshot_size - RLC_DECODER_SNAPSHOT_HEADER_SIZE) == 0)
+    {
+        fprintf(stderr, "swif_rlc_decoder_restore: invalid snapshot\n");
+        return SWIF_STATUS_ERROR;
+    }
     return SWIF_STATUS_OK;
 }
 
@@ -187,14 +1758,21 @@ swif_status_t swif_rlc_decoder_decode_with_new_source_symbol(swif_decoder_t *dec
 {
     swif_decoder_rlc_cb_t *rlc_dec = (swif_decoder_rlc_cb_t *)dec;
 
-    swif_full_symbol_t *full_symbol =
-        full_symbol_create_from_source(new_symbol_esi, new_symbol_buf, rlc_dec->symbol_size);
-    full_symbol_dump(full_symbol, stdout);
-    full_symbol_add_with_elimination(rlc_dec->symbol_set, full_symbol);
-
-    full_symbol_free(full_symbol);
-
-    // fprintf(stderr, "[XXX] not checking if too many stored symbols\n");
+    if(rlc_dec->variable_length_buf != NULL)
+    {
+        fprintf(stderr, "swif_rlc_decoder_decode_with_new_source_symbol() failed! source "
+                        "symbols have variable lengths\n");
+        return SWIF_STATUS_ERROR;
+    }
+    swif_full_symbol_t *full_symbol = full_symbol_pool_create_from_source(
+        rlc_dec->symbol_set->pool, new_symbol_esi, new_symbol_buf, rlc_dec->symbol_size,
+        rlc_dec->zero_copy_source_symbols);
+    if(full_symbol == NULL)
+    {
+        fprintf(stderr, "swif_rlc_decoder_decode_with_new_source_symbol() failed! No memory \n");
+        return SWIF_STATUS_ERROR;
+    }
+    full_symbol_add_with_elimination_take(rlc_dec->symbol_set, full_symbol);
     return SWIF_STATUS_OK;
 }
 
@@ -211,12 +1789,89 @@ swif_status_t swif_rlc_decoder_decode_with_new_repair_symbol(swif_decoder_t *dec
     swif_decoder_rlc_cb_t *rlc_dec = (swif_decoder_rlc_cb_t *)dec;
     // XXX;
     swif_full_symbol_t *full_symbol = NULL;
-    full_symbol = full_symbol_create(rlc_dec->coef_tab, rlc_dec->first_id, rlc_dec->nb_id,
-                                     new_symbol_buf, rlc_dec->symbol_size);
-    full_symbol_add_with_elimination(rlc_dec->symbol_set, full_symbol);
+    full_symbol = full_symbol_pool_create(rlc_dec->symbol_set->pool,
+                                          (rlc_dec->coef_atlas_tab != NULL)
+                                              ? (uint8_t *)rlc_dec->coef_atlas_tab
+                                              : rlc_dec->coef_tab,
+                                          rlc_dec->first_id, rlc_dec->nb_id, new_symbol_buf,
+                                          rlc_dec->symbol_size);
+    if(full_symbol == NULL)
+    {
+        fprintf(stderr, "swif_rlc_decoder_decode_with_new_repair_symbol() failed! No memory \n");
+        return SWIF_STATUS_ERROR;
+    }
+    full_symbol_add_with_elimination_take(rlc_dec->symbol_set, full_symbol);
+    return SWIF_STATUS_OK;
+}
+
+/**
+ * Submit a received source symbol of its own length, with variable length
+ * source symbols: it enters the linear system as its length field then its
+ * bytes (the following ones being zeros).
+ */
+swif_status_t swif_rlc_decoder_decode_with_new_variable_length_source_symbol(
+    swif_decoder_t *dec, void *const new_symbol_buf, uint32_t new_symbol_length,
+    esi_t new_symbol_esi)
+{
+    swif_decoder_rlc_cb_t *rlc_dec = (swif_decoder_rlc_cb_t *)dec;
+    swif_full_symbol_t *full_symbol;
+    uint8_t *buf = rlc_dec->variable_length_buf;
 
-    full_symbol_free(full_symbol);
-    // fprintf(stderr, "[XXX] not checking if too many stored symbols\n");
+    if(buf == NULL || new_symbol_length > rlc_dec->symbol_size - SWIF_LENGTH_FIELD_SIZE)
+    {
+        fprintf(stderr, "swif_rlc_decoder_decode_with_new_variable_length_source_symbol() "
+                        "failed! variable length source symbols not enabled, or bad length "
+                        "(%u)\n", new_symbol_length);
+        return SWIF_STATUS_ERROR;
+    }
+    buf[0] = (uint8_t)(new_symbol_length >> 8);
+    buf[1] = (uint8_t)new_symbol_length;
+    memcpy(buf + SWIF_LENGTH_FIELD_SIZE, new_symbol_buf, new_symbol_length);
+    full_symbol = full_symbol_pool_create_from_source(rlc_dec->symbol_set->pool, new_symbol_esi,
+                                                      buf,
+                                                      SWIF_LENGTH_FIELD_SIZE + new_symbol_length,
+                                                      false);
+    if(full_symbol == NULL)
+    {
+        fprintf(stderr, "swif_rlc_decoder_decode_with_new_variable_length_source_symbol() "
+                        "failed! No memory \n");
+        return SWIF_STATUS_ERROR;
+    }
+    full_symbol_add_with_elimination_take(rlc_dec->symbol_set, full_symbol);
+    return SWIF_STATUS_OK;
+}
+
+/**
+ * Submit a received repair symbol of new_symbol_size bytes (the following
+ * ones being zeros), with variable length source symbols.
+ */
+swif_status_t swif_rlc_decoder_decode_with_new_variable_length_repair_symbol(
+    swif_decoder_t *dec, void *const new_symbol_buf, uint32_t new_symbol_size,
+    esi_t new_symbol_esi)
+{
+    swif_decoder_rlc_cb_t *rlc_dec = (swif_decoder_rlc_cb_t *)dec;
+    swif_full_symbol_t *full_symbol;
+
+    if(rlc_dec->variable_length_buf == NULL || new_symbol_size > rlc_dec->symbol_size)
+    {
+        fprintf(stderr, "swif_rlc_decoder_decode_with_new_variable_length_repair_symbol() "
+                        "failed! variable length source symbols not enabled, or bad size "
+                        "(%u)\n", new_symbol_size);
+        return SWIF_STATUS_ERROR;
+    }
+    full_symbol = full_symbol_pool_create(rlc_dec->symbol_set->pool,
+                                          (rlc_dec->coef_atlas_tab != NULL)
+                                              ? (uint8_t *)rlc_dec->coef_atlas_tab
+                                              : rlc_dec->coef_tab,
+                                          rlc_dec->first_id, rlc_dec->nb_id, new_symbol_buf,
+                                          new_symbol_size);
+    if(full_symbol == NULL)
+    {
+        fprintf(stderr, "swif_rlc_decoder_decode_with_new_variable_length_repair_symbol() "
+                        "failed! No memory \n");
+        return SWIF_STATUS_ERROR;
+    }
+    full_symbol_add_with_elimination_take(rlc_dec->symbol_set, full_symbol);
     return SWIF_STATUS_OK;
 }
 
@@ -227,46 +1882,64 @@ swif_status_t swif_rlc_decoder_decode_with_new_repair_symbol(swif_decoder_t *dec
 /**
  * This function resets the current coding window. We assume here that
  * this window is maintained by the FEC codec instance.
- * Encoder:     reset the encoding window for the encoding of future
- *              repair symbols.
+ * Encoder:     all the source symbols leave the coding window (oldest
+ *              first, with the removal callback), as do the precommitted
+ *              repair symbols, and the next source symbol may have any ESI.
  * Decoder:     reset the coding window under preparation associated to
  *              a repair symbol just received.
  */
-swif_status_t swif_rlc_encoder_reset_coding_window(swif_encoder_t *enc)
+swif_status_t swif_rlc_encoder_reset_coding_window(swif_encoder_t *generic_enc)
 {
-    // NOT YET
+    swif_encoder_rlc_cb_t *enc = (swif_encoder_rlc_cb_t *)generic_enc;
+    uint32_t i;
+
+    rlc_encoder_cancel_speculation(enc);
+    if(enc->source_symbol_removed_from_coding_window_callback != NULL)
+    {
+        for(i = 0; i < enc->ew_ss_nb; i++)
+        {
+            enc->source_symbol_removed_from_coding_window_callback(
+                enc->context_4_callback, RLC_ENCODER_FIRST_ESI(enc) + i);
+        }
+    }
+    while(enc->nb_acc > 0)
+    {
+        rlc_encoder_drop_accumulator(enc, enc->nb_acc - 1);
+    }
+    /* nothing left in the standing repair symbols */
+    for(i = 0; i < enc->nb_standing; i++)
+    {
+        memset(enc->standing_tab[i].buf, 0, enc->symbol_size);
+    }
+    enc->ew_right = enc->ew_left = 0;
+    enc->ew_ss_nb = 0;
+    enc->ew_esi_right = INVALID_ESI;
+    enc->cc_is_generated = false;
+    enc->cc_atlas_tab = NULL;
     return SWIF_STATUS_OK;
 }
 
 swif_status_t swif_rlc_decoder_reset_coding_window(swif_decoder_t *dec)
 {
-    // NOT YET
     swif_decoder_rlc_cb_t *rlc_dec = (swif_decoder_rlc_cb_t *)dec;
 
-    if(rlc_dec->coef_tab == NULL)
-    {
-        /* free the structure in case of problem */
-        uint8_t *coef = (uint8_t *)calloc(rlc_dec->symbol_size, sizeof(uint8_t));
-        rlc_dec->coef_tab = coef;
-    }
-
-    memset(rlc_dec->coef_tab, 0, rlc_dec->symbol_size);
+    assert(rlc_dec->coef_tab != NULL);
+    memset(rlc_dec->coef_tab, 0, rlc_dec->max_coding_window_size);
+    rlc_dec->coef_atlas_tab = NULL;
     rlc_dec->first_id = SYMBOL_ID_NONE;
     rlc_dec->nb_id = 0;
     return SWIF_STATUS_OK;
 }
 
 /**
- * Add this source symbol to the coding window.
- * Encoder:     add a source symbol to the coding window.
- * Decoder:     add a source symbol to the coding window under preparation.
+ * Encoder: add a source symbol of length bytes (symbol_size unless they
+ * have variable lengths) to the coding window.
  */
-swif_status_t swif_rlc_encoder_add_source_symbol_to_coding_window(swif_encoder_t *generic_enc,
-                                                                  void *new_src_symbol_buf,
-                                                                  esi_t new_src_symbol_esi)
+static swif_status_t rlc_encoder_add_source_symbol(swif_encoder_rlc_cb_t *enc,
+                                                   void *new_src_symbol_buf,
+                                                   uint32_t length,
+                                                   esi_t new_src_symbol_esi)
 {
-    swif_encoder_rlc_cb_t *enc = (swif_encoder_rlc_cb_t *)generic_enc;
-
     if((enc->ew_esi_right != INVALID_ESI) && (new_src_symbol_esi != enc->ew_esi_right + 1))
     {
         fprintf(stderr,
@@ -275,40 +1948,97 @@ swif_status_t swif_rlc_encoder_add_source_symbol_to_coding_window(swif_encoder_t
                 new_src_symbol_esi, enc->ew_esi_right + 1);
         return SWIF_STATUS_ERROR;
     }
+    rlc_encoder_cancel_speculation(enc);
     if(enc->ew_ss_nb == enc->max_coding_window_size)
     {
-        if(enc->source_symbol_removed_from_coding_window_callback != NULL)
-        {
-            enc->source_symbol_removed_from_coding_window_callback(
-                enc->context_4_callback, enc->ew_esi_right + 1 - enc->ew_ss_nb);
-        }
-        enc->ew_tab[enc->ew_left] = new_src_symbol_buf;
-        enc->ew_right = enc->ew_left;
-        enc->ew_left = (enc->ew_left + 1) % enc->max_coding_window_size;
-        enc->ew_esi_right = new_src_symbol_esi;
+        rlc_encoder_remove_oldest_source_symbol(enc);
     }
-    else if(enc->ew_ss_nb == 0)
+    if(enc->ew_ss_nb == 0)
     {
         assert(enc->ew_left == enc->ew_right);
-        enc->ew_tab[enc->ew_right] = new_src_symbol_buf;
         enc->ew_esi_right = new_src_symbol_esi;
         enc->ew_ss_nb++;
     }
     else
     {
         enc->ew_right = (enc->ew_right + 1) % enc->max_coding_window_size;
-        enc->ew_tab[enc->ew_right] = new_src_symbol_buf;
         enc->ew_esi_right = new_src_symbol_esi;
         enc->ew_ss_nb++;
     }
-
+    /* the new source symbol is at ew_right */
+    if(enc->ew_data != NULL)
+    {
+        memcpy(enc->ew_tab[enc->ew_right], new_src_symbol_buf, length);
+    }
+    else
+    {
+        enc->ew_tab[enc->ew_right] = new_src_symbol_buf;
+    }
+    enc->stats.nb_source_symbols++;
+    if(enc->ew_length_tab != NULL)
+    {
+        enc->ew_length_tab[enc->ew_right] = (uint16_t)length;
+        enc->ew_length_field_tab[enc->ew_right * SWIF_LENGTH_FIELD_SIZE] = (uint8_t)(length >> 8);
+        enc->ew_length_field_tab[enc->ew_right * SWIF_LENGTH_FIELD_SIZE + 1] = (uint8_t)length;
+    }
+    if(enc->nb_acc > 0)
+    {
+        rlc_encoder_accumulate_source_symbol(enc, enc->ew_right, new_src_symbol_esi);
+    }
+    if(enc->nb_standing > 0)
+    {
+        rlc_encoder_update_standing_repairs(enc, enc->ew_right, new_src_symbol_esi);
+    }
+    rlc_encoder_start_speculation(enc);
     return SWIF_STATUS_OK;
 }
 
+/**
+ * Add this source symbol to the coding window.
+ * Encoder:     add a source symbol to the coding window.
+ * Decoder:     add a source symbol to the coding window under preparation.
+ */
+swif_status_t swif_rlc_encoder_add_source_symbol_to_coding_window(swif_encoder_t *generic_enc,
+                                                                  void *new_src_symbol_buf,
+                                                                  esi_t new_src_symbol_esi)
+{
+    swif_encoder_rlc_cb_t *enc = (swif_encoder_rlc_cb_t *)generic_enc;
+
+    if(enc->ew_length_tab != NULL)
+    {
+        fprintf(stderr, "swif_rlc_encoder_add_source_symbol_to_coding_window() failed! source "
+                        "symbols have variable lengths\n");
+        return SWIF_STATUS_ERROR;
+    }
+    return rlc_encoder_add_source_symbol(enc, new_src_symbol_buf, enc->symbol_size,
+                                         new_src_symbol_esi);
+}
+
+/**
+ * Encoder: add a source symbol of its own length to the coding window,
+ * with variable length source symbols.
+ */
+swif_status_t swif_rlc_encoder_add_variable_length_source_symbol_to_coding_window(
+    swif_encoder_t *generic_enc, void *new_src_symbol_buf, uint32_t new_src_symbol_length,
+    esi_t new_src_symbol_esi)
+{
+    swif_encoder_rlc_cb_t *enc = (swif_encoder_rlc_cb_t *)generic_enc;
+
+    if(enc->ew_length_tab == NULL
+       || new_src_symbol_length > enc->symbol_size - SWIF_LENGTH_FIELD_SIZE)
+    {
+        fprintf(stderr, "swif_rlc_encoder_add_variable_length_source_symbol_to_coding_window() "
+                        "failed! variable length source symbols not enabled, or bad length "
+                        "(%u)\n", new_src_symbol_length);
+        return SWIF_STATUS_ERROR;
+    }
+    return rlc_encoder_add_source_symbol(enc, new_src_symbol_buf, new_src_symbol_length,
+                                         new_src_symbol_esi);
+}
+
 swif_status_t swif_rlc_decoder_add_source_symbol_to_coding_window(swif_decoder_t *dec,
                                                                   esi_t new_src_symbol_esi)
 {
-    // NOT YET
     swif_decoder_rlc_cb_t *rlc_dec = (swif_decoder_rlc_cb_t *)dec;
 
     if(rlc_dec->first_id == SYMBOL_ID_NONE)
@@ -316,7 +2046,7 @@ swif_status_t swif_rlc_decoder_add_source_symbol_to_coding_window(swif_decoder_t
         assert(rlc_dec->nb_id == 0);
         rlc_dec->first_id = new_src_symbol_esi;
     }
-    if((new_src_symbol_esi - rlc_dec->first_id) <= rlc_dec->max_coding_window_size)
+    if((new_src_symbol_esi - rlc_dec->first_id) < rlc_dec->max_coding_window_size)
     {
 
         // rlc_dec->coef_tab[new_src_symbol_esi - rlc_dec->first_id] = coef;
@@ -332,18 +2062,40 @@ swif_status_t swif_rlc_decoder_add_source_symbol_to_coding_window(swif_decoder_t
 
 /**
  * Remove this source symbol from the coding window.
+ * Encoder: the coding window has no gap, so only its oldest source symbol
+ * can be removed (e.g. once acknowledged).
  */
-swif_status_t swif_rlc_encoder_remove_source_symbol_from_coding_window(swif_encoder_t *enc,
+swif_status_t swif_rlc_encoder_remove_source_symbol_from_coding_window(swif_encoder_t *generic_enc,
                                                                        esi_t old_src_symbol_esi)
 {
-    // NOT YET
+    swif_encoder_rlc_cb_t *enc = (swif_encoder_rlc_cb_t *)generic_enc;
+
+    if(enc->ew_ss_nb == 0 || old_src_symbol_esi != RLC_ENCODER_FIRST_ESI(enc))
+    {
+        fprintf(stderr,
+                "swif_rlc_encoder_remove_source_symbol_from_coding_window() failed! "
+                "old_src_symbol_esi (%u) is not the first one of the coding window (%u, %u "
+                "source symbols)\n",
+                old_src_symbol_esi, RLC_ENCODER_FIRST_ESI(enc), enc->ew_ss_nb);
+        return SWIF_STATUS_ERROR;
+    }
+    rlc_encoder_cancel_speculation(enc);
+    rlc_encoder_remove_oldest_source_symbol(enc);
+    rlc_encoder_start_speculation(enc);
     return SWIF_STATUS_OK;
 }
 
+/**
+ * Decoder: the source symbol is removed from the linear system (e.g. its
+ * deadline has passed). Its column is projected out, the system slides when
+ * it is the oldest source symbol, and later symbols including it are ignored.
+ */
 swif_status_t swif_rlc_decoder_remove_source_symbol_from_coding_window(swif_decoder_t *dec,
                                                                        esi_t old_src_symbol_esi)
 {
-    // NOT YET
+    swif_decoder_rlc_cb_t *rlc_dec = (swif_decoder_rlc_cb_t *)dec;
+
+    full_symbol_set_remove_id(rlc_dec->symbol_set, (symbol_id_t)old_src_symbol_esi);
     return SWIF_STATUS_OK;
 }
 
@@ -381,6 +2133,8 @@ swif_status_t swif_rlc_encoder_set_coding_coefs_tab(swif_encoder_t *enc,
     swif_encoder_rlc_cb_t *rlc_enc = (swif_encoder_rlc_cb_t *)enc;
     assert(nb_coefs_in_tab <= rlc_enc->max_coding_window_size);
     memcpy(rlc_enc->cc_tab, coding_coefs_tab, nb_coefs_in_tab * sizeof(uint8_t));
+    rlc_enc->cc_atlas_tab = NULL;
+    rlc_enc->cc_is_generated = false;
     return SWIF_STATUS_OK;
 }
 
@@ -408,6 +2162,8 @@ swif_rlc_encoder_generate_coding_coefs(swif_encoder_t *enc, uint32_t key, uint8_
     /* XXX: check why uint32_t key */
     DEBUG_PRINT("generate coding coefs: ");
     swif_encoder_rlc_cb_t *rlc_enc = (swif_encoder_rlc_cb_t *)enc;
+    const uint8_t *cc_tab;
+    uint64_t start;
 
     if(rlc_enc->cc_tab == NULL)
     {
@@ -422,9 +2178,17 @@ swif_rlc_encoder_generate_coding_coefs(swif_encoder_t *enc, uint32_t key, uint8_
     }
 
     assert(rlc_enc->ew_ss_nb <= rlc_enc->max_coding_window_size);
-    swif_rlc_generate_coding_coefficients((uint16_t)key, rlc_enc->cc_tab,
-                                          rlc_enc->ew_ss_nb, /* upper bound: enc->max_window_size */
-                                          dt /* density dt [0-15] XXX dt=1*/, 8 /*=m - GF(2^^m) */);
+    start = rlc_read_cycles();
+    cc_tab = rlc_generate_coding_coefficients(enc->codepoint, rlc_enc->coefs_atlas,
+                                              rlc_enc->coefs_cache, (uint16_t)key,
+                                              RLC_ENCODER_FIRST_ESI(rlc_enc), rlc_enc->cc_tab,
+                                              rlc_enc->ew_ss_nb, /* upper bound: enc->max_window_size */
+                                              dt /* density dt [0-15] XXX dt=1*/);
+    rlc_enc->stats.coefs_cycles += rlc_read_cycles() - start;
+    rlc_enc->cc_atlas_tab = (cc_tab != rlc_enc->cc_tab) ? cc_tab : NULL;
+    rlc_enc->cc_is_generated = true;
+    rlc_enc->cc_key = key;
+    rlc_enc->cc_dt = dt;
 
     return SWIF_STATUS_OK;
 }
@@ -436,6 +2200,7 @@ swif_rlc_decoder_generate_coding_coefs(swif_decoder_t *dec, uint32_t key, uint8_
     /* XXX: check why uint32_t key */
     DEBUG_PRINT("generate coding coefs: ");
     swif_decoder_rlc_cb_t *rlc_dec = (swif_decoder_rlc_cb_t *)dec;
+    const uint8_t *coef_tab;
     if(rlc_dec->coef_tab == NULL)
     {
         /* XXX: need to use allocation functions */
@@ -449,10 +2214,13 @@ swif_rlc_decoder_generate_coding_coefs(swif_decoder_t *dec, uint32_t key, uint8_
     }
 
     assert(rlc_dec->nb_id <= rlc_dec->max_coding_window_size);
-    swif_rlc_generate_coding_coefficients((uint16_t)key, rlc_dec->coef_tab,
-                                          rlc_dec->nb_id, /* upper bound: enc->max_window_size */
-                                          dt /* density dt [0-15] XXX dt=1*/, 8 /*=m - GF(2^^m) */);
-    DEBUG_DUMP(rlc_dec->coef_tab, rlc_dec->nb_id);
+    coef_tab = rlc_generate_coding_coefficients(dec->codepoint, rlc_dec->coefs_atlas,
+                                                rlc_dec->coefs_cache, (uint16_t)key,
+                                                rlc_dec->first_id, rlc_dec->coef_tab,
+                                                rlc_dec->nb_id, /* upper bound: enc->max_window_size */
+                                                dt /* density dt [0-15] XXX dt=1*/);
+    rlc_dec->coef_atlas_tab = (coef_tab != rlc_dec->coef_tab) ? coef_tab : NULL;
+    DEBUG_DUMP((uint8_t *)coef_tab, rlc_dec->nb_id);
     return SWIF_STATUS_OK;
 }
 
@@ -487,7 +2255,15 @@ swif_encoder_t *swif_rlc_encoder_create(swif_codepoint_t codepoint,
     swif_encoder_rlc_cb_t *enc;
 
     /* initialize the encoder */
-    assert(codepoint == SWIF_CODEPOINT_RLC_GF_256_FULL_DENSITY_CODEC);
+    assert(codepoint == SWIF_CODEPOINT_RLC_GF_256_FULL_DENSITY_CODEC
+           || codepoint == SWIF_CODEPOINT_RLC_GF_256_VANDERMONDE_CODEC);
+    if(codepoint == SWIF_CODEPOINT_RLC_GF_256_VANDERMONDE_CODEC
+       && max_coding_window_size > SWIF_VANDERMONDE_MAX_CODING_WINDOW_SIZE)
+    {
+        fprintf(stderr, "swif_encoder_create() failed! max_coding_window_size (%u) is above "
+                        "SWIF_VANDERMONDE_MAX_CODING_WINDOW_SIZE\n", max_coding_window_size);
+        return NULL;
+    }
     if((enc = calloc(1, sizeof(swif_encoder_rlc_cb_t))) == NULL)
     {
         fprintf(stderr, "swif_encoder_create() failed! No memory \n");
@@ -496,17 +2272,17 @@ swif_encoder_t *swif_rlc_encoder_create(swif_codepoint_t codepoint,
     enc->generic_encoder.codepoint = codepoint;
     enc->symbol_size = symbol_size;
     enc->max_coding_window_size = max_coding_window_size;
-    if((enc->cc_tab = calloc(max_coding_window_size, sizeof(uint8_t))) == NULL)
+    if((enc->cc_tab = calloc(max_coding_window_size, sizeof(uint8_t))) == NULL ||
+       (enc->ew_tab = calloc(max_coding_window_size, sizeof(uintptr_t))) == NULL ||
+       (enc->data_op_tab = calloc(max_coding_window_size + 1, sizeof(full_symbol_data_op_t))) == NULL ||
+       (enc->batch_cc_tab = calloc(max_coding_window_size, sizeof(uint8_t))) == NULL)
     {
-        fprintf(stderr, "swif_encoder_create cc_tab failed! No memory \n");
-        return NULL;
-    }
-
-    if((enc->ew_tab = calloc(max_coding_window_size, sizeof(uintptr_t))) == NULL)
-    {
-        fprintf(stderr, "swif_encoder_create ew_tab failed! No memory \n");
+        fprintf(stderr, "swif_encoder_create() failed! No memory \n");
+        swif_rlc_encoder_release((swif_encoder_t *)enc);
         return NULL;
     }
+    enc->nb_repair_data_op = 1;
+    enc->repair_size = symbol_size;
     enc->ew_right = enc->ew_left = 0;
     enc->ew_esi_right = INVALID_ESI;
     enc->ew_ss_nb = 0;
@@ -528,6 +2304,11 @@ swif_encoder_t *swif_rlc_encoder_create(swif_codepoint_t codepoint,
     enc->generic_encoder.set_coding_coefs_tab = swif_rlc_encoder_set_coding_coefs_tab;
     enc->generic_encoder.generate_coding_coefs = swif_rlc_encoder_generate_coding_coefs;
     enc->generic_encoder.get_coding_coefs_tab = swif_rlc_encoder_get_coding_coefs_tab;
+    enc->generic_encoder.build_repair_symbols = swif_rlc_build_repair_symbols;
+    enc->generic_encoder.release_repair_buffer = swif_rlc_encoder_release_repair_buffer;
+    enc->generic_encoder.precommit_repair_key = swif_rlc_encoder_precommit_repair_key;
+    enc->generic_encoder.add_variable_length_source_symbol_to_coding_window =
+        swif_rlc_encoder_add_variable_length_source_symbol_to_coding_window;
     return (swif_encoder_t *)enc;
 }
 
@@ -543,7 +2324,15 @@ swif_decoder_t *swif_rlc_decoder_create(swif_codepoint_t codepoint,
     swif_decoder_rlc_cb_t *dec;
 
     /* initialize the decoder */
-    assert(codepoint == SWIF_CODEPOINT_RLC_GF_256_FULL_DENSITY_CODEC);
+    assert(codepoint == SWIF_CODEPOINT_RLC_GF_256_FULL_DENSITY_CODEC
+           || codepoint == SWIF_CODEPOINT_RLC_GF_256_VANDERMONDE_CODEC);
+    if(codepoint == SWIF_CODEPOINT_RLC_GF_256_VANDERMONDE_CODEC
+       && max_coding_window_size > SWIF_VANDERMONDE_MAX_CODING_WINDOW_SIZE)
+    {
+        fprintf(stderr, "swif_decoder_create() failed! max_coding_window_size (%u) is above "
+                        "SWIF_VANDERMONDE_MAX_CODING_WINDOW_SIZE\n", max_coding_window_size);
+        return NULL;
+    }
     if((dec = calloc(1, sizeof(swif_decoder_rlc_cb_t))) == NULL)
     {
         fprintf(stderr, "swif_decoder_create() failed! No memory \n");
@@ -553,7 +2342,27 @@ swif_decoder_t *swif_rlc_decoder_create(swif_codepoint_t codepoint,
     dec->symbol_size = symbol_size;
     dec->max_coding_window_size = max_coding_window_size;
     dec->max_linear_system_size = max_linear_system_size;
-    dec->symbol_set = full_symbol_set_alloc();
+    if(max_linear_system_size != 0 && max_linear_system_size < max_coding_window_size)
+    {
+        fprintf(stderr, "swif_decoder_create() failed! max_linear_system_size (%u) must be at "
+                        "least max_coding_window_size (%u)\n",
+                max_linear_system_size, max_coding_window_size);
+        free(dec);
+        return NULL;
+    }
+#ifdef WITH_FIXED_CAPACITY_DECODER
+    bool fixed_capacity = (max_linear_system_size != 0);
+#else
+    bool fixed_capacity = false;
+#endif
+    if((dec->symbol_set = rlc_decoder_alloc_symbol_set(dec, fixed_capacity)) == NULL ||
+       (dec->coef_tab = calloc(max_coding_window_size, sizeof(uint8_t))) == NULL)
+    {
+        fprintf(stderr, "swif_decoder_create() failed! No memory \n");
+        swif_rlc_decoder_release((swif_decoder_t *)dec);
+        return NULL;
+    }
+    dec->first_id = SYMBOL_ID_NONE;
 #if 0
     dec->ew_right = dec->ew_left = 0;
     dec->ew_esi_right = INVALID_ESI;
@@ -566,12 +2375,19 @@ swif_decoder_t *swif_rlc_decoder_create(swif_codepoint_t codepoint,
     dec->context_4_callback = NULL;
 
     dec->generic_decoder.set_callback_functions = swif_rlc_decoder_set_callback_functions;
+    dec->generic_decoder.make_progress = swif_rlc_decoder_make_progress;
+    dec->generic_decoder.snapshot = swif_rlc_decoder_snapshot;
+    dec->generic_decoder.restore = swif_rlc_decoder_restore;
     dec->generic_decoder.set_parameters = swif_rlc_decoder_set_parameters;
     dec->generic_decoder.get_parameters = swif_rlc_decoder_get_parameters;
     dec->generic_decoder.decode_with_new_source_symbol =
         swif_rlc_decoder_decode_with_new_source_symbol;
     dec->generic_decoder.decode_with_new_repair_symbol =
         swif_rlc_decoder_decode_with_new_repair_symbol;
+    dec->generic_decoder.decode_with_new_variable_length_source_symbol =
+        swif_rlc_decoder_decode_with_new_variable_length_source_symbol;
+    dec->generic_decoder.decode_with_new_variable_length_repair_symbol =
+        swif_rlc_decoder_decode_with_new_variable_length_repair_symbol;
     dec->generic_decoder.reset_coding_window = swif_rlc_decoder_reset_coding_window;
     dec->generic_decoder.add_source_symbol_to_coding_window =
         swif_rlc_decoder_add_source_symbol_to_coding_window;
@@ -55,6 +55,34 @@ swif_status_t   swif_rlc_build_repair_symbol (
                                 swif_encoder_t* generic_encoder,
                                 void**           new_buf);
 
+/**
+ * Give back a repair symbol buffer allocated by the encoder, for reuse.
+ */
+swif_status_t   swif_rlc_encoder_release_repair_buffer (
+                                swif_encoder_t* generic_encoder,
+                                void*           buf);
+
+/**
+ * Create several repair symbols at once, with a single pass over the
+ * source symbols of the coding window.
+ */
+swif_status_t   swif_rlc_build_repair_symbols (
+                                swif_encoder_t* generic_encoder,
+                                uint32_t*       keys,
+                                uint8_t         dt,
+                                uint32_t        nb_repair,
+                                void**          new_bufs);
+
+/**
+ * Announce a repair symbol built later, computed as its source symbols
+ * are added to the coding window.
+ */
+swif_status_t   swif_rlc_encoder_precommit_repair_key (
+                                swif_encoder_t* generic_encoder,
+                                uint32_t        key,
+                                uint8_t         dt,
+                                esi_t           last_esi);
+
 
 /*******************************************************************************
  * Decoder functions
@@ -131,6 +159,54 @@ swif_status_t   swif_rlc_decoder_decode_with_new_repair_symbol (
                                 void* const     new_symbol_buf,
                                 esi_t           new_symbol_esi);
 
+
+/**
+ * Same as swif_rlc_decoder_decode_with_new_source_symbol(), for a source
+ * symbol of its own length.
+ */
+swif_status_t   swif_rlc_decoder_decode_with_new_variable_length_source_symbol (
+                                swif_decoder_t* dec,
+                                void* const     new_symbol_buf,
+                                uint32_t        new_symbol_length,
+                                esi_t           new_symbol_esi);
+
+
+/**
+ * Same as swif_rlc_decoder_decode_with_new_repair_symbol(), for a repair
+ * symbol of less than symbol_size bytes.
+ */
+swif_status_t   swif_rlc_decoder_decode_with_new_variable_length_repair_symbol (
+                                swif_decoder_t* dec,
+                                void* const     new_symbol_buf,
+                                uint32_t        new_symbol_size,
+                                esi_t           new_symbol_esi);
+
+
+/**
+ * Go on with the decoding work queued because of the elimination budget.
+ */
+swif_status_t   swif_rlc_decoder_make_progress (
+                                swif_decoder_t* dec,
+                                uint32_t        budget);
+
+
+/**
+ * Save the state of the decoder in a compact binary buffer.
+ */
+swif_status_t   swif_rlc_decoder_snapshot (
+                                swif_decoder_t* dec,
+                                void*           snapshot_buf,
+                                uint32_t*       snapshot_size);
+
+
+/**
+ * Restore a state saved by swif_rlc_decoder_snapshot().
+ */
+swif_status_t   swif_rlc_decoder_restore (
+                                swif_decoder_t* dec,
+                                const void*     snapshot_buf,
+                                uint32_t        snapshot_size);
+
 /*******************************************************************************
  * Coding Window Functions at an Encoder and Decoder
  */
@@ -162,6 +238,15 @@ swif_status_t   swif_rlc_decoder_add_source_symbol_to_coding_window (
                                 swif_decoder_t* dec,
                                 esi_t           new_src_symbol_esi);
 
+/**
+ * Encoder: add this source symbol, of its own length, to the coding window.
+ */
+swif_status_t   swif_rlc_encoder_add_variable_length_source_symbol_to_coding_window (
+                                swif_encoder_t* generic_enc,
+                                void*           new_src_symbol_buf,
+                                uint32_t        new_src_symbol_length,
+                                esi_t           new_src_symbol_esi);
+
 
 /**
  * Remove this source symbol from the coding window.
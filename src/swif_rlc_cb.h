@@ -5,6 +5,47 @@
 
 #include "swif_full_symbol.h"
 
+/**
+ * A repair symbol being built as its source symbols enter the coding
+ * window, see swif_encoder_precommit_repair_key().
+ */
+typedef struct swif_rlc_repair_accumulator {
+	uint32_t		key;
+	uint8_t			dt;
+	/* its coding window */
+	esi_t			first_esi;
+	esi_t			last_esi;
+	/* last_esi - first_esi + 1 coding coefficients (room for
+	   max_coding_window_size, kept from one repair symbol to the next) */
+	uint8_t*		cc_tab;
+	/* the source symbols added so far, combined */
+	void*			buf;
+} swif_rlc_repair_accumulator_t;
+
+/**
+ * A repair symbol kept up to date with the coding window (as source
+ * symbols enter and leave it), see swif_ENCODER_SET_PARAM_STANDING_REPAIR_KEYS.
+ */
+typedef struct swif_rlc_standing_repair {
+	uint32_t		key;
+	/* the source symbols of the coding window, combined */
+	void*			buf;
+} swif_rlc_standing_repair_t;
+
+/**
+ * A repair symbol built in the background by the helper thread, for the
+ * coding window it started with, see swif_ENCODER_SET_PARAM_SPECULATIVE_REPAIRS.
+ */
+typedef struct swif_rlc_speculative_repair {
+	uint32_t		key;
+	uint8_t			dt;
+	/* handed over to the application */
+	bool			taken;
+	void*			buf;
+	/* work of the helper thread, not yet in the encoder statistics */
+	swif_encoder_stats_t	stats;
+} swif_rlc_speculative_repair_t;
+
 /**
  * Control block for an RLC encoder.
  * Encoder structure that contains whatever is needed for encoding.
@@ -48,11 +89,101 @@ typedef struct swif_encoder_rlc_cb {
 	*/
 	uint32_t 		ew_ss_nb;
 
+	/* when the source symbols are copied in (see
+	 * swif_ENCODER_SET_PARAM_COPY_SOURCE_SYMBOLS): the ring holding
+	 * them, ew_tab[i] pointing to its i-th slot of ew_data_stride bytes */
+	uint8_t*		ew_data;
+	uint32_t		ew_data_stride;
+
+	/* variable length source symbols (see
+	 * swif_ENCODER_SET_PARAM_VARIABLE_LENGTH_SOURCE_SYMBOLS): the length
+	 * of each source symbol of the ring, and its length field within the
+	 * code (SWIF_LENGTH_FIELD_SIZE bytes each). NULL otherwise */
+	uint16_t*		ew_length_tab;
+	uint8_t*		ew_length_field_tab;
+
+	/* size of the last repair symbol built, the rest being zeros (see
+	 * swif_ENCODER_GET_PARAM_REPAIR_SYMBOL_SIZE) */
+	uint32_t		repair_size;
+
 	void (*source_symbol_removed_from_coding_window_callback) (
                                         void*   context,
                                         esi_t   old_symbol_esi);
 
 	void*			context_4_callback;
+
+	/* key and density of the coefficients of cc_tab, when they were
+	 * generated by the codec rather than set by the application */
+	bool			cc_is_generated;
+	uint32_t		cc_key;
+	uint8_t			cc_dt;
+
+	/* precommitted repair symbols (in no particular order) */
+	swif_rlc_repair_accumulator_t* acc_tab;
+	uint32_t		nb_acc;
+	uint32_t		acc_capacity;
+
+	/* standing repair symbols (SWIF_CODEPOINT_RLC_GF_256_VANDERMONDE_CODEC) */
+	swif_rlc_standing_repair_t* standing_tab;
+	uint32_t		nb_standing;
+
+	/* the operations building repair symbols, one per non null
+	 * coefficient (max_coding_window_size per repair symbol), followed
+	 * by room for the destination of each repair symbol */
+	full_symbol_data_op_t*	data_op_tab;
+	uint32_t		nb_repair_data_op;
+
+	/* coding coefficients of swif_build_repair_symbols(), by repair
+	 * symbol (max_coding_window_size each, nb_repair_data_op of them) */
+	uint8_t*		batch_cc_tab;
+
+	/* repair symbol buffers given back by the application, to be
+	 * reused (see swif_encoder_release_repair_buffer) */
+	void**			free_buf_tab;
+	uint32_t		nb_free_buf;
+	uint32_t		free_buf_capacity;
+	/* buffers of the pool currently held by the application (or by
+	 * precommitted repair symbols), and the highest number of them */
+	uint32_t		nb_buf_in_use;
+	uint32_t		max_nb_buf_in_use;
+
+	/* coding coefficients cache (or NULL), see
+	 * swif_ENCODER_SET_PARAM_COEFS_CACHE */
+	swif_coefs_cache_t*	coefs_cache;
+
+	/* coefficient atlas (or NULL), see swif_ENCODER_SET_PARAM_COEFS_ATLAS,
+	 * and the coefficients in it to use instead of cc_tab (or NULL) */
+	swif_coefs_atlas_t*	coefs_atlas;
+	const uint8_t*		cc_atlas_tab;
+
+	/* threads sharing the building of a repair symbol (NULL when there
+	 * is only one), see swif_ENCODER_SET_PARAM_NB_THREADS */
+	swif_workers_t*		workers;
+
+	/* speculative repair symbols (see swif_ENCODER_SET_PARAM_SPECULATIVE_REPAIRS):
+	 * the helper thread (NULL when disabled) builds up to nb_spec_max of
+	 * them, those of the keys following the last one used. The nb_spec
+	 * of the current job, for the coding window of spec_ss_nb source
+	 * symbols starting at spec_first_esi (ew_left in the ring), are only
+	 * read by the main thread once done (see swif_speculator_wait()) */
+	swif_speculator_t*	speculator;
+	swif_rlc_speculative_repair_t* spec_tab;
+	uint32_t		nb_spec_max;
+	uint32_t		nb_spec;
+	bool			spec_has_key;
+	uint32_t		spec_next_key;
+	uint8_t			spec_dt;
+	esi_t			spec_first_esi;
+	uint32_t		spec_ew_left;
+	uint32_t		spec_ss_nb;
+	/* coefficients and operations of the helper thread */
+	uint8_t*		spec_cc_tab;
+	full_symbol_data_op_t*	spec_op_tab;
+	swif_encoder_speculation_stats_t spec_stats;
+
+	/* see swif_ENCODER_GET_PARAM_ENCODER_STATISTICS (the repair buffer
+	 * pool figures are set when they are asked for) */
+	swif_encoder_stats_t	stats;
 	/* add whatever may be needed hereafter... */
 } swif_encoder_rlc_cb_t;
 
@@ -78,8 +209,8 @@ typedef struct swif_decoder_rlc_cb {
 	/* max. number of source symbols kepts in current linear system.
 	 * If the linear system grows above this limit, old source
 	 * symbols in excess are removed and the application callback
-	 * called. This value should be larger than the
-	 * max_coding_window_size. */
+	 * called. This value must be larger than the
+	 * max_coding_window_size, or 0 for no limit. */
 	uint32_t		max_linear_system_size;
 
 	/* exact size (in bytes) of any source or repair symbol */
@@ -88,6 +219,28 @@ typedef struct swif_decoder_rlc_cb {
 	/* set of packets being decoded through gaussian elimination */
         swif_full_symbol_set_t *symbol_set;
 
+	/* source symbol buffers are referenced rather than copied, see
+	 * swif_DECODER_SET_PARAM_ZERO_COPY_SOURCE_SYMBOLS */
+	bool			zero_copy_source_symbols;
+
+	/* variable length source symbols (see
+	 * swif_DECODER_SET_PARAM_VARIABLE_LENGTH_SOURCE_SYMBOLS): where a
+	 * source symbol is put in its form within the code. NULL otherwise */
+	uint8_t*		variable_length_buf;
+
+	/* threads sharing the operations on the symbols (NULL when there
+	 * is only one), see swif_DECODER_SET_PARAM_NB_THREADS */
+	swif_workers_t*		workers;
+
+	/* coding coefficients cache (or NULL), see
+	 * swif_DECODER_SET_PARAM_COEFS_CACHE */
+	swif_coefs_cache_t*	coefs_cache;
+
+	/* coefficient atlas (or NULL), see swif_DECODER_SET_PARAM_COEFS_ATLAS,
+	 * and the coefficients in it to use instead of coef_tab (or NULL) */
+	swif_coefs_atlas_t*	coefs_atlas;
+	const uint8_t*		coef_atlas_tab;
+
 	/* coding coefficients table. To be initialized before building a new repair symbol */
 	uint8_t*		coef_tab;
 	/* the index of the first source symbol (included) */
@@ -0,0 +1,211 @@
+/**
+ * SWiF Codec: an open-source sliding window FEC codec in C
+ * https://github.com/irtf-nwcrg/swif-codec
+ */
+
+/*---------------------------------------------------------------------------*/
+
+#ifdef WITH_THREADS
+#define _POSIX_C_SOURCE 200809L
+#include <pthread.h>
+#endif
+
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include "swif_speculator.h"
+
+/*---------------------------------------------------------------------------*/
+
+#ifdef WITH_THREADS
+
+struct s_swif_speculator_t {
+    pthread_t               thread;
+    swif_speculation_func_t func;
+    void                   *context;
+
+    pthread_mutex_t mutex;
+    pthread_cond_t  work_cond; /* a new job, or stop */
+    pthread_cond_t  done_cond; /* a step done, or the job ended */
+
+    bool     pending;  /* started, not yet picked by the thread */
+    bool     running;  /* picked, not yet ended */
+    bool     cancel;
+    bool     stop;
+    uint32_t nb_step;  /* of the current (or last) job */
+};
+
+static void *swif_speculator_main(void *arg)
+{
+    swif_speculator_t *spec = (swif_speculator_t *)arg;
+
+    pthread_mutex_lock(&spec->mutex);
+    for(;;)
+    {
+        while(!spec->stop && !spec->pending)
+        {
+            pthread_cond_wait(&spec->work_cond, &spec->mutex);
+        }
+        if(spec->stop)
+        {
+            break;
+        }
+        spec->pending = false;
+        spec->running = true;
+        pthread_mutex_unlock(&spec->mutex);
+
+        spec->func(spec, spec->context);
+
+        pthread_mutex_lock(&spec->mutex);
+        spec->running = false;
+        pthread_cond_broadcast(&spec->done_cond);
+    }
+    pthread_mutex_unlock(&spec->mutex);
+    return NULL;
+}
+
+swif_speculator_t *swif_speculator_create(swif_speculation_func_t func, void *context)
+{
+    swif_speculator_t *spec = (swif_speculator_t *)calloc(1, sizeof(swif_speculator_t));
+
+    if(spec == NULL)
+    {
+        return NULL;
+    }
+    spec->func = func;
+    spec->context = context;
+    pthread_mutex_init(&spec->mutex, NULL);
+    pthread_cond_init(&spec->work_cond, NULL);
+    pthread_cond_init(&spec->done_cond, NULL);
+    if(pthread_create(&spec->thread, NULL, swif_speculator_main, spec) != 0)
+    {
+        fprintf(stderr, "swif_speculator_create: cannot start the thread\n");
+        pthread_cond_destroy(&spec->done_cond);
+        pthread_cond_destroy(&spec->work_cond);
+        pthread_mutex_destroy(&spec->mutex);
+        free(spec);
+        return NULL;
+    }
+    return spec;
+}
+
+void swif_speculator_free(swif_speculator_t *spec)
+{
+    if(spec == NULL)
+    {
+        return;
+    }
+    pthread_mutex_lock(&spec->mutex);
+    spec->cancel = true;
+    spec->stop = true;
+    pthread_cond_signal(&spec->work_cond);
+    pthread_mutex_unlock(&spec->mutex);
+    pthread_join(spec->thread, NULL);
+    pthread_cond_destroy(&spec->done_cond);
+    pthread_cond_destroy(&spec->work_cond);
+    pthread_mutex_destroy(&spec->mutex);
+    free(spec);
+}
+
+void swif_speculator_start(swif_speculator_t *spec)
+{
+    pthread_mutex_lock(&spec->mutex);
+    spec->pending = true;
+    spec->cancel = false;
+    spec->nb_step = 0;
+    pthread_cond_signal(&spec->work_cond);
+    pthread_mutex_unlock(&spec->mutex);
+}
+
+uint32_t swif_speculator_cancel(swif_speculator_t *spec)
+{
+    uint32_t nb_step;
+
+    pthread_mutex_lock(&spec->mutex);
+    /* not yet picked: it never runs */
+    spec->pending = false;
+    spec->cancel = true;
+    while(spec->running)
+    {
+        pthread_cond_wait(&spec->done_cond, &spec->mutex);
+    }
+    nb_step = spec->nb_step;
+    pthread_mutex_unlock(&spec->mutex);
+    return nb_step;
+}
+
+uint32_t swif_speculator_wait(swif_speculator_t *spec, uint32_t nb_step)
+{
+    uint32_t nb_done;
+
+    pthread_mutex_lock(&spec->mutex);
+    while((spec->pending || spec->running) && spec->nb_step < nb_step)
+    {
+        pthread_cond_wait(&spec->done_cond, &spec->mutex);
+    }
+    nb_done = spec->nb_step;
+    pthread_mutex_unlock(&spec->mutex);
+    return nb_done;
+}
+
+void swif_speculator_step_done(swif_speculator_t *spec)
+{
+    pthread_mutex_lock(&spec->mutex);
+    spec->nb_step++;
+    pthread_cond_broadcast(&spec->done_cond);
+    pthread_mutex_unlock(&spec->mutex);
+}
+
+bool swif_speculator_is_cancelled(swif_speculator_t *spec)
+{
+    bool cancel;
+
+    pthread_mutex_lock(&spec->mutex);
+    cancel = spec->cancel;
+    pthread_mutex_unlock(&spec->mutex);
+    return cancel;
+}
+
+#else /* WITH_THREADS */
+
+struct s_swif_speculator_t {
+    uint32_t nb_step;
+};
+
+swif_speculator_t *swif_speculator_create(swif_speculation_func_t func, void *context)
+{
+    fprintf(stderr, "swif_speculator_create: not built WITH_THREADS\n");
+    return NULL;
+}
+
+void swif_speculator_free(swif_speculator_t *spec)
+{
+    free(spec);
+}
+
+void swif_speculator_start(swif_speculator_t *spec)
+{
+}
+
+uint32_t swif_speculator_cancel(swif_speculator_t *spec)
+{
+    return 0;
+}
+
+uint32_t swif_speculator_wait(swif_speculator_t *spec, uint32_t nb_step)
+{
+    return 0;
+}
+
+void swif_speculator_step_done(swif_speculator_t *spec)
+{
+}
+
+bool swif_speculator_is_cancelled(swif_speculator_t *spec)
+{
+    return true;
+}
+
+#endif /* WITH_THREADS */
+
+/*---------------------------------------------------------------------------*/
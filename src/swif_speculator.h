@@ -0,0 +1,89 @@
+/**
+ * @defgroup    SWiF-Codec
+ * @ingroup     swif-codec-linear
+ * @brief       an open-source sliding window FEC codec in C (linear operations)
+ * @{
+ *
+ * @file
+ * @brief       A helper thread running one job at a time in the background,
+ *              that may be cancelled (e.g. speculative work made useless).
+ *              A job is a sequence of steps, the caller may wait for the
+ *              first ones only.
+ */
+
+/**
+ * SWiF Codec:
+ * https://github.com/irtf-nwcrg/swif-codec
+ */
+
+#ifndef __SWIF_SPECULATOR_H__
+#define __SWIF_SPECULATOR_H__
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <stdbool.h>
+#include <stdint.h>
+
+/*---------------------------------------------------------------------------*/
+
+typedef struct s_swif_speculator_t swif_speculator_t;
+
+/**
+ * A job, run by the helper thread. It calls swif_speculator_step_done()
+ * after each step, and returns early when swif_speculator_is_cancelled().
+ */
+typedef void (*swif_speculation_func_t)(swif_speculator_t *spec, void *context);
+
+/**
+ * @brief Start the helper thread, running func(spec, context) for each
+ *        job. Returns NULL if the thread cannot be started, or if the
+ *        library was built without WITH_THREADS.
+ */
+swif_speculator_t *swif_speculator_create(swif_speculation_func_t func, void *context);
+
+/**
+ * @brief Cancel the current job, stop the thread and free the helper
+ */
+void swif_speculator_free(swif_speculator_t *spec);
+
+/**
+ * @brief Start a new job (there must be none running, see
+ *        swif_speculator_cancel()). What the job reads is set before.
+ */
+void swif_speculator_start(swif_speculator_t *spec);
+
+/**
+ * @brief Cancel the current job (if any) and return when it has stopped:
+ *        what it was using may then be modified. Returns the number of
+ *        steps it did.
+ */
+uint32_t swif_speculator_cancel(swif_speculator_t *spec);
+
+/**
+ * @brief Wait until the current job has done nb_step steps, or has ended.
+ *        Returns the number of steps done (those are visible to the
+ *        caller).
+ */
+uint32_t swif_speculator_wait(swif_speculator_t *spec, uint32_t nb_step);
+
+/**
+ * @brief For the job: one more step done
+ */
+void swif_speculator_step_done(swif_speculator_t *spec);
+
+/**
+ * @brief For the job: true when it should return as soon as possible
+ */
+bool swif_speculator_is_cancelled(swif_speculator_t *spec);
+
+/*---------------------------------------------------------------------------*/
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __SWIF_SPECULATOR_H__ */
+/*---------------------------------------------------------------------------*/
+/** @} */
@@ -5,7 +5,9 @@
 
 /*---------------------------------------------------------------------------*/
 
+#define _POSIX_C_SOURCE 200809L /* posix_memalign */
 #include <assert.h>
+#include <stdlib.h>
 #include "swif_symbol.h"
 
 /*---------------------------------------------------------------------------*/
@@ -49,6 +51,25 @@ void symbol_add_scaled
     }
 }
 
+/**
+ * @brief Take a symbol and add another symbol multiplied by a
+ *        coefficient, e.g. performs the equivalent of:
+ *        result = p1 + coef * p2 (result may be p1)
+ * @param[in]  symbol1  First symbol (to which coef*symbol2 will be added)
+ * @param[in]  coef     Coefficient by which the second packet is multiplied
+ * @param[in]  symbol2  Second symbol
+ * @param[out] result   Symbol where the result is stored
+ */
+void symbol_add_scaled_into
+(void *symbol1, uint8_t coef, void *symbol2, uint32_t symbol_size, uint8_t* result)
+{
+    uint8_t *data1 = (uint8_t *) symbol1;
+    uint8_t *data2 = (uint8_t *) symbol2;
+    for (uint32_t i=0; i<symbol_size; i++) {
+        result[i] = data1[i] ^ gf256_mul(coef, data2[i]);
+    }
+}
+
 /**
  * @brief Take a symbol and add another symbol to it,
  *        e.g. performs the equivalent of: result = symbol1 + symbol2
@@ -117,3 +138,19 @@ void symbol_div
     }
 }
 /*---------------------------------------------------------------------------*/
+
+/**
+ * @brief Allocate a symbol (not initialized) aligned on SYMBOL_ALIGN
+ *        bytes. It is released with free().
+ */
+void *symbol_alloc_aligned(uint32_t symbol_size)
+{
+    void *result;
+
+    if (posix_memalign(&result, SYMBOL_ALIGN, symbol_size > 0 ? symbol_size : 1) != 0) {
+        return NULL;
+    }
+    return result;
+}
+
+/*---------------------------------------------------------------------------*/
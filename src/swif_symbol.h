@@ -70,6 +70,19 @@ void symbol_add_scaled
 (void *symbol1, uint8_t coef, void *symbol2, uint32_t symbol_size);
 
 
+/**
+ * @brief Take a symbol and add another symbol multiplied by a
+ *        coefficient, e.g. performs the equivalent of:
+ *        result = p1 + coef * p2 (result may be p1)
+ * @param[in]  symbol1  First symbol (to which coef*symbol2 will be added)
+ * @param[in]  coef     Coefficient by which the second packet is multiplied
+ * @param[in]  symbol2  Second symbol
+ * @param[out] result   Symbol where the result is stored
+ */
+void symbol_add_scaled_into
+(void *symbol1, uint8_t coef, void *symbol2, uint32_t symbol_size, uint8_t* result);
+
+
 /**
  * @brief Take a symbol and add another symbol to it,
  *        e.g. performs the equivalent of: result = symbol1 + symbol2
@@ -114,6 +127,18 @@ void symbol_mul
 void symbol_div
 (void *symbol1, uint32_t symbol_size, uint8_t coeff, uint8_t* result);
 
+/**
+ * Alignment (in bytes) of the symbols from symbol_alloc_aligned(): a
+ * cache line, and enough for any vector load
+ */
+#define SYMBOL_ALIGN 64
+
+/**
+ * @brief Allocate a symbol (not initialized) aligned on SYMBOL_ALIGN
+ *        bytes, or NULL if there is no memory. It is released with free().
+ */
+void *symbol_alloc_aligned(uint32_t symbol_size);
+
 
 /*---------------------------------------------------------------------------*/
 
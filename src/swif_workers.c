@@ -0,0 +1,194 @@
+/**
+ * SWiF Codec: an open-source sliding window FEC codec in C
+ * https://github.com/irtf-nwcrg/swif-codec
+ */
+
+/*---------------------------------------------------------------------------*/
+
+#ifdef WITH_THREADS
+#define _POSIX_C_SOURCE 200809L
+#include <pthread.h>
+#endif
+
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include "swif_workers.h"
+
+/*---------------------------------------------------------------------------*/
+
+#ifdef WITH_THREADS
+
+typedef struct {
+    swif_workers_t *workers;
+    uint32_t        worker_index;
+} swif_worker_arg_t;
+
+struct s_swif_workers_t {
+    uint32_t           nb_workers; /* including the calling thread */
+    uint32_t           nb_threads; /* actually started */
+    pthread_t         *thread_tab;
+    swif_worker_arg_t *arg_tab;
+
+    pthread_mutex_t mutex;
+    pthread_cond_t  work_cond; /* a new job, or stop */
+    pthread_cond_t  done_cond; /* the threads are done with the job */
+
+    /* current job: a new one increments `generation' */
+    swif_work_func_t func;
+    void            *context;
+    uint32_t         generation;
+    uint32_t         nb_running;
+    bool             stop;
+};
+
+static void *swif_worker_main(void *arg)
+{
+    swif_workers_t *workers = ((swif_worker_arg_t *)arg)->workers;
+    uint32_t worker_index = ((swif_worker_arg_t *)arg)->worker_index;
+    uint32_t generation = 0;
+
+    pthread_mutex_lock(&workers->mutex);
+    for(;;)
+    {
+        while(!workers->stop && workers->generation == generation)
+        {
+            pthread_cond_wait(&workers->work_cond, &workers->mutex);
+        }
+        if(workers->stop)
+        {
+            break;
+        }
+        generation = workers->generation;
+        swif_work_func_t func = workers->func;
+        void *context = workers->context;
+        pthread_mutex_unlock(&workers->mutex);
+
+        func(context, worker_index, workers->nb_workers);
+
+        pthread_mutex_lock(&workers->mutex);
+        workers->nb_running--;
+        if(workers->nb_running == 0)
+        {
+            pthread_cond_signal(&workers->done_cond);
+        }
+    }
+    pthread_mutex_unlock(&workers->mutex);
+    return NULL;
+}
+
+swif_workers_t *swif_workers_create(uint32_t nb_workers)
+{
+    if(nb_workers < 2)
+    {
+        return NULL;
+    }
+    swif_workers_t *workers = (swif_workers_t *)calloc(1, sizeof(swif_workers_t));
+    if(workers == NULL)
+    {
+        return NULL;
+    }
+    workers->nb_workers = nb_workers;
+    workers->thread_tab = (pthread_t *)calloc(nb_workers - 1, sizeof(pthread_t));
+    workers->arg_tab = (swif_worker_arg_t *)calloc(nb_workers - 1, sizeof(swif_worker_arg_t));
+    if(workers->thread_tab == NULL || workers->arg_tab == NULL)
+    {
+        free(workers->thread_tab);
+        free(workers->arg_tab);
+        free(workers);
+        return NULL;
+    }
+    pthread_mutex_init(&workers->mutex, NULL);
+    pthread_cond_init(&workers->work_cond, NULL);
+    pthread_cond_init(&workers->done_cond, NULL);
+    for(uint32_t i = 0; i < nb_workers - 1; i++)
+    {
+        workers->arg_tab[i].workers = workers;
+        workers->arg_tab[i].worker_index = i + 1;
+        if(pthread_create(&workers->thread_tab[i], NULL, swif_worker_main,
+                          &workers->arg_tab[i]) != 0)
+        {
+            fprintf(stderr, "swif_workers_create: cannot start thread %u\n", i + 1);
+            swif_workers_free(workers);
+            return NULL;
+        }
+        workers->nb_threads++;
+    }
+    return workers;
+}
+
+void swif_workers_free(swif_workers_t *workers)
+{
+    if(workers == NULL)
+    {
+        return;
+    }
+    pthread_mutex_lock(&workers->mutex);
+    workers->stop = true;
+    pthread_cond_broadcast(&workers->work_cond);
+    pthread_mutex_unlock(&workers->mutex);
+    for(uint32_t i = 0; i < workers->nb_threads; i++)
+    {
+        pthread_join(workers->thread_tab[i], NULL);
+    }
+    pthread_cond_destroy(&workers->done_cond);
+    pthread_cond_destroy(&workers->work_cond);
+    pthread_mutex_destroy(&workers->mutex);
+    free(workers->thread_tab);
+    free(workers->arg_tab);
+    free(workers);
+}
+
+void swif_workers_run(swif_workers_t *workers, swif_work_func_t func, void *context)
+{
+    pthread_mutex_lock(&workers->mutex);
+    workers->func = func;
+    workers->context = context;
+    workers->nb_running = workers->nb_workers - 1;
+    workers->generation++;
+    pthread_cond_broadcast(&workers->work_cond);
+    pthread_mutex_unlock(&workers->mutex);
+
+    func(context, 0, workers->nb_workers);
+
+    pthread_mutex_lock(&workers->mutex);
+    while(workers->nb_running > 0)
+    {
+        pthread_cond_wait(&workers->done_cond, &workers->mutex);
+    }
+    pthread_mutex_unlock(&workers->mutex);
+}
+
+#else /* WITH_THREADS */
+
+struct s_swif_workers_t {
+    uint32_t nb_workers;
+};
+
+swif_workers_t *swif_workers_create(uint32_t nb_workers)
+{
+    if(nb_workers >= 2)
+    {
+        fprintf(stderr, "swif_workers_create: not built WITH_THREADS\n");
+    }
+    return NULL;
+}
+
+void swif_workers_free(swif_workers_t *workers)
+{
+    free(workers);
+}
+
+void swif_workers_run(swif_workers_t *workers, swif_work_func_t func, void *context)
+{
+    func(context, 0, 1);
+}
+
+#endif /* WITH_THREADS */
+
+uint32_t swif_workers_get_nb_workers(swif_workers_t *workers)
+{
+    return workers != NULL ? workers->nb_workers : 1;
+}
+
+/*---------------------------------------------------------------------------*/
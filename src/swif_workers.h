@@ -0,0 +1,90 @@
+/**
+ * @defgroup    SWiF-Codec
+ * @ingroup     swif-codec-linear
+ * @brief       an open-source sliding window FEC codec in C (linear operations)
+ * @{
+ *
+ * @file
+ * @brief       A small pool of worker threads, reused for every job: a job
+ *              is run by all the workers at once, typically each on its own
+ *              stripe of the bytes of the symbols.
+ */
+
+/**
+ * SWiF Codec: 
+ * https://github.com/irtf-nwcrg/swif-codec
+ */
+
+#ifndef __SWIF_WORKERS_H__
+#define __SWIF_WORKERS_H__
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <stdint.h>
+
+/*---------------------------------------------------------------------------*/
+
+typedef struct s_swif_workers_t swif_workers_t;
+
+/**
+ * The work of one worker (worker_index is in [0, nb_workers))
+ */
+typedef void (*swif_work_func_t)(void *context, uint32_t worker_index, uint32_t nb_workers);
+
+/**
+ * Stripes are multiples of this (a cache line), so that two workers never
+ * write in the same cache line.
+ */
+#define SWIF_WORKERS_STRIPE_ALIGN 64
+
+/**
+ * @brief Create a pool of nb_workers workers: the calling thread is the
+ *        worker 0, and nb_workers-1 threads are started.
+ *        Returns NULL if nb_workers < 2, if the threads cannot be started,
+ *        or if the library was built without WITH_THREADS.
+ */
+swif_workers_t *swif_workers_create(uint32_t nb_workers);
+
+/**
+ * @brief Stop the threads and free the pool
+ */
+void swif_workers_free(swif_workers_t *workers);
+
+/**
+ * @brief Number of workers of the pool (including the calling thread)
+ */
+uint32_t swif_workers_get_nb_workers(swif_workers_t *workers);
+
+/**
+ * @brief Run func(context, i, nb_workers) on each worker i, and return
+ *        when all of them are done.
+ */
+void swif_workers_run(swif_workers_t *workers, swif_work_func_t func, void *context);
+
+/**
+ * @brief Get the stripe [*start, *end) of the bytes [0, size) of a worker
+ *        (possibly empty)
+ */
+static inline void swif_workers_get_stripe(uint32_t size, uint32_t worker_index,
+                                           uint32_t nb_workers, uint32_t *start, uint32_t *end)
+{
+    uint32_t stripe_size = (size + nb_workers - 1) / nb_workers;
+    stripe_size = (stripe_size + SWIF_WORKERS_STRIPE_ALIGN - 1) &
+                  ~(uint32_t)(SWIF_WORKERS_STRIPE_ALIGN - 1);
+    uint64_t stripe_start = (uint64_t)stripe_size * worker_index;
+    uint64_t stripe_end = stripe_start + stripe_size;
+    *start = stripe_start < size ? (uint32_t)stripe_start : size;
+    *end = stripe_end < size ? (uint32_t)stripe_end : size;
+}
+
+/*---------------------------------------------------------------------------*/
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __SWIF_WORKERS_H__ */
+/*---------------------------------------------------------------------------*/
+/** @} */
@@ -0,0 +1,762 @@
+#include <CUnit/Basic.h>
+#include <CUnit/CUnit.h>
+#include <string.h>
+#include <stdarg.h>
+#include <stdbool.h>
+#include "../src/swif_rlc_api.h"
+#include "../src/swif_coding_coefficients.h"
+
+#define VERBOSITY	0
+#define SYMBOL_SIZE	64
+#define NB_SOURCES	40
+
+swif_codepoint_t codepoint = SWIF_CODEPOINT_RLC_GF_256_FULL_DENSITY_CODEC;
+uint32_t	max_coding_window_size = 4;
+uint32_t	max_linear_system_size = 8;
+
+/* what the application callbacks have seen */
+esi_t	removed_tab[NB_SOURCES];
+uint32_t	nb_removed;
+bool	decoded_tab[NB_SOURCES];
+
+static void removed_callback(void *context, esi_t old_symbol_esi)
+{
+    CU_ASSERT_FATAL(nb_removed < NB_SOURCES)
+    removed_tab[nb_removed++] = old_symbol_esi;
+}
+
+static void decoded_callback(void *context, void *new_symbol_buf, esi_t esi)
+{
+    uint8_t (*src_tab)[SYMBOL_SIZE] = context;
+    CU_ASSERT_FATAL(esi < NB_SOURCES)
+    CU_ASSERT_EQUAL(memcmp(new_symbol_buf, src_tab[esi], SYMBOL_SIZE), 0)
+    decoded_tab[esi] = true;
+}
+
+/* application buffers in which the decoder directly writes decoded symbols */
+uint8_t app_buf_tab[NB_SOURCES][SYMBOL_SIZE];
+void	*decoded_buf_tab[NB_SOURCES];
+
+static void *decodable_callback(void *context, esi_t esi)
+{
+    CU_ASSERT_FATAL(esi < NB_SOURCES)
+    /* odd ESIs: let the codec allocate the buffer */
+    return (esi % 2 == 0) ? app_buf_tab[esi] : NULL;
+}
+
+static void decoded_into_app_buf_callback(void *context, void *new_symbol_buf, esi_t esi)
+{
+    decoded_callback(context, new_symbol_buf, esi);
+    decoded_buf_tab[esi] = new_symbol_buf;
+}
+
+swif_decoder_t *get_test_decoder(void *context) {
+    swif_decoder_t *dec = swif_rlc_decoder_create(codepoint, VERBOSITY, SYMBOL_SIZE,
+                                                  max_coding_window_size, max_linear_system_size);
+    CU_ASSERT_PTR_NOT_NULL_FATAL(dec)
+    CU_ASSERT_EQUAL(swif_decoder_set_callback_functions(dec, removed_callback, NULL,
+                                                        decoded_callback, context), SWIF_STATUS_OK)
+    nb_removed = 0;
+    memset(decoded_tab, 0, sizeof(decoded_tab));
+    return dec;
+}
+
+void fill_sources(uint8_t src_tab[][SYMBOL_SIZE]) {
+    for (int i = 0 ; i < NB_SOURCES ; i++)
+        for (int j = 0 ; j < SYMBOL_SIZE ; j++)
+            src_tab[i][j] = (uint8_t)(i * 31 + j * 7 + 1);
+}
+
+void test_swif_rlc_decoder_create_bad_linear_system_size(void) {
+    CU_ASSERT_PTR_NULL(swif_rlc_decoder_create(codepoint, VERBOSITY, SYMBOL_SIZE,
+                                               max_coding_window_size, max_coding_window_size - 1))
+}
+
+void test_swif_rlc_decoder_linear_system_slides() {
+    uint8_t src_tab[NB_SOURCES][SYMBOL_SIZE];
+    fill_sources(src_tab);
+    swif_decoder_t *dec = get_test_decoder(src_tab);
+    for (esi_t esi = 0 ; esi < NB_SOURCES ; esi++) {
+        CU_ASSERT_EQUAL(swif_decoder_decode_with_new_source_symbol(dec, src_tab[esi], esi), SWIF_STATUS_OK)
+    }
+    /* only the max_linear_system_size most recent symbols are kept, oldest removed first */
+    CU_ASSERT_EQUAL(nb_removed, NB_SOURCES - max_linear_system_size)
+    for (uint32_t i = 0 ; i < nb_removed ; i++)
+        CU_ASSERT_EQUAL(removed_tab[i], i)
+    swif_full_symbol_set_t *set = ((swif_decoder_rlc_cb_t *)dec)->symbol_set;
+    CU_ASSERT_EQUAL(set->nmbr_packets, max_linear_system_size)
+    CU_ASSERT_EQUAL(set->first_symbol_id, NB_SOURCES - max_linear_system_size)
+    /* a symbol older than the linear system is ignored */
+    CU_ASSERT_EQUAL(swif_decoder_decode_with_new_source_symbol(dec, src_tab[0], 0), SWIF_STATUS_OK)
+    CU_ASSERT_EQUAL(set->nmbr_packets, max_linear_system_size)
+    swif_decoder_release(dec);
+}
+
+void test_swif_rlc_decoder_decode_after_slide() {
+    uint8_t src_tab[NB_SOURCES][SYMBOL_SIZE];
+    fill_sources(src_tab);
+    swif_encoder_t *enc = swif_rlc_encoder_create(codepoint, VERBOSITY, SYMBOL_SIZE, max_coding_window_size);
+    CU_ASSERT_PTR_NOT_NULL_FATAL(enc)
+    swif_decoder_t *dec = get_test_decoder(src_tab);
+
+    for (esi_t esi = 0 ; esi < NB_SOURCES ; esi++) {
+        CU_ASSERT_EQUAL(swif_encoder_add_source_symbol_to_coding_window(enc, src_tab[esi], esi), SWIF_STATUS_OK)
+        /* every 5th source symbol is lost, and followed by a repair symbol */
+        if (esi % 5 != 2) {
+            swif_decoder_decode_with_new_source_symbol(dec, src_tab[esi], esi);
+            continue;
+        }
+        esi_t first, last;
+        uint32_t nss;
+        void *repair = NULL;
+        swif_encoder_get_coding_window_information(enc, &first, &last, &nss);
+        CU_ASSERT_EQUAL(swif_encoder_generate_coding_coefs(enc, esi, 15, 0), SWIF_STATUS_OK)
+        CU_ASSERT_EQUAL(swif_build_repair_symbol(enc, &repair), SWIF_STATUS_OK)
+        swif_decoder_reset_coding_window(dec);
+        for (esi_t i = first ; i <= last ; i++)
+            swif_decoder_add_source_symbol_to_coding_window(dec, i);
+        swif_decoder_generate_coding_coefs(dec, esi, 15, 0);
+        CU_ASSERT_EQUAL(swif_decoder_decode_with_new_repair_symbol(dec, repair, first), SWIF_STATUS_OK)
+        CU_ASSERT_TRUE(decoded_tab[esi])
+        free(repair);
+    }
+    CU_ASSERT_EQUAL(nb_removed, NB_SOURCES - max_linear_system_size)
+    swif_decoder_release(dec);
+    swif_encoder_release(enc);
+}
+
+void test_swif_rlc_decoder_vandermonde() {
+    uint8_t src_tab[NB_SOURCES][SYMBOL_SIZE];
+    uint32_t standing_keys[2] = { 4, 11 };
+    fill_sources(src_tab);
+    swif_encoder_t *enc = swif_rlc_encoder_create(SWIF_CODEPOINT_RLC_GF_256_VANDERMONDE_CODEC,
+                                                  VERBOSITY, SYMBOL_SIZE, max_coding_window_size);
+    swif_decoder_t *dec = swif_rlc_decoder_create(SWIF_CODEPOINT_RLC_GF_256_VANDERMONDE_CODEC,
+                                                  VERBOSITY, SYMBOL_SIZE, max_coding_window_size,
+                                                  max_linear_system_size);
+    CU_ASSERT_PTR_NOT_NULL_FATAL(enc)
+    CU_ASSERT_PTR_NOT_NULL_FATAL(dec)
+    swif_decoder_set_callback_functions(dec, removed_callback, NULL, decoded_callback, src_tab);
+    nb_removed = 0;
+    memset(decoded_tab, 0, sizeof(decoded_tab));
+    CU_ASSERT_EQUAL(swif_encoder_set_parameters(enc, swif_ENCODER_SET_PARAM_STANDING_REPAIR_KEYS,
+                                                sizeof(standing_keys), standing_keys), SWIF_STATUS_OK)
+
+    /* as test_swif_rlc_decoder_decode_after_slide(), alternating standing
+       repair keys and a built one */
+    for (esi_t esi = 0 ; esi < NB_SOURCES ; esi++) {
+        CU_ASSERT_EQUAL(swif_encoder_add_source_symbol_to_coding_window(enc, src_tab[esi], esi), SWIF_STATUS_OK)
+        if (esi % 5 != 2) {
+            swif_decoder_decode_with_new_source_symbol(dec, src_tab[esi], esi);
+            continue;
+        }
+        esi_t first, last;
+        uint32_t nss;
+        uint32_t key = (esi % 3 == 0) ? 7 : standing_keys[esi % 2];
+        void *repair = NULL;
+        swif_encoder_get_coding_window_information(enc, &first, &last, &nss);
+        CU_ASSERT_EQUAL(swif_encoder_generate_coding_coefs(enc, key, 15, 0), SWIF_STATUS_OK)
+        CU_ASSERT_EQUAL(swif_build_repair_symbol(enc, &repair), SWIF_STATUS_OK)
+        swif_decoder_reset_coding_window(dec);
+        for (esi_t i = first ; i <= last ; i++)
+            swif_decoder_add_source_symbol_to_coding_window(dec, i);
+        swif_decoder_generate_coding_coefs(dec, key, 15, 0);
+        CU_ASSERT_EQUAL(swif_decoder_decode_with_new_repair_symbol(dec, repair, first), SWIF_STATUS_OK)
+        CU_ASSERT_TRUE(decoded_tab[esi])
+        free(repair);
+    }
+    swif_decoder_release(dec);
+    swif_encoder_release(enc);
+}
+
+/* variable length source symbols: length of source symbol esi */
+#define VL_LENGTH(esi)	((uint32_t)(((esi) * 13) % (SYMBOL_SIZE - SWIF_LENGTH_FIELD_SIZE + 1)))
+
+static void vl_decoded_callback(void *context, void *new_symbol_buf, esi_t esi)
+{
+    uint8_t (*src_tab)[SYMBOL_SIZE] = context;
+    CU_ASSERT_FATAL(esi < NB_SOURCES)
+    CU_ASSERT_EQUAL(SWIF_GET_SOURCE_SYMBOL_LENGTH(new_symbol_buf), VL_LENGTH(esi))
+    CU_ASSERT_EQUAL(memcmp((uint8_t *)new_symbol_buf + SWIF_LENGTH_FIELD_SIZE, src_tab[esi],
+                           VL_LENGTH(esi)), 0)
+    decoded_tab[esi] = true;
+}
+
+void test_swif_rlc_decoder_variable_length() {
+    uint8_t src_tab[NB_SOURCES][SYMBOL_SIZE];
+    uint32_t enable = 1;
+    uint32_t repair_size;
+    fill_sources(src_tab);
+    swif_encoder_t *enc = swif_rlc_encoder_create(codepoint, VERBOSITY, SYMBOL_SIZE,
+                                                  max_coding_window_size);
+    swif_decoder_t *dec = get_test_decoder(src_tab);
+    CU_ASSERT_PTR_NOT_NULL_FATAL(enc)
+    swif_decoder_set_callback_functions(dec, removed_callback, NULL, vl_decoded_callback, src_tab);
+    CU_ASSERT_EQUAL(swif_decoder_decode_with_new_variable_length_source_symbol(dec, src_tab[0], 1, 0), SWIF_STATUS_ERROR)
+    CU_ASSERT_EQUAL(swif_encoder_set_parameters(enc, swif_ENCODER_SET_PARAM_VARIABLE_LENGTH_SOURCE_SYMBOLS,
+                                                sizeof(enable), &enable), SWIF_STATUS_OK)
+    /* the repair symbol of esi 17 is computed as its source symbols come */
+    CU_ASSERT_EQUAL(swif_encoder_precommit_repair_key(enc, 11, 15, 17), SWIF_STATUS_OK)
+    CU_ASSERT_EQUAL(swif_decoder_set_parameters(dec, swif_DECODER_SET_PARAM_VARIABLE_LENGTH_SOURCE_SYMBOLS,
+                                                sizeof(enable), &enable), SWIF_STATUS_OK)
+    CU_ASSERT_EQUAL(swif_encoder_add_source_symbol_to_coding_window(enc, src_tab[0], 0), SWIF_STATUS_ERROR)
+    CU_ASSERT_EQUAL(swif_encoder_add_variable_length_source_symbol_to_coding_window(
+                        enc, src_tab[0], SYMBOL_SIZE - 1, 0), SWIF_STATUS_ERROR)
+
+    /* one source symbol out of 5 is lost, and recovered with a repair
+       symbol of only the size its coding window needs */
+    for (esi_t esi = 0 ; esi < NB_SOURCES ; esi++) {
+        CU_ASSERT_EQUAL(swif_encoder_add_variable_length_source_symbol_to_coding_window(
+                            enc, src_tab[esi], VL_LENGTH(esi), esi), SWIF_STATUS_OK)
+        if (esi % 5 != 2) {
+            CU_ASSERT_EQUAL(swif_decoder_decode_with_new_variable_length_source_symbol(
+                                dec, src_tab[esi], VL_LENGTH(esi), esi), SWIF_STATUS_OK)
+            continue;
+        }
+        esi_t first, last;
+        uint32_t nss;
+        uint32_t key = (esi % 2 == 0) ? 7 : 11;
+        uint32_t max_length = 0;
+        void *repair = NULL;
+        swif_encoder_get_coding_window_information(enc, &first, &last, &nss);
+        for (esi_t i = first ; i <= last ; i++)
+            max_length = (VL_LENGTH(i) > max_length) ? VL_LENGTH(i) : max_length;
+        CU_ASSERT_EQUAL(swif_encoder_generate_coding_coefs(enc, key, 15, 0), SWIF_STATUS_OK)
+        CU_ASSERT_EQUAL(swif_build_repair_symbol(enc, &repair), SWIF_STATUS_OK)
+        CU_ASSERT_EQUAL(swif_encoder_get_parameters(enc, swif_ENCODER_GET_PARAM_REPAIR_SYMBOL_SIZE,
+                                                    sizeof(repair_size), &repair_size), SWIF_STATUS_OK)
+        CU_ASSERT_EQUAL(repair_size, SWIF_LENGTH_FIELD_SIZE + max_length)
+        swif_decoder_reset_coding_window(dec);
+        for (esi_t i = first ; i <= last ; i++)
+            swif_decoder_add_source_symbol_to_coding_window(dec, i);
+        swif_decoder_generate_coding_coefs(dec, key, 15, 0);
+        CU_ASSERT_EQUAL(swif_decoder_decode_with_new_variable_length_repair_symbol(
+                            dec, repair, repair_size, first), SWIF_STATUS_OK)
+        CU_ASSERT_TRUE(decoded_tab[esi])
+        free(repair);
+    }
+    swif_decoder_release(dec);
+    swif_encoder_release(enc);
+}
+
+/* same as submit_repair() with variable length source symbols */
+static void submit_variable_length_repair(swif_encoder_t *enc, swif_decoder_t *dec, uint32_t key) {
+    esi_t first, last;
+    uint32_t nss;
+    uint32_t repair_size;
+    void *repair = NULL;
+    swif_encoder_get_coding_window_information(enc, &first, &last, &nss);
+    CU_ASSERT_EQUAL(swif_encoder_generate_coding_coefs(enc, key, 15, 0), SWIF_STATUS_OK)
+    CU_ASSERT_EQUAL(swif_build_repair_symbol(enc, &repair), SWIF_STATUS_OK)
+    swif_encoder_get_parameters(enc, swif_ENCODER_GET_PARAM_REPAIR_SYMBOL_SIZE,
+                                sizeof(repair_size), &repair_size);
+    swif_decoder_reset_coding_window(dec);
+    for (esi_t i = first ; i <= last ; i++)
+        swif_decoder_add_source_symbol_to_coding_window(dec, i);
+    swif_decoder_generate_coding_coefs(dec, key, 15, 0);
+    CU_ASSERT_EQUAL(swif_decoder_decode_with_new_variable_length_repair_symbol(
+                        dec, repair, repair_size, first), SWIF_STATUS_OK)
+    swif_encoder_release_repair_buffer(enc, repair);
+}
+
+void test_swif_rlc_decoder_variable_length_data_ops() {
+    uint8_t src_tab[NB_SOURCES][SYMBOL_SIZE];
+    uint32_t enable = 1;
+    fill_sources(src_tab);
+
+    for (int lost_late = 0 ; lost_late < 2 ; lost_late++) {
+        swif_encoder_t *enc = swif_rlc_encoder_create(codepoint, VERBOSITY, SYMBOL_SIZE,
+                                                      max_coding_window_size);
+        CU_ASSERT_PTR_NOT_NULL_FATAL(enc)
+        swif_decoder_t *dec = get_test_decoder(src_tab);
+        swif_full_symbol_set_t *set = ((swif_decoder_rlc_cb_t *)dec)->symbol_set;
+        swif_decoder_set_callback_functions(dec, removed_callback, NULL, vl_decoded_callback, src_tab);
+        swif_encoder_set_parameters(enc, swif_ENCODER_SET_PARAM_VARIABLE_LENGTH_SOURCE_SYMBOLS,
+                                    sizeof(enable), &enable);
+        swif_decoder_set_parameters(dec, swif_DECODER_SET_PARAM_VARIABLE_LENGTH_SOURCE_SYMBOLS,
+                                    sizeof(enable), &enable);
+        for (esi_t esi = 0 ; esi < 4 ; esi++)
+            swif_encoder_add_variable_length_source_symbol_to_coding_window(enc, src_tab[esi],
+                                                                            VL_LENGTH(esi), esi);
+        if (lost_late == 0) {
+            /* 2 and 3 are lost: the repair symbol of 0..3 is eliminated with
+               the (longer) one of 1..4, which is then back-substituted */
+            for (esi_t esi = 0 ; esi < 2 ; esi++)
+                swif_decoder_decode_with_new_variable_length_source_symbol(dec, src_tab[esi],
+                                                                           VL_LENGTH(esi), esi);
+            submit_variable_length_repair(enc, dec, 7);
+            swif_encoder_add_variable_length_source_symbol_to_coding_window(enc, src_tab[4],
+                                                                            VL_LENGTH(4), 4);
+            swif_decoder_decode_with_new_variable_length_source_symbol(dec, src_tab[4], VL_LENGTH(4), 4);
+            submit_variable_length_repair(enc, dec, 11);
+            CU_ASSERT_TRUE(decoded_tab[2] && decoded_tab[3])
+            /* a data operation on the bytes of the row of 2 only */
+            CU_ASSERT_EQUAL(set->data_op_tab[0].size, SWIF_LENGTH_FIELD_SIZE + VL_LENGTH(3))
+        } else {
+            /* 1 and 2 are lost, and 2 comes after the repair symbol of 0..3 */
+            swif_decoder_decode_with_new_variable_length_source_symbol(dec, src_tab[0], VL_LENGTH(0), 0);
+            swif_decoder_decode_with_new_variable_length_source_symbol(dec, src_tab[3], VL_LENGTH(3), 3);
+            submit_variable_length_repair(enc, dec, 7);
+            /* the repair symbol was reduced with a data operation per pivot,
+               on the size of each */
+            CU_ASSERT_EQUAL(set->data_op_tab[0].size, SWIF_LENGTH_FIELD_SIZE + VL_LENGTH(0))
+            CU_ASSERT_EQUAL(set->data_op_tab[1].size, SWIF_LENGTH_FIELD_SIZE + VL_LENGTH(3))
+            swif_decoder_decode_with_new_variable_length_source_symbol(dec, src_tab[2], VL_LENGTH(2), 2);
+            CU_ASSERT_TRUE(decoded_tab[1])
+            CU_ASSERT_EQUAL(set->data_op_tab[0].size, SWIF_LENGTH_FIELD_SIZE + VL_LENGTH(2))
+        }
+        swif_decoder_release(dec);
+        swif_encoder_release(enc);
+    }
+}
+
+/* build a repair symbol on the current encoding window and submit it to the decoder */
+void submit_repair(swif_encoder_t *enc, swif_decoder_t *dec, uint32_t key) {
+    esi_t first, last;
+    uint32_t nss;
+    void *repair = NULL;
+    swif_encoder_get_coding_window_information(enc, &first, &last, &nss);
+    CU_ASSERT_EQUAL(swif_encoder_generate_coding_coefs(enc, key, 15, 0), SWIF_STATUS_OK)
+    CU_ASSERT_EQUAL(swif_build_repair_symbol(enc, &repair), SWIF_STATUS_OK)
+    swif_decoder_reset_coding_window(dec);
+    for (esi_t i = first ; i <= last ; i++)
+        swif_decoder_add_source_symbol_to_coding_window(dec, i);
+    swif_decoder_generate_coding_coefs(dec, key, 15, 0);
+    CU_ASSERT_EQUAL(swif_decoder_decode_with_new_repair_symbol(dec, repair, first), SWIF_STATUS_OK)
+    free(repair);
+}
+
+void test_swif_rlc_decoder_remove_source_symbol() {
+    uint8_t src_tab[NB_SOURCES][SYMBOL_SIZE];
+    fill_sources(src_tab);
+    swif_encoder_t *enc = swif_rlc_encoder_create(codepoint, VERBOSITY, SYMBOL_SIZE, max_coding_window_size);
+    CU_ASSERT_PTR_NOT_NULL_FATAL(enc)
+    swif_decoder_t *dec = get_test_decoder(src_tab);
+    swif_full_symbol_set_t *set = ((swif_decoder_rlc_cb_t *)dec)->symbol_set;
+
+    /* source symbols 1 and 2 are lost, a single repair symbol covers them */
+    for (esi_t esi = 0 ; esi < 4 ; esi++) {
+        swif_encoder_add_source_symbol_to_coding_window(enc, src_tab[esi], esi);
+        if (esi != 1 && esi != 2)
+            swif_decoder_decode_with_new_source_symbol(dec, src_tab[esi], esi);
+    }
+    submit_repair(enc, dec, 1);
+    CU_ASSERT_EQUAL(set->nmbr_packets, 3)
+
+    /* 1 is no longer needed: the row covering it is freed */
+    CU_ASSERT_EQUAL(swif_decoder_remove_source_symbol_from_coding_window(dec, 1), SWIF_STATUS_OK)
+    CU_ASSERT_EQUAL(nb_removed, 1)
+    CU_ASSERT_EQUAL(removed_tab[0], 1)
+    CU_ASSERT_EQUAL(set->nmbr_packets, 2)
+
+    /* a repair symbol not covering 1 is enough to recover 2 */
+    for (esi_t esi = 4 ; esi < 6 ; esi++) {
+        swif_encoder_add_source_symbol_to_coding_window(enc, src_tab[esi], esi);
+        swif_decoder_decode_with_new_source_symbol(dec, src_tab[esi], esi);
+    }
+    submit_repair(enc, dec, 2);
+    CU_ASSERT_TRUE(decoded_tab[2])
+    CU_ASSERT_FALSE(decoded_tab[1])
+
+    /* removing the oldest source symbol slides the linear system, over 1 as well */
+    CU_ASSERT_EQUAL(swif_decoder_remove_source_symbol_from_coding_window(dec, 0), SWIF_STATUS_OK)
+    CU_ASSERT_EQUAL(set->first_symbol_id, 2)
+    CU_ASSERT_EQUAL(swif_decoder_remove_source_symbol_from_coding_window(dec, 2), SWIF_STATUS_OK)
+    CU_ASSERT_EQUAL(set->first_symbol_id, 3)
+
+    /* each source symbol is notified once, even when the system slides later */
+    for (esi_t esi = 6 ; esi < NB_SOURCES ; esi++)
+        swif_decoder_decode_with_new_source_symbol(dec, src_tab[esi], esi);
+    CU_ASSERT_EQUAL(nb_removed, NB_SOURCES - max_linear_system_size)
+    CU_ASSERT_EQUAL(removed_tab[1], 0)
+    CU_ASSERT_EQUAL(removed_tab[2], 2)
+    for (uint32_t i = 3 ; i < nb_removed ; i++)
+        CU_ASSERT_EQUAL(removed_tab[i], i)
+    swif_decoder_release(dec);
+    swif_encoder_release(enc);
+
+    /* a source symbol removed before being seen */
+    enc = swif_rlc_encoder_create(codepoint, VERBOSITY, SYMBOL_SIZE, max_coding_window_size);
+    CU_ASSERT_PTR_NOT_NULL_FATAL(enc)
+    dec = get_test_decoder(src_tab);
+    set = ((swif_decoder_rlc_cb_t *)dec)->symbol_set;
+    for (esi_t esi = 0 ; esi < 2 ; esi++) {
+        swif_encoder_add_source_symbol_to_coding_window(enc, src_tab[esi], esi);
+        swif_decoder_decode_with_new_source_symbol(dec, src_tab[esi], esi);
+    }
+    CU_ASSERT_EQUAL(swif_decoder_remove_source_symbol_from_coding_window(dec, 3), SWIF_STATUS_OK)
+    CU_ASSERT_EQUAL(nb_removed, 0)
+    /* 2 is lost: a repair symbol also covering 3 does not recover it */
+    for (esi_t esi = 2 ; esi < 4 ; esi++)
+        swif_encoder_add_source_symbol_to_coding_window(enc, src_tab[esi], esi);
+    submit_repair(enc, dec, 1);
+    CU_ASSERT_FALSE(decoded_tab[2])
+    CU_ASSERT_EQUAL(set->nmbr_packets, 2)
+    /* 3 itself is ignored, 4 is not */
+    CU_ASSERT_EQUAL(swif_decoder_decode_with_new_source_symbol(dec, src_tab[3], 3), SWIF_STATUS_OK)
+    CU_ASSERT_EQUAL(set->nmbr_packets, 2)
+    CU_ASSERT_EQUAL(swif_decoder_decode_with_new_source_symbol(dec, src_tab[4], 4), SWIF_STATUS_OK)
+    CU_ASSERT_EQUAL(set->nmbr_packets, 3)
+    swif_decoder_release(dec);
+    swif_encoder_release(enc);
+}
+
+void test_swif_rlc_decoder_zero_copy_source_symbols() {
+    uint8_t src_tab[NB_SOURCES][SYMBOL_SIZE];
+    uint8_t ref_tab[NB_SOURCES][SYMBOL_SIZE];
+    uint32_t zero_copy = 1;
+    fill_sources(src_tab);
+    swif_encoder_t *enc = swif_rlc_encoder_create(codepoint, VERBOSITY, SYMBOL_SIZE, max_coding_window_size);
+    CU_ASSERT_PTR_NOT_NULL_FATAL(enc)
+    swif_decoder_t *dec = get_test_decoder(src_tab);
+    swif_full_symbol_set_t *set = ((swif_decoder_rlc_cb_t *)dec)->symbol_set;
+    CU_ASSERT_EQUAL(swif_decoder_set_parameters(dec, swif_DECODER_SET_PARAM_ZERO_COPY_SOURCE_SYMBOLS,
+                                                sizeof(zero_copy), &zero_copy), SWIF_STATUS_OK)
+    CU_ASSERT_EQUAL(swif_decoder_set_parameters(dec, swif_DECODER_SET_PARAM_ZERO_COPY_SOURCE_SYMBOLS,
+                                                1, &zero_copy), SWIF_STATUS_ERROR)
+    /* the decoder works on its own copy of the application buffers */
+    memcpy(ref_tab, src_tab, sizeof(src_tab));
+
+    for (esi_t esi = 0 ; esi < 4 ; esi++) {
+        swif_encoder_add_source_symbol_to_coding_window(enc, src_tab[esi], esi);
+        if (esi != 1)
+            swif_decoder_decode_with_new_source_symbol(dec, ref_tab[esi], esi);
+    }
+    /* a received source symbol is referenced, not copied */
+    CU_ASSERT_PTR_EQUAL(set->full_symbol_tab[0]->data, ref_tab[0])
+    CU_ASSERT_PTR_EQUAL(set->full_symbol_tab[3]->data, ref_tab[3])
+
+    /* decoding does not modify the application buffers */
+    submit_repair(enc, dec, 1);
+    CU_ASSERT_TRUE(decoded_tab[1])
+    CU_ASSERT_EQUAL(memcmp(ref_tab, src_tab, sizeof(src_tab)), 0)
+    swif_decoder_release(dec);
+    swif_encoder_release(enc);
+}
+
+void test_swif_rlc_decoder_decode_into_app_buffers() {
+    uint8_t src_tab[NB_SOURCES][SYMBOL_SIZE];
+    fill_sources(src_tab);
+    swif_encoder_t *enc = swif_rlc_encoder_create(codepoint, VERBOSITY, SYMBOL_SIZE, max_coding_window_size);
+    CU_ASSERT_PTR_NOT_NULL_FATAL(enc)
+    swif_decoder_t *dec = get_test_decoder(src_tab);
+    CU_ASSERT_EQUAL(swif_decoder_set_callback_functions(dec, removed_callback, decodable_callback,
+                                                        decoded_into_app_buf_callback, src_tab), SWIF_STATUS_OK)
+    memset(decoded_buf_tab, 0, sizeof(decoded_buf_tab));
+
+    /* source symbols 1 and 2 are lost, and recovered with two repair symbols */
+    for (esi_t esi = 0 ; esi < 4 ; esi++) {
+        swif_encoder_add_source_symbol_to_coding_window(enc, src_tab[esi], esi);
+        if (esi != 1 && esi != 2)
+            swif_decoder_decode_with_new_source_symbol(dec, src_tab[esi], esi);
+    }
+    submit_repair(enc, dec, 1);
+    CU_ASSERT_FALSE(decoded_tab[1] || decoded_tab[2])
+    submit_repair(enc, dec, 2);
+    CU_ASSERT_TRUE(decoded_tab[1] && decoded_tab[2])
+    CU_ASSERT_PTR_EQUAL(decoded_buf_tab[2], app_buf_tab[2])
+    CU_ASSERT_PTR_NOT_NULL(decoded_buf_tab[1])
+    CU_ASSERT_PTR_NOT_EQUAL(decoded_buf_tab[1], app_buf_tab[1])
+    swif_decoder_release(dec);
+    swif_encoder_release(enc);
+    /* the buffers allocated by the codec belong to the application */
+    free(decoded_buf_tab[1]);
+}
+
+void test_swif_rlc_decoder_elimination_budget() {
+    uint8_t src_tab[NB_SOURCES][SYMBOL_SIZE];
+    uint32_t budget = 1;
+    uint32_t pending;
+    fill_sources(src_tab);
+    swif_encoder_t *enc = swif_rlc_encoder_create(codepoint, VERBOSITY, SYMBOL_SIZE, max_coding_window_size);
+    CU_ASSERT_PTR_NOT_NULL_FATAL(enc)
+    swif_decoder_t *dec = get_test_decoder(src_tab);
+    CU_ASSERT_EQUAL(swif_decoder_set_parameters(dec, swif_DECODER_SET_PARAM_ELIMINATION_BUDGET,
+                                                sizeof(budget), &budget), SWIF_STATUS_OK)
+
+    /* source symbols 1, 2 and 3 are lost, three repair symbols follow */
+    for (esi_t esi = 0 ; esi < 4 ; esi++) {
+        swif_encoder_add_source_symbol_to_coding_window(enc, src_tab[esi], esi);
+        if (esi == 0)
+            swif_decoder_decode_with_new_source_symbol(dec, src_tab[esi], esi);
+    }
+    submit_repair(enc, dec, 1);
+    submit_repair(enc, dec, 2);
+    submit_repair(enc, dec, 3);
+    /* 3 is decoded, but its back-substitution is only done in the first row */
+    CU_ASSERT_TRUE(decoded_tab[3] && decoded_tab[1])
+    CU_ASSERT_FALSE(decoded_tab[2])
+    CU_ASSERT_EQUAL(swif_decoder_get_parameters(dec, swif_DECODER_GET_PARAM_PENDING_WORK,
+                                                sizeof(pending), &pending), SWIF_STATUS_OK)
+    CU_ASSERT_EQUAL(pending, 1)
+
+    CU_ASSERT_EQUAL(swif_decoder_make_progress(dec, 1), SWIF_STATUS_OK)
+    CU_ASSERT_EQUAL(swif_decoder_make_progress(dec, 0), SWIF_STATUS_OK)
+    CU_ASSERT_TRUE(decoded_tab[1] && decoded_tab[2])
+    swif_decoder_get_parameters(dec, swif_DECODER_GET_PARAM_PENDING_WORK, sizeof(pending), &pending);
+    CU_ASSERT_EQUAL(pending, 0)
+    swif_decoder_release(dec);
+    swif_encoder_release(enc);
+}
+
+void test_swif_rlc_decoder_fixed_capacity() {
+    uint8_t src_tab[NB_SOURCES][SYMBOL_SIZE];
+    uint32_t fixed = 1;
+    fill_sources(src_tab);
+    swif_encoder_t *enc = swif_rlc_encoder_create(codepoint, VERBOSITY, SYMBOL_SIZE, max_coding_window_size);
+    CU_ASSERT_PTR_NOT_NULL_FATAL(enc)
+    swif_decoder_t *dec = get_test_decoder(src_tab);
+    CU_ASSERT_EQUAL(swif_decoder_set_parameters(dec, swif_DECODER_SET_PARAM_FIXED_CAPACITY,
+                                                sizeof(fixed), &fixed), SWIF_STATUS_OK)
+    swif_full_symbol_set_t *set = ((swif_decoder_rlc_cb_t *)dec)->symbol_set;
+    CU_ASSERT_PTR_NOT_NULL_FATAL(set->pool)
+
+    for (esi_t esi = 0 ; esi < NB_SOURCES ; esi++) {
+        swif_encoder_add_source_symbol_to_coding_window(enc, src_tab[esi], esi);
+        if (esi % 5 == 2)
+            submit_repair(enc, dec, esi);
+        else
+            swif_decoder_decode_with_new_source_symbol(dec, src_tab[esi], esi);
+        CU_ASSERT_TRUE(esi % 5 != 2 || decoded_tab[esi])
+    }
+    /* every row of the linear system comes from the pool, nothing else is left */
+    for (uint32_t i = 0 ; i < set->size ; i++)
+        CU_ASSERT_TRUE(set->full_symbol_tab[i] == NULL || set->full_symbol_tab[i]->pool == set->pool)
+    CU_ASSERT_EQUAL(set->pool->nb_free, set->pool->nb_symbols - set->nmbr_packets)
+    CU_ASSERT_EQUAL(nb_removed, NB_SOURCES - max_linear_system_size)
+
+    /* too late to change it */
+    fixed = 0;
+    CU_ASSERT_EQUAL(swif_decoder_set_parameters(dec, swif_DECODER_SET_PARAM_FIXED_CAPACITY,
+                                                sizeof(fixed), &fixed), SWIF_STATUS_ERROR)
+    swif_decoder_release(dec);
+    swif_encoder_release(enc);
+}
+
+void test_swif_rlc_decoder_snapshot_restore() {
+    uint8_t src_tab[NB_SOURCES][SYMBOL_SIZE];
+    fill_sources(src_tab);
+    swif_encoder_t *enc = swif_rlc_encoder_create(codepoint, VERBOSITY, SYMBOL_SIZE, max_coding_window_size);
+    CU_ASSERT_PTR_NOT_NULL_FATAL(enc)
+    swif_decoder_t *dec = get_test_decoder(src_tab);
+
+    /* source symbols 1 and 2 are lost, a single repair symbol is received */
+    for (esi_t esi = 0 ; esi < 4 ; esi++) {
+        swif_encoder_add_source_symbol_to_coding_window(enc, src_tab[esi], esi);
+        if (esi != 1 && esi != 2)
+            swif_decoder_decode_with_new_source_symbol(dec, src_tab[esi], esi);
+    }
+    submit_repair(enc, dec, 1);
+
+    uint32_t size = 0;
+    CU_ASSERT_EQUAL(swif_decoder_snapshot(dec, NULL, &size), SWIF_STATUS_OK)
+    uint8_t *snapshot = malloc(size);
+    CU_ASSERT_PTR_NOT_NULL_FATAL(snapshot)
+    uint32_t small_size = size - 1;
+    CU_ASSERT_EQUAL(swif_decoder_snapshot(dec, snapshot, &small_size), SWIF_STATUS_ERROR)
+    CU_ASSERT_EQUAL(swif_decoder_snapshot(dec, snapshot, &size), SWIF_STATUS_OK)
+    swif_decoder_release(dec);
+
+    /* a new decoder takes over, and decodes with the next repair symbol */
+    swif_decoder_t *dec2 = get_test_decoder(src_tab);
+    CU_ASSERT_EQUAL(swif_decoder_restore(dec2, snapshot, size - 1), SWIF_STATUS_ERROR)
+    CU_ASSERT_EQUAL(swif_decoder_restore(dec2, snapshot, size), SWIF_STATUS_OK)
+    CU_ASSERT_EQUAL(((swif_decoder_rlc_cb_t *)dec2)->symbol_set->nmbr_packets, 3)
+    CU_ASSERT_EQUAL(swif_decoder_restore(dec2, snapshot, size), SWIF_STATUS_ERROR)
+    submit_repair(enc, dec2, 2);
+    CU_ASSERT_TRUE(decoded_tab[1] && decoded_tab[2])
+    swif_decoder_release(dec2);
+
+    /* it does not fit a decoder with other parameters */
+    swif_decoder_t *dec3 = swif_rlc_decoder_create(codepoint, VERBOSITY, SYMBOL_SIZE,
+                                                   max_coding_window_size, max_linear_system_size + 1);
+    CU_ASSERT_PTR_NOT_NULL_FATAL(dec3)
+    CU_ASSERT_EQUAL(swif_decoder_restore(dec3, snapshot, size), SWIF_STATUS_ERROR)
+    swif_decoder_release(dec3);
+    free(snapshot);
+    swif_encoder_release(enc);
+
+    /* a source symbol removed out of order before the system ever slid */
+    enc = swif_rlc_encoder_create(codepoint, VERBOSITY, SYMBOL_SIZE, max_coding_window_size);
+    CU_ASSERT_PTR_NOT_NULL_FATAL(enc)
+    dec = get_test_decoder(src_tab);
+    for (esi_t esi = 0 ; esi < 4 ; esi++) {
+        swif_encoder_add_source_symbol_to_coding_window(enc, src_tab[esi], esi);
+        swif_decoder_decode_with_new_source_symbol(dec, src_tab[esi], esi);
+    }
+    CU_ASSERT_EQUAL(swif_decoder_remove_source_symbol_from_coding_window(dec, 2), SWIF_STATUS_OK)
+    size = 0;
+    CU_ASSERT_EQUAL(swif_decoder_snapshot(dec, NULL, &size), SWIF_STATUS_OK)
+    snapshot = malloc(size);
+    CU_ASSERT_PTR_NOT_NULL_FATAL(snapshot)
+    CU_ASSERT_EQUAL(swif_decoder_snapshot(dec, snapshot, &size), SWIF_STATUS_OK)
+    swif_decoder_release(dec);
+    dec2 = get_test_decoder(src_tab);
+    CU_ASSERT_EQUAL(swif_decoder_restore(dec2, snapshot, size), SWIF_STATUS_OK)
+    CU_ASSERT_EQUAL(((swif_decoder_rlc_cb_t *)dec2)->symbol_set->nmbr_packets, 3)
+    /* 2 is still removed: a repair symbol covering it is ignored */
+    submit_repair(enc, dec2, 1);
+    CU_ASSERT_EQUAL(((swif_decoder_rlc_cb_t *)dec2)->symbol_set->nmbr_packets, 3)
+    swif_decoder_release(dec2);
+    free(snapshot);
+    swif_encoder_release(enc);
+}
+
+#define JUMBO_SYMBOL_SIZE	9000
+#define NB_JUMBO_SOURCES	12
+
+/* what the serial decoder and the threaded one decoded */
+uint8_t	jumbo_decoded_tab[2][NB_JUMBO_SOURCES][JUMBO_SYMBOL_SIZE];
+
+/* longer than the coding window of SWIF_CODEPOINT_RLC_GF_256_VANDERMONDE_CODEC */
+#define NB_LONG_SOURCES	300
+bool	long_decoded_tab[NB_LONG_SOURCES];
+
+static void long_decoded_callback(void *context, void *new_symbol_buf, esi_t esi)
+{
+    uint8_t (*src_tab)[SYMBOL_SIZE] = context;
+    CU_ASSERT_FATAL(esi < NB_LONG_SOURCES)
+    CU_ASSERT_EQUAL(memcmp(new_symbol_buf, src_tab[esi], SYMBOL_SIZE), 0)
+    long_decoded_tab[esi] = true;
+}
+
+void test_swif_rlc_decoder_vandermonde_window_limit() {
+    static uint8_t src_tab[NB_LONG_SOURCES][SYMBOL_SIZE];
+    uint32_t window = SWIF_VANDERMONDE_MAX_CODING_WINDOW_SIZE;
+    uint8_t cc_tab[2];
+    for (int i = 0 ; i < NB_LONG_SOURCES ; i++)
+        for (int j = 0 ; j < SYMBOL_SIZE ; j++)
+            src_tab[i][j] = (uint8_t)(i * 31 + j * 7 + i / 256 + 1);
+    memset(long_decoded_tab, 0, sizeof(long_decoded_tab));
+
+    /* ESIs e and e + 255 have the same coefficients: they cannot be in
+       the same coding window */
+    CU_ASSERT_PTR_NULL(swif_rlc_encoder_create(SWIF_CODEPOINT_RLC_GF_256_VANDERMONDE_CODEC,
+                                               VERBOSITY, SYMBOL_SIZE, window + 1))
+    CU_ASSERT_PTR_NULL(swif_rlc_decoder_create(SWIF_CODEPOINT_RLC_GF_256_VANDERMONDE_CODEC,
+                                               VERBOSITY, SYMBOL_SIZE, window + 1, 0))
+    /* no key gives a row of ones */
+    for (uint32_t key = 0 ; key < 600 ; key++) {
+        swif_rlc_generate_vandermonde_coefficients((uint16_t)key, 0, cc_tab, 2);
+        CU_ASSERT_NOT_EQUAL(cc_tab[1], cc_tab[0])
+    }
+
+    swif_encoder_t *enc = swif_rlc_encoder_create(SWIF_CODEPOINT_RLC_GF_256_VANDERMONDE_CODEC,
+                                                  VERBOSITY, SYMBOL_SIZE, window);
+    swif_decoder_t *dec = swif_rlc_decoder_create(SWIF_CODEPOINT_RLC_GF_256_VANDERMONDE_CODEC,
+                                                  VERBOSITY, SYMBOL_SIZE, window, 2 * window);
+    CU_ASSERT_PTR_NOT_NULL_FATAL(enc)
+    CU_ASSERT_PTR_NOT_NULL_FATAL(dec)
+    swif_decoder_set_callback_functions(dec, NULL, NULL, long_decoded_callback, src_tab);
+
+    /* 10 and 265 are lost, each recovered with a repair symbol of a full
+       coding window */
+    for (esi_t esi = 0 ; esi < NB_LONG_SOURCES ; esi++) {
+        CU_ASSERT_EQUAL(swif_encoder_add_source_symbol_to_coding_window(enc, src_tab[esi], esi), SWIF_STATUS_OK)
+        if (esi != 10 && esi != 265)
+            swif_decoder_decode_with_new_source_symbol(dec, src_tab[esi], esi);
+        if (esi == 20 || esi == 270)
+            submit_repair(enc, dec, (esi == 20) ? 0 : 254);
+    }
+    CU_ASSERT_TRUE(long_decoded_tab[10])
+    CU_ASSERT_TRUE(long_decoded_tab[265])
+    swif_decoder_release(dec);
+    swif_encoder_release(enc);
+}
+
+static void jumbo_decoded_callback(void *context, void *new_symbol_buf, esi_t esi)
+{
+    uint8_t (*out_tab)[JUMBO_SYMBOL_SIZE] = context;
+    CU_ASSERT_FATAL(esi < NB_JUMBO_SOURCES)
+    memcpy(out_tab[esi], new_symbol_buf, JUMBO_SYMBOL_SIZE);
+}
+
+void test_swif_rlc_decoder_nb_threads() {
+    static uint8_t src_tab[NB_JUMBO_SOURCES][JUMBO_SYMBOL_SIZE];
+    uint32_t window = 8;
+    uint32_t nb_threads = 0;
+    swif_decoder_t *dec_tab[2];
+    for (int i = 0 ; i < NB_JUMBO_SOURCES ; i++)
+        for (int j = 0 ; j < JUMBO_SYMBOL_SIZE ; j++)
+            src_tab[i][j] = (uint8_t)(i * 31 + j * 7 + j / 251 + 1);
+    memset(jumbo_decoded_tab, 0, sizeof(jumbo_decoded_tab));
+    swif_encoder_t *enc = swif_rlc_encoder_create(codepoint, VERBOSITY, JUMBO_SYMBOL_SIZE, window);
+    CU_ASSERT_PTR_NOT_NULL_FATAL(enc)
+    for (int d = 0 ; d < 2 ; d++) {
+        dec_tab[d] = swif_rlc_decoder_create(codepoint, VERBOSITY, JUMBO_SYMBOL_SIZE, window, 0);
+        CU_ASSERT_PTR_NOT_NULL_FATAL(dec_tab[d])
+        swif_decoder_set_callback_functions(dec_tab[d], NULL, NULL, jumbo_decoded_callback,
+                                            jumbo_decoded_tab[d]);
+    }
+    CU_ASSERT_EQUAL(swif_decoder_set_parameters(dec_tab[1], swif_DECODER_SET_PARAM_NB_THREADS,
+                                                sizeof(nb_threads), &nb_threads), SWIF_STATUS_ERROR)
+    /* fails when the codec is built without WITH_THREADS: decoding is serial */
+    nb_threads = 4;
+    swif_decoder_set_parameters(dec_tab[1], swif_DECODER_SET_PARAM_NB_THREADS,
+                                sizeof(nb_threads), &nb_threads);
+
+    /* 4, 5, 6 and 9 are lost, and recovered with repair symbols */
+    for (esi_t esi = 0 ; esi < NB_JUMBO_SOURCES ; esi++) {
+        swif_encoder_add_source_symbol_to_coding_window(enc, src_tab[esi], esi);
+        for (int d = 0 ; d < 2 ; d++) {
+            if ((esi < 4 || esi > 6) && esi != 9)
+                swif_decoder_decode_with_new_source_symbol(dec_tab[d], src_tab[esi], esi);
+            if (esi == 7 || esi == 11)
+                for (uint32_t key = 100 ; key < (esi == 7 ? 103 : 101) ; key++)
+                    submit_repair(enc, dec_tab[d], key);
+        }
+    }
+    CU_ASSERT_EQUAL(memcmp(jumbo_decoded_tab[0], jumbo_decoded_tab[1], sizeof(jumbo_decoded_tab[0])), 0)
+    CU_ASSERT_EQUAL(memcmp(jumbo_decoded_tab[1][4], src_tab[4], 3 * JUMBO_SYMBOL_SIZE), 0)
+    CU_ASSERT_EQUAL(memcmp(jumbo_decoded_tab[1][9], src_tab[9], JUMBO_SYMBOL_SIZE), 0)
+    swif_decoder_release(dec_tab[0]);
+    swif_decoder_release(dec_tab[1]);
+    swif_encoder_release(enc);
+}
+
+/* The main() function for setting up and running the tests.
+ * Returns a CUE_SUCCESS on successful running, another
+ * CUnit error code on failure.
+ */
+int main()
+{
+
+    CU_pSuite pSuite = NULL;
+
+    CU_basic_set_mode(CU_BRM_VERBOSE);
+    /* initialize the CUnit test registry */
+    if (CUE_SUCCESS != CU_initialize_registry())
+        return CU_get_error();
+
+    /* add a suite to the registry */
+    pSuite = CU_add_suite("Suite_1", NULL, NULL);
+    if (NULL == pSuite) {
+        CU_cleanup_registry();
+        return CU_get_error();
+    }
+
+    /* add the tests to the suite */
+    if ((NULL == CU_add_test(pSuite, "test of swif_rlc_decoder_create () with a too small linear system", test_swif_rlc_decoder_create_bad_linear_system_size)) ||
+        (NULL == CU_add_test(pSuite, "test of the linear system sliding with source symbols only", test_swif_rlc_decoder_linear_system_slides)) ||
+        (NULL == CU_add_test(pSuite, "test of decoding while the linear system slides", test_swif_rlc_decoder_decode_after_slide)) ||
+        (NULL == CU_add_test(pSuite, "test of swif_rlc_decoder_remove_source_symbol_from_coding_window ()", test_swif_rlc_decoder_remove_source_symbol)) ||
+        (NULL == CU_add_test(pSuite, "test of swif_DECODER_SET_PARAM_ZERO_COPY_SOURCE_SYMBOLS", test_swif_rlc_decoder_zero_copy_source_symbols)) ||
+        (NULL == CU_add_test(pSuite, "test of decoding into application buffers", test_swif_rlc_decoder_decode_into_app_buffers)) ||
+        (NULL == CU_add_test(pSuite, "test of swif_decoder_make_progress () with an elimination budget", test_swif_rlc_decoder_elimination_budget)) ||
+        (NULL == CU_add_test(pSuite, "test of swif_DECODER_SET_PARAM_FIXED_CAPACITY", test_swif_rlc_decoder_fixed_capacity)) ||
+        (NULL == CU_add_test(pSuite, "test of swif_decoder_snapshot () and swif_decoder_restore ()", test_swif_rlc_decoder_snapshot_restore)) ||
+        (NULL == CU_add_test(pSuite, "test of swif_DECODER_SET_PARAM_NB_THREADS", test_swif_rlc_decoder_nb_threads)) ||
+        (NULL == CU_add_test(pSuite, "test of SWIF_CODEPOINT_RLC_GF_256_VANDERMONDE_CODEC", test_swif_rlc_decoder_vandermonde)) ||
+        (NULL == CU_add_test(pSuite, "test of SWIF_VANDERMONDE_MAX_CODING_WINDOW_SIZE", test_swif_rlc_decoder_vandermonde_window_limit)) ||
+        (NULL == CU_add_test(pSuite, "test of variable length source symbols", test_swif_rlc_decoder_variable_length)) ||
+        (NULL == CU_add_test(pSuite, "test of variable length source symbols data operations", test_swif_rlc_decoder_variable_length_data_ops)))
+    {
+        CU_cleanup_registry();
+        return CU_get_error();
+    }
+
+    /* Run all tests using the CUnit Basic interface */
+    CU_basic_run_tests();
+    CU_cleanup_registry();
+    return CU_get_error();
+}
@@ -4,6 +4,7 @@
 #include <stdarg.h>
 #include <stdbool.h>
 #include "../src/swif_rlc_api.h"
+#include "../src/swif_coding_coefficients.h"
 
 #define VERBOSITY	0
 #define SYMBOL_SIZE	1024
@@ -106,6 +107,768 @@ void test_swif_rlc_encoder_set_coding_coefs_tab_partial_array() {
 }
 
 
+#define JUMBO_SYMBOL_SIZE	9000
+
+void test_swif_rlc_encoder_nb_threads() {
+    static uint8_t src_tab[10][JUMBO_SYMBOL_SIZE];
+    uint8_t coefs[10];
+    uint8_t reference[JUMBO_SYMBOL_SIZE];
+    void *repair_tab[2] = { NULL, NULL };
+    uint32_t nb_threads = 0;
+    swif_encoder_t *enc_tab[2];
+    for (int i = 0 ; i < 10 ; i++)
+        for (int j = 0 ; j < JUMBO_SYMBOL_SIZE ; j++)
+            src_tab[i][j] = (uint8_t)(i * 31 + j * 7 + j / 251 + 1);
+    generate_coefs(coefs, 10);
+    memset(reference, 0, sizeof(reference));
+    for (int i = 0 ; i < 10 ; i++)
+        symbol_add_scaled(reference, coefs[i], src_tab[i], JUMBO_SYMBOL_SIZE);
+
+    for (int e = 0 ; e < 2 ; e++) {
+        enc_tab[e] = swif_rlc_encoder_create(codepoint, VERBOSITY, JUMBO_SYMBOL_SIZE, 10);
+        CU_ASSERT_PTR_NOT_NULL_FATAL(enc_tab[e])
+    }
+    CU_ASSERT_EQUAL(swif_encoder_set_parameters(enc_tab[1], swif_ENCODER_SET_PARAM_NB_THREADS,
+                                                sizeof(nb_threads), &nb_threads), SWIF_STATUS_ERROR)
+    /* fails when the codec is built without WITH_THREADS: encoding is serial */
+    nb_threads = 3;
+    swif_encoder_set_parameters(enc_tab[1], swif_ENCODER_SET_PARAM_NB_THREADS,
+                                sizeof(nb_threads), &nb_threads);
+
+    for (int e = 0 ; e < 2 ; e++) {
+        for (esi_t esi = 0 ; esi < 10 ; esi++)
+            swif_encoder_add_source_symbol_to_coding_window(enc_tab[e], src_tab[esi], esi);
+        CU_ASSERT_EQUAL(swif_encoder_set_coding_coefs_tab(enc_tab[e], coefs, 10), SWIF_STATUS_OK)
+        /* the threads are reused from one repair symbol to the next */
+        for (int k = 0 ; k < 2 ; k++)
+            CU_ASSERT_EQUAL(swif_build_repair_symbol(enc_tab[e], &repair_tab[e]), SWIF_STATUS_OK)
+        CU_ASSERT_EQUAL(memcmp(repair_tab[e], reference, JUMBO_SYMBOL_SIZE), 0)
+        free(repair_tab[e]);
+        swif_encoder_release(enc_tab[e]);
+    }
+}
+
+void test_swif_rlc_encoder_precommit_repair_key() {
+    static uint8_t src_tab[10][SYMBOL_SIZE];
+    swif_encoder_t *enc = swif_rlc_encoder_create(codepoint, VERBOSITY, SYMBOL_SIZE, 4);
+    swif_encoder_t *ref_enc = swif_rlc_encoder_create(codepoint, VERBOSITY, SYMBOL_SIZE, 4);
+    uint8_t ref_repair[SYMBOL_SIZE];
+    uint8_t repair[SYMBOL_SIZE];
+    void *ref_buf = ref_repair;
+    void *buf;
+    CU_ASSERT_PTR_NOT_NULL_FATAL(enc)
+    CU_ASSERT_PTR_NOT_NULL_FATAL(ref_enc)
+    for (int i = 0 ; i < 10 ; i++)
+        for (int j = 0 ; j < SYMBOL_SIZE ; j++)
+            src_tab[i][j] = (uint8_t)(i * 17 + j * 3 + 1);
+
+    /* before any source symbol, then with a window that slides (3..6),
+       one never built (up to 8) and one with symbols already there */
+    CU_ASSERT_EQUAL(swif_encoder_precommit_repair_key(enc, 5, 15, 1), SWIF_STATUS_OK)
+    CU_ASSERT_EQUAL(swif_encoder_precommit_repair_key(enc, 10, 15, 6), SWIF_STATUS_OK)
+    CU_ASSERT_EQUAL(swif_encoder_precommit_repair_key(enc, 12, 15, 8), SWIF_STATUS_OK)
+    for (esi_t esi = 0 ; esi < 10 ; esi++) {
+        swif_encoder_add_source_symbol_to_coding_window(enc, src_tab[esi], esi);
+        swif_encoder_add_source_symbol_to_coding_window(ref_enc, src_tab[esi], esi);
+        if (esi == 5) {
+            CU_ASSERT_EQUAL(swif_encoder_precommit_repair_key(enc, 13, 15, 4), SWIF_STATUS_ERROR)
+            CU_ASSERT_EQUAL(swif_encoder_precommit_repair_key(enc, 13, 15, 9), SWIF_STATUS_OK)
+        }
+        if (esi != 1 && esi != 6 && esi != 9)
+            continue;
+        swif_encoder_generate_coding_coefs(ref_enc, esi + 4, 15, 0);
+        swif_build_repair_symbol(ref_enc, &ref_buf);
+        swif_encoder_generate_coding_coefs(enc, esi + 4, 15, 0);
+        /* handed over as it is, or copied */
+        buf = (esi == 6) ? repair : NULL;
+        CU_ASSERT_EQUAL(swif_build_repair_symbol(enc, &buf), SWIF_STATUS_OK)
+        CU_ASSERT_EQUAL(memcmp(buf, ref_repair, SYMBOL_SIZE), 0)
+        if (buf != repair)
+            free(buf);
+    }
+    swif_encoder_release(enc);
+    swif_encoder_release(ref_enc);
+}
+
+void test_swif_rlc_encoder_build_repair_symbols() {
+    static uint8_t src_tab[6][SYMBOL_SIZE];
+    swif_encoder_t *enc = swif_rlc_encoder_create(codepoint, VERBOSITY, SYMBOL_SIZE, 4);
+    uint32_t keys[4] = { 3, 9, 11, 12 };
+    uint8_t ref_repair[SYMBOL_SIZE];
+    uint8_t repair[SYMBOL_SIZE];
+    void *bufs[4] = { NULL, repair, NULL, NULL };
+    void *ref_buf = ref_repair;
+    CU_ASSERT_PTR_NOT_NULL_FATAL(enc)
+    for (int i = 0 ; i < 6 ; i++)
+        for (int j = 0 ; j < SYMBOL_SIZE ; j++)
+            src_tab[i][j] = (uint8_t)(i * 13 + j * 5 + 2);
+
+    CU_ASSERT_EQUAL(swif_encoder_precommit_repair_key(enc, 11, 15, 5), SWIF_STATUS_OK)
+    for (esi_t esi = 0 ; esi < 6 ; esi++)
+        swif_encoder_add_source_symbol_to_coding_window(enc, src_tab[esi], esi);
+    /* one of them (11) was precommitted */
+    CU_ASSERT_EQUAL(swif_build_repair_symbols(enc, keys, 15, 4, bufs), SWIF_STATUS_OK)
+    CU_ASSERT_PTR_EQUAL(bufs[1], repair)
+    /* the coefficients of the last key are kept */
+    CU_ASSERT_EQUAL(swif_build_repair_symbol(enc, &ref_buf), SWIF_STATUS_OK)
+    CU_ASSERT_EQUAL(memcmp(bufs[3], ref_repair, SYMBOL_SIZE), 0)
+    for (int r = 0 ; r < 3 ; r++) {
+        swif_encoder_generate_coding_coefs(enc, keys[r], 15, 0);
+        swif_build_repair_symbol(enc, &ref_buf);
+        CU_ASSERT_EQUAL(memcmp(bufs[r], ref_repair, SYMBOL_SIZE), 0)
+    }
+    free(bufs[0]);
+    free(bufs[2]);
+    free(bufs[3]);
+    swif_encoder_release(enc);
+}
+
+void test_swif_rlc_encoder_repair_buffer_pool() {
+    static uint8_t src_tab[3][SYMBOL_SIZE];
+    swif_encoder_t *enc = swif_rlc_encoder_create(codepoint, VERBOSITY, SYMBOL_SIZE, 4);
+    uint32_t keys[3] = { 1, 2, 3 };
+    void *bufs[3] = { NULL, NULL, NULL };
+    void *buf = NULL;
+    void *first_buf;
+    uint32_t pool_size = 1;
+    uint32_t high_water_mark = 1;
+    CU_ASSERT_PTR_NOT_NULL_FATAL(enc)
+    memset(src_tab, 7, sizeof(src_tab));
+    for (esi_t esi = 0 ; esi < 3 ; esi++)
+        swif_encoder_add_source_symbol_to_coding_window(enc, src_tab[esi], esi);
+
+    CU_ASSERT_EQUAL(swif_encoder_get_parameters(enc, swif_ENCODER_GET_PARAM_REPAIR_BUFFER_POOL_SIZE,
+                                                sizeof(pool_size), &pool_size), SWIF_STATUS_OK)
+    CU_ASSERT_EQUAL(pool_size, 0)
+    swif_encoder_generate_coding_coefs(enc, 1, 15, 0);
+    CU_ASSERT_EQUAL(swif_build_repair_symbol(enc, &buf), SWIF_STATUS_OK)
+    CU_ASSERT_EQUAL((uintptr_t)buf % SYMBOL_ALIGN, 0)
+    first_buf = buf;
+    /* given back, then reused */
+    CU_ASSERT_EQUAL(swif_encoder_release_repair_buffer(enc, buf), SWIF_STATUS_OK)
+    buf = NULL;
+    CU_ASSERT_EQUAL(swif_build_repair_symbol(enc, &buf), SWIF_STATUS_OK)
+    CU_ASSERT_PTR_EQUAL(buf, first_buf)
+    CU_ASSERT_EQUAL(swif_build_repair_symbols(enc, keys, 15, 3, bufs), SWIF_STATUS_OK)
+    CU_ASSERT_EQUAL(memcmp(bufs[0], buf, SYMBOL_SIZE), 0)
+    swif_encoder_release_repair_buffer(enc, buf);
+    for (int r = 0 ; r < 3 ; r++)
+        swif_encoder_release_repair_buffer(enc, bufs[r]);
+
+    swif_encoder_get_parameters(enc, swif_ENCODER_GET_PARAM_REPAIR_BUFFER_POOL_SIZE,
+                                sizeof(pool_size), &pool_size);
+    CU_ASSERT_EQUAL(pool_size, 4)
+    CU_ASSERT_EQUAL(swif_encoder_get_parameters(enc, swif_ENCODER_GET_PARAM_REPAIR_BUFFER_HIGH_WATER_MARK,
+                                                sizeof(high_water_mark), &high_water_mark), SWIF_STATUS_OK)
+    CU_ASSERT_EQUAL(high_water_mark, 4)
+    CU_ASSERT_EQUAL(swif_encoder_get_parameters(enc, swif_ENCODER_GET_PARAM_REPAIR_BUFFER_HIGH_WATER_MARK,
+                                                sizeof(uint8_t), &high_water_mark), SWIF_STATUS_ERROR)
+    /* the buffers of the pool are freed with the encoder */
+    swif_encoder_release(enc);
+}
+
+void test_swif_rlc_encoder_statistics() {
+    static uint8_t src_tab[5][SYMBOL_SIZE];
+    uint8_t coefs[5] = { 0, 1, 0, 5, 1 };
+    uint32_t keys[2] = { 21, 22 };
+    void *bufs[2] = { NULL, NULL };
+    void *buf = NULL;
+    swif_encoder_stats_t stats;
+    swif_encoder_t *enc = swif_rlc_encoder_create(codepoint, VERBOSITY, SYMBOL_SIZE, 5);
+    CU_ASSERT_PTR_NOT_NULL_FATAL(enc)
+    memset(src_tab, 3, sizeof(src_tab));
+    for (esi_t esi = 0 ; esi < 5 ; esi++)
+        swif_encoder_add_source_symbol_to_coding_window(enc, src_tab[esi], esi);
+
+    /* two source symbols XORed, one multiplied */
+    swif_encoder_set_coding_coefs_tab(enc, coefs, 5);
+    CU_ASSERT_EQUAL(swif_build_repair_symbol(enc, &buf), SWIF_STATUS_OK)
+    CU_ASSERT_EQUAL(swif_encoder_get_parameters(enc, swif_ENCODER_GET_PARAM_ENCODER_STATISTICS,
+                                                sizeof(stats), &stats), SWIF_STATUS_OK)
+    CU_ASSERT_EQUAL(stats.nb_source_symbols, 5)
+    CU_ASSERT_EQUAL(stats.nb_repair_symbols, 1)
+    CU_ASSERT_EQUAL(stats.nb_bytes_xored, 2 * SYMBOL_SIZE)
+    CU_ASSERT_EQUAL(stats.nb_bytes_multiplied, SYMBOL_SIZE)
+    CU_ASSERT_EQUAL(stats.coefs_cycles, 0)
+
+    CU_ASSERT_EQUAL(swif_build_repair_symbols(enc, keys, 15, 2, bufs), SWIF_STATUS_OK)
+    swif_encoder_get_parameters(enc, swif_ENCODER_GET_PARAM_ENCODER_STATISTICS,
+                                sizeof(stats), &stats);
+    CU_ASSERT_EQUAL(stats.nb_repair_symbols, 3)
+    CU_ASSERT_TRUE(stats.nb_bytes_xored + stats.nb_bytes_multiplied > 3 * SYMBOL_SIZE)
+    CU_ASSERT_EQUAL(stats.nb_repair_buffers, 3)
+    CU_ASSERT_EQUAL(stats.max_nb_repair_buffers_in_use, 3)
+#if defined(__x86_64__) || defined(__i386__) || defined(__aarch64__)
+    CU_ASSERT_TRUE(stats.coefs_cycles > 0)
+    CU_ASSERT_TRUE(stats.build_cycles >= stats.coefs_cycles)
+#endif
+    CU_ASSERT_EQUAL(swif_encoder_get_parameters(enc, swif_ENCODER_GET_PARAM_ENCODER_STATISTICS,
+                                                sizeof(uint32_t), &stats), SWIF_STATUS_ERROR)
+    swif_encoder_release_repair_buffer(enc, buf);
+    swif_encoder_release_repair_buffer(enc, bufs[0]);
+    swif_encoder_release_repair_buffer(enc, bufs[1]);
+    swif_encoder_release(enc);
+}
+
+void test_swif_rlc_encoder_copy_source_symbols() {
+    static uint8_t src_tab[7][SYMBOL_SIZE];
+    uint8_t app_buf[SYMBOL_SIZE];
+    uint8_t ref_repair[SYMBOL_SIZE];
+    uint8_t repair[SYMBOL_SIZE];
+    void *ref_buf = ref_repair;
+    void *buf = repair;
+    uint32_t copy = 1;
+    swif_encoder_t *enc = swif_rlc_encoder_create(codepoint, VERBOSITY, SYMBOL_SIZE, 4);
+    swif_encoder_t *ref_enc = swif_rlc_encoder_create(codepoint, VERBOSITY, SYMBOL_SIZE, 4);
+    CU_ASSERT_PTR_NOT_NULL_FATAL(enc)
+    CU_ASSERT_PTR_NOT_NULL_FATAL(ref_enc)
+    for (int i = 0 ; i < 7 ; i++)
+        for (int j = 0 ; j < SYMBOL_SIZE ; j++)
+            src_tab[i][j] = (uint8_t)(i * 11 + j * 3 + 5);
+
+    CU_ASSERT_EQUAL(swif_encoder_set_parameters(enc, swif_ENCODER_SET_PARAM_COPY_SOURCE_SYMBOLS,
+                                                sizeof(copy), &copy), SWIF_STATUS_OK)
+    for (esi_t esi = 0 ; esi < 7 ; esi++) {
+        /* the same application buffer for all of them */
+        memcpy(app_buf, src_tab[esi], SYMBOL_SIZE);
+        swif_encoder_add_source_symbol_to_coding_window(enc, app_buf, esi);
+        memset(app_buf, 0xff, SYMBOL_SIZE);
+        swif_encoder_add_source_symbol_to_coding_window(ref_enc, src_tab[esi], esi);
+        swif_encoder_generate_coding_coefs(enc, esi, 15, 0);
+        swif_encoder_generate_coding_coefs(ref_enc, esi, 15, 0);
+        swif_build_repair_symbol(enc, &buf);
+        swif_build_repair_symbol(ref_enc, &ref_buf);
+        CU_ASSERT_EQUAL(memcmp(repair, ref_repair, SYMBOL_SIZE), 0)
+    }
+    CU_ASSERT_EQUAL(swif_encoder_set_parameters(enc, swif_ENCODER_SET_PARAM_COPY_SOURCE_SYMBOLS,
+                                                sizeof(copy), &copy), SWIF_STATUS_ERROR)
+    swif_encoder_release(enc);
+    swif_encoder_release(ref_enc);
+}
+
+void test_swif_rlc_encoder_coefs_cache() {
+    static uint8_t src_tab[5][SYMBOL_SIZE];
+    uint8_t ref_repair[SYMBOL_SIZE];
+    uint8_t repair[SYMBOL_SIZE];
+    void *ref_buf = ref_repair;
+    void *buf = repair;
+    uint32_t keys[3] = { 7, 8, 7 };
+    swif_coefs_cache_stats_t stats;
+    swif_coefs_cache_t *cache = swif_coefs_cache_create(2, 0);
+    swif_encoder_t *enc = swif_rlc_encoder_create(codepoint, VERBOSITY, SYMBOL_SIZE, 5);
+    swif_encoder_t *ref_enc = swif_rlc_encoder_create(codepoint, VERBOSITY, SYMBOL_SIZE, 5);
+    swif_decoder_t *dec = swif_rlc_decoder_create(codepoint, VERBOSITY, SYMBOL_SIZE, 5, 10);
+    CU_ASSERT_PTR_NOT_NULL_FATAL(cache)
+    CU_ASSERT_PTR_NOT_NULL_FATAL(enc)
+    CU_ASSERT_PTR_NOT_NULL_FATAL(ref_enc)
+    CU_ASSERT_PTR_NOT_NULL_FATAL(dec)
+    CU_ASSERT_PTR_NULL(swif_coefs_cache_create(0, 0))
+    for (int i = 0 ; i < 5 ; i++)
+        for (int j = 0 ; j < SYMBOL_SIZE ; j++)
+            src_tab[i][j] = (uint8_t)(i * 19 + j + 3);
+
+    /* shared by an encoder and a decoder */
+    CU_ASSERT_EQUAL(swif_encoder_set_parameters(enc, swif_ENCODER_SET_PARAM_COEFS_CACHE,
+                                                sizeof(cache), &cache), SWIF_STATUS_OK)
+    CU_ASSERT_EQUAL(swif_decoder_set_parameters(dec, swif_DECODER_SET_PARAM_COEFS_CACHE,
+                                                sizeof(cache), &cache), SWIF_STATUS_OK)
+    for (esi_t esi = 0 ; esi < 5 ; esi++) {
+        swif_encoder_add_source_symbol_to_coding_window(enc, src_tab[esi], esi);
+        swif_encoder_add_source_symbol_to_coding_window(ref_enc, src_tab[esi], esi);
+        /* key 7 then 8 then 7 again: hit (a longer window only the first time) */
+        for (int k = 0 ; k < 3 ; k++) {
+            swif_encoder_generate_coding_coefs(enc, keys[k], 15, 0);
+            swif_encoder_generate_coding_coefs(ref_enc, keys[k], 15, 0);
+            swif_build_repair_symbol(enc, &buf);
+            swif_build_repair_symbol(ref_enc, &ref_buf);
+            CU_ASSERT_EQUAL(memcmp(repair, ref_repair, SYMBOL_SIZE), 0)
+        }
+    }
+    CU_ASSERT_EQUAL(swif_coefs_cache_get_statistics(cache, &stats), SWIF_STATUS_OK)
+    CU_ASSERT_EQUAL(stats.nb_lookups, 15)
+    CU_ASSERT_EQUAL(stats.nb_hits, 5)
+    CU_ASSERT_EQUAL(stats.nb_entries, 2)
+    CU_ASSERT_EQUAL(stats.nb_evictions, 0)
+    /* a third key evicts the least recently used one (8) */
+    swif_encoder_generate_coding_coefs(enc, 9, 15, 0);
+    swif_encoder_generate_coding_coefs(enc, 7, 15, 0);
+    swif_coefs_cache_get_statistics(cache, &stats);
+    CU_ASSERT_EQUAL(stats.nb_evictions, 1)
+    CU_ASSERT_EQUAL(stats.nb_hits, 6)
+
+    swif_encoder_release(enc);
+    swif_encoder_release(ref_enc);
+    swif_decoder_release(dec);
+    swif_coefs_cache_release(cache);
+}
+
+/* source symbols removed from the coding window, as told by the encoder */
+static esi_t enc_removed_tab[16];
+static uint32_t enc_nb_removed;
+
+static void enc_removed_callback(void *context, esi_t old_symbol_esi)
+{
+    CU_ASSERT_FATAL(enc_nb_removed < 16)
+    enc_removed_tab[enc_nb_removed++] = old_symbol_esi;
+}
+
+void test_swif_rlc_encoder_remove_source_symbol() {
+    static uint8_t src_tab[9][SYMBOL_SIZE];
+    uint8_t ref_repair[SYMBOL_SIZE];
+    uint8_t repair[SYMBOL_SIZE];
+    uint8_t cc_tab[5];
+    void *buf = repair;
+    esi_t first, last;
+    uint32_t nss;
+    swif_encoder_t *enc = swif_rlc_encoder_create(codepoint, VERBOSITY, SYMBOL_SIZE, 5);
+    CU_ASSERT_PTR_NOT_NULL_FATAL(enc)
+    CU_ASSERT_EQUAL(swif_encoder_set_callback_functions(enc, enc_removed_callback, NULL), SWIF_STATUS_OK)
+    enc_nb_removed = 0;
+    for (int i = 0 ; i < 9 ; i++)
+        for (int j = 0 ; j < SYMBOL_SIZE ; j++)
+            src_tab[i][j] = (uint8_t)(i * 29 + j * 11 + 7);
+    CU_ASSERT_EQUAL(swif_encoder_remove_source_symbol_from_coding_window(enc, 0), SWIF_STATUS_ERROR)
+    for (esi_t esi = 0 ; esi < 7 ; esi++)
+        swif_encoder_add_source_symbol_to_coding_window(enc, src_tab[esi], esi);
+    CU_ASSERT_EQUAL(enc_nb_removed, 2)
+
+    /* acknowledged: oldest first only */
+    CU_ASSERT_EQUAL(swif_encoder_precommit_repair_key(enc, 10, 15, 7), SWIF_STATUS_OK)
+    CU_ASSERT_EQUAL(swif_encoder_remove_source_symbol_from_coding_window(enc, 3), SWIF_STATUS_ERROR)
+    CU_ASSERT_EQUAL(swif_encoder_remove_source_symbol_from_coding_window(enc, 2), SWIF_STATUS_OK)
+    CU_ASSERT_EQUAL(swif_encoder_remove_source_symbol_from_coding_window(enc, 3), SWIF_STATUS_OK)
+    CU_ASSERT_EQUAL(((swif_encoder_rlc_cb_t *)enc)->nb_acc, 0)
+    CU_ASSERT_EQUAL(enc_nb_removed, 4)
+    CU_ASSERT_EQUAL(enc_removed_tab[3], 3)
+    swif_encoder_get_coding_window_information(enc, &first, &last, &nss);
+    CU_ASSERT_EQUAL(first, 4)
+    CU_ASSERT_EQUAL(last, 6)
+    CU_ASSERT_EQUAL(nss, 3)
+
+    /* the repair symbols only cover the remaining source symbols, and the
+       window grows again */
+    swif_encoder_add_source_symbol_to_coding_window(enc, src_tab[7], 7);
+    CU_ASSERT_EQUAL(enc_nb_removed, 4)
+    swif_rlc_generate_coding_coefficients(12, cc_tab, 4, 15, 8);
+    memset(ref_repair, 0, SYMBOL_SIZE);
+    for (int i = 0 ; i < 4 ; i++)
+        symbol_add_scaled(ref_repair, cc_tab[i], src_tab[4 + i], SYMBOL_SIZE);
+    swif_encoder_generate_coding_coefs(enc, 12, 15, 0);
+    CU_ASSERT_EQUAL(swif_build_repair_symbol(enc, &buf), SWIF_STATUS_OK)
+    CU_ASSERT_EQUAL(memcmp(repair, ref_repair, SYMBOL_SIZE), 0)
+
+    /* emptied, the next ESI is still expected */
+    for (esi_t esi = 4 ; esi < 8 ; esi++)
+        CU_ASSERT_EQUAL(swif_encoder_remove_source_symbol_from_coding_window(enc, esi), SWIF_STATUS_OK)
+    CU_ASSERT_EQUAL(swif_encoder_add_source_symbol_to_coding_window(enc, src_tab[0], 9), SWIF_STATUS_ERROR)
+    CU_ASSERT_EQUAL(swif_encoder_add_source_symbol_to_coding_window(enc, src_tab[8], 8), SWIF_STATUS_OK)
+    swif_encoder_get_coding_window_information(enc, &first, &last, &nss);
+    CU_ASSERT_EQUAL(first, 8)
+    CU_ASSERT_EQUAL(nss, 1)
+
+    /* reset: any ESI afterwards */
+    enc_nb_removed = 0;
+    CU_ASSERT_EQUAL(swif_encoder_reset_coding_window(enc), SWIF_STATUS_OK)
+    CU_ASSERT_EQUAL(enc_nb_removed, 1)
+    CU_ASSERT_EQUAL(enc_removed_tab[0], 8)
+    CU_ASSERT_EQUAL(swif_encoder_add_source_symbol_to_coding_window(enc, src_tab[0], 100), SWIF_STATUS_OK)
+    swif_encoder_get_coding_window_information(enc, &first, &last, &nss);
+    CU_ASSERT_EQUAL(first, 100)
+    CU_ASSERT_EQUAL(nss, 1)
+    swif_encoder_release(enc);
+}
+
+void test_swif_rlc_encoder_standing_repair_keys() {
+    static uint8_t src_tab[10][SYMBOL_SIZE];
+    static uint8_t ref_repair[SYMBOL_SIZE];
+    static uint8_t repair[4][SYMBOL_SIZE];
+    void *bufs[4] = { repair[0], repair[1], repair[2], repair[3] };
+    uint32_t keys[4] = { 5, 9, 300, 7 };   /* 7 is not a standing one */
+    uint8_t cc_tab[4];
+    swif_encoder_t *enc = swif_rlc_encoder_create(SWIF_CODEPOINT_RLC_GF_256_VANDERMONDE_CODEC,
+                                                  VERBOSITY, SYMBOL_SIZE, 4);
+    swif_encoder_t *prng_enc = swif_rlc_encoder_create(codepoint, VERBOSITY, SYMBOL_SIZE, 4);
+    CU_ASSERT_PTR_NOT_NULL_FATAL(enc)
+    CU_ASSERT_PTR_NOT_NULL_FATAL(prng_enc)
+    CU_ASSERT_EQUAL(swif_encoder_set_parameters(prng_enc, swif_ENCODER_SET_PARAM_STANDING_REPAIR_KEYS,
+                                                3 * sizeof(uint32_t), keys), SWIF_STATUS_ERROR)
+    for (int i = 0 ; i < 10 ; i++)
+        for (int j = 0 ; j < SYMBOL_SIZE ; j++)
+            src_tab[i][j] = (uint8_t)(i * 53 + j * 5 + 2);
+
+    /* set once the coding window has started */
+    swif_encoder_add_source_symbol_to_coding_window(enc, src_tab[0], 0);
+    CU_ASSERT_EQUAL(swif_encoder_set_parameters(enc, swif_ENCODER_SET_PARAM_STANDING_REPAIR_KEYS,
+                                                3 * sizeof(uint32_t), keys), SWIF_STATUS_OK)
+    for (esi_t esi = 0 ; esi < 10 ; esi++) {
+        esi_t first = (esi < 3) ? 0 : esi - 3;
+        if (esi > 0)
+            swif_encoder_add_source_symbol_to_coding_window(enc, src_tab[esi], esi);
+        for (int k = 0 ; k < 4 ; k++) {
+            /* alpha^(key * esi) over the coding window, whatever its start */
+            swif_rlc_generate_vandermonde_coefficients((uint16_t)keys[k], first, cc_tab, esi - first + 1);
+            memset(ref_repair, 0, SYMBOL_SIZE);
+            for (esi_t i = first ; i <= esi ; i++)
+                symbol_add_scaled(ref_repair, cc_tab[i - first], src_tab[i], SYMBOL_SIZE);
+            CU_ASSERT_EQUAL(swif_encoder_generate_coding_coefs(enc, keys[k], 15, 0), SWIF_STATUS_OK)
+            CU_ASSERT_EQUAL(swif_build_repair_symbol(enc, &bufs[k]), SWIF_STATUS_OK)
+            CU_ASSERT_EQUAL(memcmp(repair[k], ref_repair, SYMBOL_SIZE), 0)
+        }
+    }
+    /* several at once, standing or not */
+    memcpy(ref_repair, repair[1], SYMBOL_SIZE);
+    memcpy(src_tab[0], repair[3], SYMBOL_SIZE);
+    memset(repair, 0, sizeof(repair));
+    CU_ASSERT_EQUAL(swif_build_repair_symbols(enc, keys, 15, 4, bufs), SWIF_STATUS_OK)
+    CU_ASSERT_EQUAL(memcmp(repair[1], ref_repair, SYMBOL_SIZE), 0)
+    CU_ASSERT_EQUAL(memcmp(repair[3], src_tab[0], SYMBOL_SIZE), 0)
+    CU_ASSERT_EQUAL(swif_encoder_set_parameters(enc, swif_ENCODER_SET_PARAM_STANDING_REPAIR_KEYS,
+                                                0, NULL), SWIF_STATUS_OK)
+    swif_encoder_release(enc);
+    swif_encoder_release(prng_enc);
+}
+
+void test_swif_rlc_encoder_sparse_coefs() {
+    static uint8_t src_tab[5][SYMBOL_SIZE];
+    static uint8_t ref_repair[3][SYMBOL_SIZE];
+    static uint8_t repair[3][SYMBOL_SIZE];
+    void *bufs[3] = { repair[0], repair[1], repair[2] };
+    void *buf = repair[0];
+    uint8_t coefs[5] = { 0, 1, 0, 5, 1 };
+    uint32_t keys[3] = { 21, 22, 23 };
+    swif_encoder_t *enc = swif_rlc_encoder_create(codepoint, VERBOSITY, SYMBOL_SIZE, 5);
+    CU_ASSERT_PTR_NOT_NULL_FATAL(enc)
+    for (int i = 0 ; i < 5 ; i++)
+        for (int j = 0 ; j < SYMBOL_SIZE ; j++)
+            src_tab[i][j] = (uint8_t)(i * 41 + j * 3 + 1);
+    for (esi_t esi = 0 ; esi < 5 ; esi++)
+        swif_encoder_add_source_symbol_to_coding_window(enc, src_tab[esi], esi);
+
+    /* null coefficients are skipped, those equal to 1 are a XOR */
+    memset(ref_repair[0], 0, SYMBOL_SIZE);
+    for (int i = 0 ; i < 5 ; i++)
+        symbol_add_scaled(ref_repair[0], coefs[i], src_tab[i], SYMBOL_SIZE);
+    CU_ASSERT_EQUAL(swif_encoder_set_coding_coefs_tab(enc, coefs, 5), SWIF_STATUS_OK)
+    CU_ASSERT_EQUAL(swif_build_repair_symbol(enc, &buf), SWIF_STATUS_OK)
+    CU_ASSERT_EQUAL(memcmp(repair[0], ref_repair[0], SYMBOL_SIZE), 0)
+
+    /* all null: a null repair symbol */
+    memset(coefs, 0, sizeof(coefs));
+    memset(ref_repair[0], 0, SYMBOL_SIZE);
+    swif_encoder_set_coding_coefs_tab(enc, coefs, 5);
+    swif_build_repair_symbol(enc, &buf);
+    CU_ASSERT_EQUAL(memcmp(repair[0], ref_repair[0], SYMBOL_SIZE), 0)
+
+    /* low densities, one at a time and at once */
+    for (uint8_t dt = 0 ; dt <= 4 ; dt += 2) {
+        for (int k = 0 ; k < 3 ; k++) {
+            void *ref_buf = ref_repair[k];
+            swif_encoder_generate_coding_coefs(enc, keys[k], dt, 0);
+            swif_build_repair_symbol(enc, &ref_buf);
+        }
+        CU_ASSERT_EQUAL(swif_build_repair_symbols(enc, keys, dt, 3, bufs), SWIF_STATUS_OK)
+        CU_ASSERT_EQUAL(memcmp(repair, ref_repair, sizeof(repair)), 0)
+    }
+    swif_encoder_release(enc);
+}
+
+void test_swif_rlc_encoder_coefs_atlas() {
+    static uint8_t src_tab[5][SYMBOL_SIZE];
+    static uint8_t ref_repair[4][SYMBOL_SIZE];
+    static uint8_t repair[4][SYMBOL_SIZE];
+    void *ref_bufs[4] = { ref_repair[0], ref_repair[1], ref_repair[2], ref_repair[3] };
+    void *bufs[4] = { repair[0], repair[1], repair[2], repair[3] };
+    uint32_t keys[4] = { 3, 40000, 65535, 3 };
+    const char *path = "/tmp/swif_rlc_api_encoder_test.atlas";
+    swif_coefs_atlas_t *atlas;
+    swif_encoder_t *enc = swif_rlc_encoder_create(codepoint, VERBOSITY, SYMBOL_SIZE, 5);
+    swif_encoder_t *ref_enc = swif_rlc_encoder_create(codepoint, VERBOSITY, SYMBOL_SIZE, 5);
+    swif_decoder_t *dec = swif_rlc_decoder_create(codepoint, VERBOSITY, SYMBOL_SIZE, 5, 10);
+    CU_ASSERT_PTR_NOT_NULL_FATAL(enc)
+    CU_ASSERT_PTR_NOT_NULL_FATAL(ref_enc)
+    CU_ASSERT_PTR_NOT_NULL_FATAL(dec)
+    CU_ASSERT_EQUAL(swif_coefs_atlas_write(path, 5, 16), SWIF_STATUS_ERROR)
+    CU_ASSERT_PTR_NULL(swif_coefs_atlas_open("/tmp/swif_no_such_file.atlas"))
+    CU_ASSERT_EQUAL_FATAL(swif_coefs_atlas_write(path, 5, 15), SWIF_STATUS_OK)
+    atlas = swif_coefs_atlas_open(path);
+    CU_ASSERT_PTR_NOT_NULL_FATAL(atlas)
+    for (int i = 0 ; i < 5 ; i++)
+        for (int j = 0 ; j < SYMBOL_SIZE ; j++)
+            src_tab[i][j] = (uint8_t)(i * 23 + j + 5);
+
+    CU_ASSERT_EQUAL(swif_encoder_set_parameters(enc, swif_ENCODER_SET_PARAM_COEFS_ATLAS,
+                                                sizeof(atlas), &atlas), SWIF_STATUS_OK)
+    CU_ASSERT_EQUAL(swif_decoder_set_parameters(dec, swif_DECODER_SET_PARAM_COEFS_ATLAS,
+                                                sizeof(atlas), &atlas), SWIF_STATUS_OK)
+    for (esi_t esi = 0 ; esi < 5 ; esi++) {
+        swif_encoder_add_source_symbol_to_coding_window(enc, src_tab[esi], esi);
+        swif_encoder_add_source_symbol_to_coding_window(ref_enc, src_tab[esi], esi);
+        /* dt=15 is served by the atlas, dt=7 is generated as usual */
+        for (uint8_t dt = 7 ; dt <= 15 ; dt += 8) {
+            for (int k = 0 ; k < 3 ; k++) {
+                swif_encoder_generate_coding_coefs(enc, keys[k], dt, 0);
+                swif_encoder_generate_coding_coefs(ref_enc, keys[k], dt, 0);
+                CU_ASSERT_EQUAL(((swif_encoder_rlc_cb_t *)enc)->cc_atlas_tab != NULL, dt == 15)
+                swif_build_repair_symbol(enc, &bufs[0]);
+                swif_build_repair_symbol(ref_enc, &ref_bufs[0]);
+                CU_ASSERT_EQUAL(memcmp(repair[0], ref_repair[0], SYMBOL_SIZE), 0)
+            }
+        }
+    }
+    /* several repair symbols at once */
+    CU_ASSERT_EQUAL(swif_build_repair_symbols(enc, keys, 15, 4, bufs), SWIF_STATUS_OK)
+    CU_ASSERT_EQUAL(swif_build_repair_symbols(ref_enc, keys, 15, 4, ref_bufs), SWIF_STATUS_OK)
+    CU_ASSERT_EQUAL(memcmp(repair, ref_repair, sizeof(repair)), 0)
+
+    /* the decoder finds the same coefficients in the atlas */
+    swif_decoder_reset_coding_window(dec);
+    for (esi_t esi = 0 ; esi < 5 ; esi++)
+        swif_decoder_add_source_symbol_to_coding_window(dec, esi);
+    swif_decoder_generate_coding_coefs(dec, keys[1], 15, 0);
+    swif_encoder_generate_coding_coefs(ref_enc, keys[1], 15, 0);
+    CU_ASSERT_PTR_NOT_NULL_FATAL(((swif_decoder_rlc_cb_t *)dec)->coef_atlas_tab)
+    CU_ASSERT_EQUAL(memcmp(((swif_decoder_rlc_cb_t *)dec)->coef_atlas_tab,
+                           ((swif_encoder_rlc_cb_t *)ref_enc)->cc_tab, 5), 0)
+    swif_decoder_reset_coding_window(dec);
+    CU_ASSERT_PTR_NULL(((swif_decoder_rlc_cb_t *)dec)->coef_atlas_tab)
+
+    swif_encoder_release(enc);
+    swif_encoder_release(ref_enc);
+    swif_decoder_release(dec);
+    swif_coefs_atlas_close(atlas);
+    remove(path);
+}
+
+#define ENGINE_NB_FLOWS		6
+#define ENGINE_NB_SOURCES	24
+
+/* source symbols removed from the coding window of each flow */
+static uint32_t engine_nb_removed[ENGINE_NB_FLOWS];
+
+static void engine_removed_callback(void *context, uint32_t flow_id, esi_t old_symbol_esi)
+{
+    /* from a worker thread: no CU_ASSERT here */
+    if (flow_id < ENGINE_NB_FLOWS)
+        engine_nb_removed[flow_id]++; /* always from the same worker for a flow */
+}
+
+void test_swif_rlc_encoder_speculative_repairs() {
+    static uint8_t src_tab[16][JUMBO_SYMBOL_SIZE];
+    static uint8_t repair[JUMBO_SYMBOL_SIZE];
+    void *ref_buf = NULL;
+    void *buf = NULL;
+    void *ref_bufs[2] = { NULL, NULL };
+    void *bufs[2] = { NULL, NULL };
+    uint32_t keys[2] = { 116, 117 };
+    uint32_t nb_spec = 2;
+    swif_encoder_speculation_stats_t stats;
+    swif_encoder_stats_t enc_stats, ref_stats;
+    swif_encoder_t *enc = swif_rlc_encoder_create(codepoint, VERBOSITY, JUMBO_SYMBOL_SIZE, 10);
+    swif_encoder_t *ref_enc = swif_rlc_encoder_create(codepoint, VERBOSITY, JUMBO_SYMBOL_SIZE, 10);
+    CU_ASSERT_PTR_NOT_NULL_FATAL(enc)
+    CU_ASSERT_PTR_NOT_NULL_FATAL(ref_enc)
+    /* fails when the codec is built without WITH_THREADS */
+    if (swif_encoder_set_parameters(enc, swif_ENCODER_SET_PARAM_SPECULATIVE_REPAIRS,
+                                    sizeof(nb_spec), &nb_spec) != SWIF_STATUS_OK) {
+        swif_encoder_release(enc);
+        swif_encoder_release(ref_enc);
+        return;
+    }
+    for (int i = 0 ; i < 16 ; i++)
+        for (int j = 0 ; j < JUMBO_SYMBOL_SIZE ; j++)
+            src_tab[i][j] = (uint8_t)(i * 29 + j * 3 + j / 257 + 1);
+
+    /* key 100 + esi after source symbol esi: the next key is the one built
+       ahead of time (the one after it is lost) */
+    for (esi_t esi = 0 ; esi < 16 ; esi++) {
+        swif_encoder_add_source_symbol_to_coding_window(enc, src_tab[esi], esi);
+        swif_encoder_add_source_symbol_to_coding_window(ref_enc, src_tab[esi], esi);
+        swif_encoder_generate_coding_coefs(enc, 100 + esi, 15, 0);
+        swif_encoder_generate_coding_coefs(ref_enc, 100 + esi, 15, 0);
+        CU_ASSERT_EQUAL(swif_build_repair_symbol(ref_enc, &ref_buf), SWIF_STATUS_OK)
+        /* into a buffer of the application, or of the encoder */
+        buf = (esi % 2 == 0) ? repair : NULL;
+        CU_ASSERT_EQUAL(swif_build_repair_symbol(enc, &buf), SWIF_STATUS_OK)
+        CU_ASSERT_EQUAL(memcmp(buf, ref_buf, JUMBO_SYMBOL_SIZE), 0)
+        if (buf != repair)
+            swif_encoder_release_repair_buffer(enc, buf);
+    }
+    /* 116 was built ahead of time (after 115), 117 was not */
+    CU_ASSERT_EQUAL(swif_build_repair_symbols(enc, keys, 15, 2, bufs), SWIF_STATUS_OK)
+    CU_ASSERT_EQUAL(swif_build_repair_symbols(ref_enc, keys, 15, 2, ref_bufs), SWIF_STATUS_OK)
+    for (int r = 0 ; r < 2 ; r++)
+        CU_ASSERT_EQUAL(memcmp(bufs[r], ref_bufs[r], JUMBO_SYMBOL_SIZE), 0)
+    /* the bytes combined by the helper thread are counted (with those of
+       the repair symbols built for nothing) */
+    swif_encoder_get_parameters(enc, swif_ENCODER_GET_PARAM_ENCODER_STATISTICS,
+                                sizeof(enc_stats), &enc_stats);
+    swif_encoder_get_parameters(ref_enc, swif_ENCODER_GET_PARAM_ENCODER_STATISTICS,
+                                sizeof(ref_stats), &ref_stats);
+    CU_ASSERT_EQUAL(enc_stats.nb_repair_symbols, ref_stats.nb_repair_symbols)
+    CU_ASSERT(enc_stats.nb_bytes_xored + enc_stats.nb_bytes_multiplied
+              >= ref_stats.nb_bytes_xored + ref_stats.nb_bytes_multiplied)
+    /* not expected */
+    swif_encoder_generate_coding_coefs(enc, 200, 15, 0);
+    CU_ASSERT_EQUAL(swif_build_repair_symbol(enc, &bufs[0]), SWIF_STATUS_OK)
+
+    CU_ASSERT_EQUAL(swif_encoder_get_parameters(enc, swif_ENCODER_GET_PARAM_SPECULATION_STATISTICS,
+                                                sizeof(stats), &stats), SWIF_STATUS_OK)
+    CU_ASSERT_EQUAL(stats.nb_speculations, 15 * 2)
+    CU_ASSERT_EQUAL(stats.nb_hits, 15 + 1)
+    CU_ASSERT_EQUAL(stats.nb_misses, 1 + 1 + 1)
+    CU_ASSERT_EQUAL(stats.nb_wasted, 14)
+    CU_ASSERT(stats.nb_aborted <= stats.nb_wasted)
+    /* the window changes: 201 and 202 are built for nothing */
+    CU_ASSERT_EQUAL(swif_encoder_remove_source_symbol_from_coding_window(enc, 6), SWIF_STATUS_OK)
+    nb_spec = 0;
+    CU_ASSERT_EQUAL(swif_encoder_set_parameters(enc, swif_ENCODER_SET_PARAM_SPECULATIVE_REPAIRS,
+                                                sizeof(nb_spec), &nb_spec), SWIF_STATUS_OK)
+    swif_encoder_get_parameters(enc, swif_ENCODER_GET_PARAM_SPECULATION_STATISTICS,
+                                sizeof(stats), &stats);
+    CU_ASSERT_EQUAL(stats.nb_speculations, 15 * 2 + 2)
+    CU_ASSERT_EQUAL(stats.nb_wasted, 14 + 2)
+    for (int r = 0 ; r < 2 ; r++) {
+        free(ref_bufs[r]);
+        swif_encoder_release_repair_buffer(enc, bufs[r]);
+    }
+    free(ref_buf);
+    swif_encoder_release(enc);
+    swif_encoder_release(ref_enc);
+}
+
+void test_swif_engine() {
+    static uint8_t src_tab[ENGINE_NB_FLOWS][ENGINE_NB_SOURCES][SYMBOL_SIZE];
+    static uint8_t ref_tab[ENGINE_NB_FLOWS][ENGINE_NB_SOURCES][SYMBOL_SIZE];
+    static swif_engine_completion_t completion_tab[ENGINE_NB_FLOWS * ENGINE_NB_SOURCES];
+    swif_encoder_t *ref_enc_tab[ENGINE_NB_FLOWS];
+    swif_encoder_t *enc_tab[ENGINE_NB_FLOWS];
+    uint32_t thread_tab[2] = { 0, 3 };
+    uint32_t pool_size, high_water_mark;
+    uint32_t flow_id;
+    for (int f = 0 ; f < ENGINE_NB_FLOWS ; f++)
+        for (int i = 0 ; i < ENGINE_NB_SOURCES ; i++)
+            for (int j = 0 ; j < SYMBOL_SIZE ; j++)
+                src_tab[f][i][j] = (uint8_t)(f * 71 + i * 13 + j + 1);
+
+    for (int t = 0 ; t < 2 ; t++) {
+        swif_engine_t *engine = swif_engine_create(thread_tab[t], ENGINE_NB_FLOWS, NULL,
+                                                   engine_removed_callback, NULL);
+        if (engine == NULL) {
+            CU_ASSERT(thread_tab[t] > 0) /* not built WITH_THREADS */
+            continue;
+        }
+        memset(engine_nb_removed, 0, sizeof(engine_nb_removed));
+        for (int f = 0 ; f < ENGINE_NB_FLOWS ; f++) {
+            swif_encoder_t *enc = swif_engine_add_flow(engine, codepoint, VERBOSITY, SYMBOL_SIZE, 5, &flow_id);
+            CU_ASSERT_PTR_NOT_NULL_FATAL(enc)
+            CU_ASSERT_EQUAL(flow_id, f)
+            enc_tab[f] = enc;
+            ref_enc_tab[f] = swif_rlc_encoder_create(codepoint, VERBOSITY, SYMBOL_SIZE, 5);
+            CU_ASSERT_PTR_NOT_NULL_FATAL(ref_enc_tab[f])
+        }
+        CU_ASSERT_PTR_NULL(swif_engine_add_flow(engine, codepoint, VERBOSITY, SYMBOL_SIZE, 5, &flow_id))
+
+        /* the requests of a flow are done in order: the repair symbols are
+           those of an encoder used directly */
+        for (esi_t esi = 0 ; esi < ENGINE_NB_SOURCES ; esi++) {
+            for (int f = 0 ; f < ENGINE_NB_FLOWS ; f++) {
+                CU_ASSERT_EQUAL(swif_engine_submit_source_symbol(engine, f, src_tab[f][esi], esi, NULL),
+                                SWIF_STATUS_OK)
+                swif_encoder_add_source_symbol_to_coding_window(ref_enc_tab[f], src_tab[f][esi], esi);
+                if (f == 0 && esi == 10) {
+                    /* acknowledged */
+                    CU_ASSERT_EQUAL(swif_engine_submit_remove_source_symbol(engine, f, 6, NULL), SWIF_STATUS_OK)
+                    swif_encoder_remove_source_symbol_from_coding_window(ref_enc_tab[f], 6);
+                }
+                if (esi % 3 == 2) {
+                    void *ref_buf = ref_tab[f][esi];
+                    CU_ASSERT_EQUAL(swif_engine_submit_repair_symbol(engine, f, esi, 15, NULL,
+                                                                     (void *)(uintptr_t)esi), SWIF_STATUS_OK)
+                    swif_encoder_generate_coding_coefs(ref_enc_tab[f], esi, 15, 0);
+                    swif_build_repair_symbol(ref_enc_tab[f], &ref_buf);
+                }
+            }
+        }
+        CU_ASSERT_EQUAL(swif_engine_wait(engine), SWIF_STATUS_OK)
+        uint32_t nb = swif_engine_poll_completions(engine, completion_tab,
+                                                   ENGINE_NB_FLOWS * ENGINE_NB_SOURCES);
+        CU_ASSERT_EQUAL(nb, ENGINE_NB_FLOWS * ENGINE_NB_SOURCES / 3)
+        for (uint32_t c = 0 ; c < nb ; c++) {
+            swif_engine_completion_t *completion = &completion_tab[c];
+            esi_t esi = (esi_t)(uintptr_t)completion->request_context;
+            CU_ASSERT_EQUAL(completion->request, SWIF_ENGINE_REPAIR_SYMBOL)
+            CU_ASSERT_EQUAL_FATAL(completion->status, SWIF_STATUS_OK)
+            CU_ASSERT_EQUAL(completion->key, esi)
+            CU_ASSERT_EQUAL(completion->first_esi + completion->nss - 1, esi)
+            CU_ASSERT_EQUAL(memcmp(completion->repair_buf, ref_tab[completion->flow_id][esi], SYMBOL_SIZE), 0)
+            CU_ASSERT_EQUAL(swif_engine_release_repair_buffer(engine, completion->flow_id,
+                                                              completion->repair_buf), SWIF_STATUS_OK)
+        }
+        CU_ASSERT_EQUAL(engine_nb_removed[0], ENGINE_NB_SOURCES - 5)
+        CU_ASSERT_EQUAL(engine_nb_removed[1], ENGINE_NB_SOURCES - 5)
+        CU_ASSERT_EQUAL(swif_engine_poll_completions(NULL, completion_tab, 4), 0)
+
+        /* the released repair buffers are back in the pool of the flow */
+        swif_engine_wait(engine);
+        swif_encoder_get_parameters(enc_tab[1], swif_ENCODER_GET_PARAM_REPAIR_BUFFER_POOL_SIZE,
+                                    sizeof(pool_size), &pool_size);
+        swif_encoder_get_parameters(enc_tab[1], swif_ENCODER_GET_PARAM_REPAIR_BUFFER_HIGH_WATER_MARK,
+                                    sizeof(high_water_mark), &high_water_mark);
+        CU_ASSERT_EQUAL(pool_size, ENGINE_NB_SOURCES / 3)
+        CU_ASSERT_EQUAL(high_water_mark, ENGINE_NB_SOURCES / 3)
+        CU_ASSERT_EQUAL(swif_engine_submit_repair_symbol(engine, 1, 1, 15, NULL, NULL), SWIF_STATUS_OK)
+        swif_engine_wait(engine);
+        CU_ASSERT_EQUAL(swif_engine_poll_completions(engine, completion_tab, 4), 1)
+        CU_ASSERT_EQUAL(swif_engine_release_repair_buffer(engine, 1, completion_tab[0].repair_buf),
+                        SWIF_STATUS_OK)
+        swif_engine_wait(engine);
+        swif_encoder_get_parameters(enc_tab[1], swif_ENCODER_GET_PARAM_REPAIR_BUFFER_POOL_SIZE,
+                                    sizeof(pool_size), &pool_size);
+        CU_ASSERT_EQUAL(pool_size, ENGINE_NB_SOURCES / 3)
+
+        /* a removed flow */
+        CU_ASSERT_EQUAL(swif_engine_remove_flow(engine, 0), SWIF_STATUS_OK)
+        CU_ASSERT_EQUAL(swif_engine_submit_repair_symbol(engine, 0, 1, 15, NULL, NULL), SWIF_STATUS_OK)
+        CU_ASSERT_EQUAL(swif_engine_submit_repair_symbol(engine, ENGINE_NB_FLOWS, 1, 15, NULL, NULL),
+                        SWIF_STATUS_ERROR)
+        swif_engine_wait(engine);
+        CU_ASSERT_EQUAL(swif_engine_poll_completions(engine, completion_tab, 4), 1)
+        CU_ASSERT_EQUAL(completion_tab[0].status, SWIF_STATUS_ERROR)
+        CU_ASSERT_EQUAL(swif_engine_remove_flow(engine, 0), SWIF_STATUS_ERROR)
+
+        CU_ASSERT_EQUAL(swif_engine_release(engine), SWIF_STATUS_OK)
+        for (int f = 0 ; f < ENGINE_NB_FLOWS ; f++)
+            swif_encoder_release(ref_enc_tab[f]);
+    }
+}
+
+void test_swif_rlc_generate_coding_coefficients_batch() {
+    uint16_t key_tab[21];
+    uint16_t cc_nb_tab[21];
+    uint8_t *cc_tab_tab[21];
+    static uint8_t cc_tab[21][200];
+    uint8_t ref_cc_tab[200];
+    uint8_t dt_tab[3] = { 0, 7, 15 };
+    for (int k = 0 ; k < 21 ; k++) {
+        key_tab[k] = (uint16_t)(k * 3121 + 5);
+        cc_nb_tab[k] = (uint16_t)((k * 37) % 200);
+        cc_tab_tab[k] = cc_tab[k];
+    }
+    /* bit-exact with one key at a time, for keys that do not fill the lanes */
+    for (int m = 1 ; m <= 8 ; m += 7) {
+        for (int d = 0 ; d < 3 ; d++) {
+            CU_ASSERT_EQUAL(swif_rlc_generate_coding_coefficients_batch(key_tab, cc_tab_tab, cc_nb_tab,
+                                                                        21, dt_tab[d], m), 0)
+            for (int k = 0 ; k < 21 ; k++) {
+                swif_rlc_generate_coding_coefficients(key_tab[k], ref_cc_tab, cc_nb_tab[k], dt_tab[d], m);
+                CU_ASSERT_EQUAL(memcmp(cc_tab[k], ref_cc_tab, cc_nb_tab[k]), 0)
+            }
+        }
+    }
+    CU_ASSERT_NOT_EQUAL(swif_rlc_generate_coding_coefficients_batch(key_tab, cc_tab_tab, cc_nb_tab,
+                                                                    21, 16, 8), 0)
+}
+
 /* The main() function for setting up and running the tests.
  * Returns a CUE_SUCCESS on successful running, another
  * CUnit error code on failure.
@@ -132,7 +895,21 @@ int main()
     if ((NULL == CU_add_test(pSuite, "test of swif_rlc_encoder_create ()", test_swif_rlc_encoder)) ||
         (NULL == CU_add_test(pSuite, "test of swif_rlc_encoder_set_coding_coefs_tab () with a an array of size max", test_swif_rlc_encoder_set_coding_coefs_tab_full_window)) ||
         (NULL == CU_add_test(pSuite, "test of swif_rlc_encoder_set_coding_coefs_tab () with a an array of size 0", test_swif_rlc_encoder_set_coding_coefs_tab_empty_array)) ||
-        (NULL == CU_add_test(pSuite, "test of swif_rlc_encoder_set_coding_coefs_tab () with a an array of size max-1", test_swif_rlc_encoder_set_coding_coefs_tab_partial_array)))
+        (NULL == CU_add_test(pSuite, "test of swif_rlc_encoder_set_coding_coefs_tab () with a an array of size max-1", test_swif_rlc_encoder_set_coding_coefs_tab_partial_array)) ||
+        (NULL == CU_add_test(pSuite, "test of swif_ENCODER_SET_PARAM_NB_THREADS", test_swif_rlc_encoder_nb_threads)) ||
+        (NULL == CU_add_test(pSuite, "test of swif_encoder_precommit_repair_key ()", test_swif_rlc_encoder_precommit_repair_key)) ||
+        (NULL == CU_add_test(pSuite, "test of swif_build_repair_symbols ()", test_swif_rlc_encoder_build_repair_symbols)) ||
+        (NULL == CU_add_test(pSuite, "test of swif_encoder_release_repair_buffer ()", test_swif_rlc_encoder_repair_buffer_pool)) ||
+        (NULL == CU_add_test(pSuite, "test of swif_ENCODER_GET_PARAM_ENCODER_STATISTICS", test_swif_rlc_encoder_statistics)) ||
+        (NULL == CU_add_test(pSuite, "test of swif_ENCODER_SET_PARAM_COPY_SOURCE_SYMBOLS", test_swif_rlc_encoder_copy_source_symbols)) ||
+        (NULL == CU_add_test(pSuite, "test of swif_coefs_cache_create ()", test_swif_rlc_encoder_coefs_cache)) ||
+        (NULL == CU_add_test(pSuite, "test of repair symbols with null and unit coefficients", test_swif_rlc_encoder_sparse_coefs)) ||
+        (NULL == CU_add_test(pSuite, "test of swif_coefs_atlas_open ()", test_swif_rlc_encoder_coefs_atlas)) ||
+        (NULL == CU_add_test(pSuite, "test of swif_ENCODER_SET_PARAM_STANDING_REPAIR_KEYS", test_swif_rlc_encoder_standing_repair_keys)) ||
+        (NULL == CU_add_test(pSuite, "test of swif_encoder_remove_source_symbol_from_coding_window ()", test_swif_rlc_encoder_remove_source_symbol)) ||
+        (NULL == CU_add_test(pSuite, "test of swif_rlc_generate_coding_coefficients_batch ()", test_swif_rlc_generate_coding_coefficients_batch)) ||
+        (NULL == CU_add_test(pSuite, "test of swif_ENCODER_SET_PARAM_SPECULATIVE_REPAIRS", test_swif_rlc_encoder_speculative_repairs)) ||
+        (NULL == CU_add_test(pSuite, "test of swif_engine_create ()", test_swif_engine)))
     {
         CU_cleanup_registry();
         return CU_get_error();
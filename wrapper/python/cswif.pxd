@@ -207,6 +207,9 @@ cdef extern from "swif_full_symbol_impl.h":
      uint32_t full_symbol_set_add(
          swif_full_symbol_set_t* set, swif_full_symbol_t* full_symbol)
 
+     uint32_t full_symbol_set_add_take(
+         swif_full_symbol_set_t* set, swif_full_symbol_t* full_symbol)
+
      swif_full_symbol_t *full_symbol_alloc(
          symbol_id_t first_symbol_id, symbol_id_t last_symbol_id, uint32_t symbol_size)
 
@@ -244,6 +247,9 @@ cdef extern from "swif_full_symbol_impl.h":
      void full_symbol_add_with_elimination(
         swif_full_symbol_set_t *full_symbol_set, swif_full_symbol_t *new_symbol)
 
+     void full_symbol_add_with_elimination_take(
+        swif_full_symbol_set_t *full_symbol_set, swif_full_symbol_t *new_symbol)
+
 
 #---------------------------------------------------------------------------
 cdef extern from "swif_rlc_api.h":
@@ -546,6 +546,13 @@ cdef class FullSymbolSet:
     cpdef set_add(self, FullSymbol other):
         return full_symbol_set_add(self.symbol_set, other.symbol)
 
+    cpdef set_add_take(self, FullSymbol other):
+        """same as set_add, but `other' is given to the set (and emptied)"""
+        assert other.symbol is not NULL
+        cdef swif_full_symbol_t *symbol = other.symbol
+        other.symbol = NULL
+        return full_symbol_set_add_take(self.symbol_set, symbol)
+
     cpdef dump(self):
         assert self.symbol_set is not NULL
         return full_symbol_set_dump(self.symbol_set, stdio.stdout) 
@@ -579,6 +586,15 @@ cdef class FullSymbolSet:
         res=full_symbol_add_with_elimination(self.symbol_set, new_symbol.symbol)
         return res
 
+    def add_with_elimination_take(self,  FullSymbol new_symbol):
+        """same as add_with_elimination, but `new_symbol' is given to the
+        set (and emptied): it is not copied"""
+        assert self.symbol_set is not NULL
+        assert new_symbol.symbol is not NULL
+        cdef swif_full_symbol_t *symbol = new_symbol.symbol
+        new_symbol.symbol = NULL
+        full_symbol_add_with_elimination_take(self.symbol_set, symbol)
+
     def get_min_id(self): # min, included
         return self.symbol_set.first_symbol_id
 
@@ -626,7 +642,7 @@ def compute_rref(matrix):
     symbol_set = FullSymbolSet()
     for row in matrix:
         symbol = FullSymbol((0, list(row), b""))
-        symbol_set.add_with_elimination(symbol)
+        symbol_set.add_with_elimination_take(symbol)
     return symbol_set.get_matrix(len(matrix[0]))
 
 #---------------------------------------------------------------------------